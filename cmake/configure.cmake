@@ -173,6 +173,10 @@ if (LITE_WITH_LIGHT_WEIGHT_FRAMEWORK)
   add_definitions("-DLITE_WITH_LIGHT_WEIGHT_FRAMEWORK")
 endif()
 
+if (LITE_WITH_THREAD_POOL)
+  add_definitions("-DLITE_WITH_THREAD_POOL")
+endif()
+
 if (LITE_SHUTDOWN_LOG)
   add_definitions("-DLITE_SHUTDOWN_LOG")
 endif()
@@ -0,0 +1,82 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/async_runner.h"
+#include <memory>
+
+namespace paddle {
+namespace lite {
+
+AsyncRunner::AsyncRunner(Scope* exec_scope, const std::function<void()>& run)
+    : run_(run), pool_(1) {
+  CHECK(exec_scope);
+  auto* feed_var = exec_scope->FindVar("feed");
+  CHECK(feed_var) << "no feed variable in exec_scope";
+  feed_list_ = feed_var->GetMutable<std::vector<Tensor>>();
+  auto* fetch_var = exec_scope->FindVar("fetch");
+  CHECK(fetch_var) << "no fetch variable in exec_scope";
+  fetch_list_ = fetch_var->GetMutable<std::vector<Tensor>>();
+}
+
+std::future<void> AsyncRunner::RunAsync(const std::function<void()>& done) {
+  Wait();
+  // The inputs filled by the caller become the feeds of this run, and the
+  // feeds of the last run are reused for the next one.
+  if (!feeds_ready_) {
+    if (next_feeds_.size() < feed_list_->size()) {
+      next_feeds_.resize(feed_list_->size());
+    }
+    feed_list_->swap(next_feeds_);
+  }
+  feeds_ready_ = false;
+  running_ = true;
+
+  auto promise = std::make_shared<std::promise<void>>();
+  auto res = promise->get_future();
+  pool_.Submit([this, done, promise] {
+    run_();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      fetch_list_->swap(outputs_);
+    }
+    if (done) done();
+    promise->set_value();
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+    done_cv_.notify_all();
+  });
+  return res;
+}
+
+void AsyncRunner::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return !running_; });
+}
+
+Tensor* AsyncRunner::GetInput(size_t offset) {
+  auto* inputs = feeds_ready_ ? feed_list_ : &next_feeds_;
+  if (offset >= inputs->size()) {
+    inputs->resize(offset + 1);
+  }
+  return &inputs->at(offset);
+}
+
+const Tensor* AsyncRunner::GetOutput(size_t offset) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK_LT(offset, outputs_.size()) << "offset " << offset << " overflow";
+  return &outputs_.at(offset);
+}
+
+}  // namespace lite
+}  // namespace paddle
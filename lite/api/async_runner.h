@@ -0,0 +1,76 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <condition_variable>  // NOLINT
+#include <functional>
+#include <future>  // NOLINT
+#include <mutex>   // NOLINT
+#include <vector>
+#include "lite/core/scope.h"
+#include "lite/core/tensor.h"
+#include "lite/core/thread_pool.h"
+
+namespace paddle {
+namespace lite {
+
+/*
+ * AsyncRunner runs a program on a worker thread, so that the caller can
+ * prepare the inputs of the next run while the current one is in flight.
+ *
+ * The feeds and fetches are double buffered. The inputs got by GetInput are
+ * the ones of the next run, they are swapped into the feed list when the run
+ * starts, so all of them should be set again for every run. The outputs got
+ * by GetOutput are the ones of the last run done, they are swapped out of the
+ * fetch list when the run is done, and stay valid until the next run is done.
+ */
+class AsyncRunner {
+ public:
+  // `run` runs the program whose feed and fetch lists are in `exec_scope`.
+  // The feed list should be filled for the first run.
+  AsyncRunner(Scope* exec_scope, const std::function<void()>& run);
+
+  // Start a run after the one in flight is done, and call `done` in the
+  // worker thread when this run is done. `done` should not start another run.
+  std::future<void> RunAsync(const std::function<void()>& done);
+
+  // Wait for the run in flight.
+  void Wait();
+
+  // Get offset-th input of the next run.
+  Tensor* GetInput(size_t offset);
+
+  // Get offset-th output of the last run done.
+  const Tensor* GetOutput(size_t offset) const;
+  const std::vector<Tensor>* GetOutputs() const { return &outputs_; }
+
+ private:
+  std::function<void()> run_;
+  std::vector<Tensor>* feed_list_{};
+  std::vector<Tensor>* fetch_list_{};
+  std::vector<Tensor> next_feeds_;
+  std::vector<Tensor> outputs_;
+  // The first run uses the feed list filled before.
+  bool feeds_ready_{true};
+
+  mutable std::mutex mutex_;
+  std::condition_variable done_cv_;
+  bool running_{false};
+
+  // Destroyed first, to join the worker before the buffers are freed.
+  ThreadPool pool_;
+};
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,140 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * A load generator for the RequestBatcher. The clients send the requests of
+ * batch size 1 concurrently, each waits for the result before sending the next
+ * one, and the throughput and latencies are reported for every max batch size.
+ */
+#include <gflags/gflags.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+#include "lite/api/light_api.h"
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/request_batcher.h"
+#include "lite/api/test_helper.h"
+#include "lite/utils/cp_logging.h"
+#include "lite/utils/string.h"
+
+DEFINE_string(input_shape,
+              "1,3,224,224",
+              "the input shape of a request, separated by comma");
+DEFINE_int32(clients, 8, "number of the concurrent clients");
+DEFINE_int32(requests_per_client, 50, "requests sent by every client");
+DEFINE_string(max_batch_sizes,
+              "1,2,4,8",
+              "the max batch sizes to benchmark, separated by comma");
+DEFINE_int32(max_wait_us, 2000, "max time to wait for a batch to be full");
+
+namespace paddle {
+namespace lite {
+
+struct LoadReport {
+  double throughput{};
+  double p50_ms{};
+  double p99_ms{};
+  double avg_batch_size{};
+};
+
+LoadReport RunLoad(LightPredictor* predictor,
+                   const std::vector<int64_t>& shape,
+                   const BatchingOptions& options) {
+  auto batcher = CreateRequestBatcher(predictor, options);
+  std::vector<std::vector<double>> latencies(FLAGS_clients);
+  auto start = GetCurrentUS();
+  std::vector<std::thread> clients;
+  for (int c = 0; c < FLAGS_clients; c++) {
+    clients.emplace_back([&, c] {
+      for (int i = 0; i < FLAGS_requests_per_client; i++) {
+        Tensor input;
+        input.Resize(shape);
+        auto* data = input.mutable_data<float>();
+        for (int64_t j = 0; j < input.numel(); j++) {
+          data[j] = 1.f;
+        }
+        std::vector<Tensor> inputs({input});
+        auto request_start = GetCurrentUS();
+        batcher->Submit(std::move(inputs)).get();
+        latencies[c].push_back((GetCurrentUS() - request_start) / 1000.0);
+      }
+    });
+  }
+  for (auto& t : clients) {
+    t.join();
+  }
+  double elapsed_s = (GetCurrentUS() - start) / 1e6;
+
+  std::vector<double> all;
+  for (auto& x : latencies) {
+    all.insert(all.end(), x.begin(), x.end());
+  }
+  std::sort(all.begin(), all.end());
+  LoadReport report;
+  report.throughput = all.size() / elapsed_s;
+  report.p50_ms = all[all.size() / 2];
+  report.p99_ms = all[std::min(all.size() - 1, all.size() * 99 / 100)];
+  report.avg_batch_size =
+      static_cast<double>(batcher->num_requests()) / batcher->num_batches();
+  return report;
+}
+
+}  // namespace lite
+}  // namespace paddle
+
+int main(int argc, char** argv) {
+  using paddle::lite::string_format;
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  if (FLAGS_model_dir.empty()) {
+    LOG(INFO) << "usage: --model_dir /path/to/naive_buffer/model";
+    return 0;
+  }
+  std::vector<int64_t> shape;
+  for (auto& x : paddle::lite::Split(FLAGS_input_shape, ",")) {
+    shape.push_back(std::stoll(x));
+  }
+
+#ifdef LITE_WITH_ARM
+  paddle::lite::DeviceInfo::Init();
+#endif
+  paddle::lite::LightPredictor predictor(
+      FLAGS_model_dir,
+      "",
+      "",
+      false,
+      paddle::lite_api::LiteModelType::kNaiveBuffer);
+  predictor.SetRunMode(paddle::lite_api::LITE_POWER_NO_BIND, FLAGS_threads);
+
+  LOG(INFO) << "clients " << FLAGS_clients << ", requests per client "
+            << FLAGS_requests_per_client << ", max wait " << FLAGS_max_wait_us
+            << " us";
+  LOG(INFO) << "max_batch  avg_batch  throughput(req/s)  p50(ms)  p99(ms)";
+  for (auto& x : paddle::lite::Split(FLAGS_max_batch_sizes, ",")) {
+    paddle::lite::BatchingOptions options;
+    options.max_batch_size = std::stoi(x);
+    options.max_wait_us = FLAGS_max_wait_us;
+    auto report = paddle::lite::RunLoad(&predictor, shape, options);
+    LOG(INFO) << string_format("%9d  %9.2f  %17.1f  %7.2f  %7.2f",
+                               options.max_batch_size,
+                               report.avg_batch_size,
+                               report.throughput,
+                               report.p50_ms,
+                               report.p99_ms);
+  }
+  return 0;
+}
@@ -54,7 +54,30 @@ void Predictor::SaveModel(const std::string &dir,
 #endif
 }
 
+std::future<void> Predictor::RunAsync(const std::function<void()> &done) {
+  if (!program_generated_) {
+    GenRuntimeProgram();
+  }
+  if (!async_runner_) {
+    async_runner_.reset(
+        new AsyncRunner(program_->exec_scope(), [this] { RunProgram(); }));
+  }
+  return async_runner_->RunAsync(done);
+}
+
+void Predictor::RunPartial(const std::vector<std::string> &targets,
+                           const std::vector<std::string> &provided) {
+  if (!program_generated_) {
+    GenRuntimeProgram();
+  }
+  if (async_runner_) async_runner_->Wait();
+  program_->RunPartial(targets, provided);
+}
+
 lite::Tensor *Predictor::GetInput(size_t offset) {
+  if (async_runner_) {
+    return async_runner_->GetInput(offset);
+  }
   auto *_feed_list = exec_scope_->FindVar("feed");
   CHECK(_feed_list) << "no feed variable in exec_scope";
   auto *feed_list = _feed_list->GetMutable<std::vector<lite::Tensor>>();
@@ -65,6 +88,9 @@ lite::Tensor *Predictor::GetInput(size_t offset) {
 }
 
 const lite::Tensor *Predictor::GetOutput(size_t offset) const {
+  if (async_runner_) {
+    return async_runner_->GetOutput(offset);
+  }
   auto *_fetch_list = exec_scope_->FindVar("fetch");
   CHECK(_fetch_list) << "no fatch variable in exec_scope";
   auto &fetch_list = *_fetch_list->GetMutable<std::vector<lite::Tensor>>();
@@ -72,7 +98,21 @@ const lite::Tensor *Predictor::GetOutput(size_t offset) const {
   return &fetch_list.at(offset);
 }
 
+lite::Tensor *Predictor::GetMutableOutput(size_t offset) {
+  CHECK(!async_runner_) << "the outputs of RunAsync are double buffered";
+  auto *_fetch_list = exec_scope_->FindVar("fetch");
+  CHECK(_fetch_list) << "no fatch variable in exec_scope";
+  auto *fetch_list = _fetch_list->GetMutable<std::vector<lite::Tensor>>();
+  if (offset >= fetch_list->size()) {
+    fetch_list->resize(offset + 1);
+  }
+  return &fetch_list->at(offset);
+}
+
 const std::vector<lite::Tensor> *Predictor::GetOutputs() const {
+  if (async_runner_) {
+    return async_runner_->GetOutputs();
+  }
   auto *_fetch_list = exec_scope_->FindVar("fetch");
   CHECK(_fetch_list) << "no fatch variable in exec_scope";
   auto &fetch_list = *_fetch_list->GetMutable<std::vector<lite::Tensor>>();
@@ -94,6 +134,13 @@ void Predictor::Build(const lite_api::CxxConfig &config,
   const Place prefer_place = config.preferred_place();
   const bool model_from_memory = config.model_from_memory();
   LOG(INFO) << "load from memory " << model_from_memory;
+  static_shape_ = config.static_shape();
+  memory_pool_enabled_ = config.memory_pool_enabled();
+  inter_op_threads_ = config.inter_op_threads();
+  x86_threads_ = config.x86_math_library_num_threads();
+  x86_cpu_ids_ = config.x86_cpu_ids();
+  program_cache_size_ = config.program_cache_size();
+  kept_vars_ = config.kept_vars();
 
   Build(model_path,
         model_file,
@@ -144,6 +191,7 @@ void Predictor::Build(const cpp::ProgramDesc &desc,
   program_desc_ = desc;
   Program program(desc, scope_, valid_places);
   optimizer_.KernelPickPreferPlace(prefer_place);
+  optimizer_.KeepVars(kept_vars_);
   core::KernelPickFactor factor;
   factor.ConsiderTarget();
   factor.ConsiderPrecision();
@@ -154,7 +202,60 @@ void Predictor::Build(const cpp::ProgramDesc &desc,
 void Predictor::GenRuntimeProgram() {
   program_ = optimizer_.GenRuntimeProgram();
   CHECK_EQ(exec_scope_, program_->exec_scope());
+  program_->set_static_shape(static_shape_);
+  program_->set_memory_pool_enabled(memory_pool_enabled_);
+  program_->set_inter_op_threads(inter_op_threads_);
+  program_->SetX86RunMode(x86_threads_, x86_cpu_ids_);
   program_generated_ = true;
+  InitProgramCache();
+}
+
+void Predictor::InitProgramCache() {
+  program_cache_.reset();
+  if (program_cache_size_ == 0) return;
+  runtime_program_desc_ = program_desc_;
+  program_->SaveOpInfosToProgram(&runtime_program_desc_);
+  program_->UpdateVarsOfProgram(&runtime_program_desc_);
+  auto create = [this] {
+    std::unique_ptr<RuntimeProgram> res(
+        new RuntimeProgram(runtime_program_desc_, scope_));
+    res->CopySettingsFrom(*program_);
+    return res;
+  };
+  program_cache_.reset(
+      new RuntimeProgramCache(program_.get(), create, program_cache_size_));
+}
+
+void Predictor::RunProgram() {
+  if (program_cache_) {
+    program_cache_->Run();
+  } else {
+    program_->Run();
+  }
+}
+
+std::unique_ptr<Predictor> Predictor::Clone() {
+  if (!program_generated_) {
+    GenRuntimeProgram();
+  }
+  // Build the clone from the optimized program with the picked kernels, no
+  // more optimization is needed.
+  std::unique_ptr<Predictor> res(new Predictor(scope_));
+  res->program_desc_ = program_desc_;
+  program_->SaveOpInfosToProgram(&res->program_desc_);
+  program_->UpdateVarsOfProgram(&res->program_desc_);
+  res->program_.reset(new RuntimeProgram(res->program_desc_, scope_));
+  res->exec_scope_ = res->program_->exec_scope();
+  res->static_shape_ = static_shape_;
+  res->memory_pool_enabled_ = memory_pool_enabled_;
+  res->inter_op_threads_ = inter_op_threads_;
+  res->x86_threads_ = x86_threads_;
+  res->x86_cpu_ids_ = x86_cpu_ids_;
+  res->program_->CopySettingsFrom(*program_);
+  res->program_cache_size_ = program_cache_size_;
+  res->InitProgramCache();
+  res->program_generated_ = true;
+  return res;
 }
 
 const lite::Tensor *Predictor::GetTensor(const std::string &name) const {
@@ -162,9 +263,15 @@ const lite::Tensor *Predictor::GetTensor(const std::string &name) const {
   return &var->Get<lite::Tensor>();
 }
 
+lite::Tensor *Predictor::GetMutableTensor(const std::string &name) {
+  auto *var = exec_scope_->FindVar(name);
+  CHECK(var) << "no variable " << name << " in exec_scope";
+  return var->GetMutable<lite::Tensor>();
+}
+
 #ifdef LITE_WITH_TRAIN
 void Predictor::FeedVars(const std::vector<framework::Tensor> &tensors) {
-  auto var = scope_->FindVar("feed");
+  auto var = exec_scope_->FindVar("feed");
   auto &feed_list = *(var->GetMutable<std::vector<lite::Tensor>>());
   feed_list.resize(tensors.size());
 
@@ -17,10 +17,12 @@
 #include <string>
 #include <utility>
 #include <vector>
+#include "lite/api/async_runner.h"
 #include "lite/api/paddle_api.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/optimizer.h"
 #include "lite/core/program.h"
+#include "lite/core/program_cache.h"
 #include "lite/core/types.h"
 #include "lite/model_parser/model_parser.h"
 
@@ -62,24 +64,70 @@ class LITE_API Predictor {
 
   void GenRuntimeProgram();
 
+  // Create a predictor sharing the weights with this one, and the weights
+  // packed by the kernels, see PackedWeights. It has its own exec scope and
+  // kernels, and can run concurrently with this one.
+  std::unique_ptr<Predictor> Clone();
+
+  // Infer the shapes in the first run only, see RuntimeProgram.
+  void set_static_shape(bool x) { static_shape_ = x; }
+  // Cache the host memory of the temporary tensors, see RuntimeProgram.
+  void set_memory_pool_enabled(bool x) { memory_pool_enabled_ = x; }
+  // Run the independent ops concurrently, see RuntimeProgram.
+  void set_inter_op_threads(int x) {
+    inter_op_threads_ = x;
+    if (program_) program_->set_inter_op_threads(x);
+  }
+  // Run the X86 kernels with `threads` threads of the math library on the
+  // cores `cpu_ids`, see RuntimeProgram.
+  void SetX86RunMode(int threads, const std::vector<int>& cpu_ids) {
+    x86_threads_ = threads;
+    x86_cpu_ids_ = cpu_ids;
+    if (program_) program_->SetX86RunMode(threads, cpu_ids);
+  }
+  // Keep the programs of `x` recent input shapes besides the first one, 0 to
+  // disable, see RuntimeProgramCache.
+  void set_program_cache_size(size_t x) {
+    program_cache_size_ = x;
+    if (program_generated_) InitProgramCache();
+  }
+
   // Run the predictor for a single batch of data.
   void Run() {
+    if (async_runner_) {
+      RunAsync(nullptr).get();
+      return;
+    }
     if (!program_generated_) {
       GenRuntimeProgram();
     }
-    program_->Run();
+    RunProgram();
     LOG(INFO) << "running";
   }
 
+  // Run in a worker thread, the inputs and outputs are double buffered after
+  // the first call, see AsyncRunner.
+  std::future<void> RunAsync(const std::function<void()>& done);
+
+  // Run the instructions needed for the `targets` only, taking the `provided`
+  // variables as computed, see RuntimeProgram::RunPartial. It runs the first
+  // program in the caller's thread, the program cache is not used.
+  void RunPartial(const std::vector<std::string>& targets,
+                  const std::vector<std::string>& provided = {});
+
   // Get offset-th col of feed inputs.
   lite::Tensor* GetInput(size_t offset);
 
   // Get offset-th col of fetch results.
   const lite::Tensor* GetOutput(size_t offset) const;
   const std::vector<lite::Tensor>* GetOutputs() const;
+  // Get offset-th col of fetch results to bind an external memory, not for
+  // the runs by RunAsync.
+  lite::Tensor* GetMutableOutput(size_t offset);
 
   const cpp::ProgramDesc& program_desc() const;
   const lite::Tensor* GetTensor(const std::string& name) const;
+  lite::Tensor* GetMutableTensor(const std::string& name);
   const RuntimeProgram& runtime_program() const;
 
   // This method is disabled in mobile, for unnecessary dependencies required.
@@ -97,12 +145,28 @@ class LITE_API Predictor {
 #endif
 
  private:
+  void InitProgramCache();
+  void RunProgram();
+
   Optimizer optimizer_;
   cpp::ProgramDesc program_desc_;
   std::shared_ptr<Scope> scope_;
   const Scope* exec_scope_;
   std::unique_ptr<RuntimeProgram> program_;
   bool program_generated_{false};
+  bool static_shape_{false};
+  bool memory_pool_enabled_{false};
+  int inter_op_threads_{0};
+  int x86_threads_{0};
+  std::vector<int> x86_cpu_ids_;
+  size_t program_cache_size_{0};
+  // The variables kept by the dead code elimination besides the fetched ones.
+  std::vector<std::string> kept_vars_;
+  // The optimized program with the picked kernels, to create the programs of
+  // the other input shapes.
+  cpp::ProgramDesc runtime_program_desc_;
+  std::unique_ptr<RuntimeProgramCache> program_cache_;
+  std::unique_ptr<AsyncRunner> async_runner_;
 };
 
 /*
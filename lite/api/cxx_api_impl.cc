@@ -31,47 +31,86 @@ class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
 
   void Run() override;
 
+  std::unique_ptr<lite_api::Tensor> GetMutableOutput(int i) override;
+
+  std::future<void> RunAsync(const std::function<void()> &done) override;
+
+  void RunPartial(const std::vector<std::string> &targets,
+                  const std::vector<std::string> &provided) override;
+
+  std::shared_ptr<lite_api::PaddlePredictor> Clone() override;
+
   std::unique_ptr<const lite_api::Tensor> GetTensor(
       const std::string &name) const override;
 
+  std::unique_ptr<lite_api::Tensor> GetMutableTensor(
+      const std::string &name) override;
+
   void SaveOptimizedModel(const std::string &model_dir,
                           lite_api::LiteModelType model_type =
                               lite_api::LiteModelType::kProtobuf) override;
 
  private:
-  Predictor raw_predictor_;
+  std::unique_ptr<Predictor> raw_predictor_;
 };
 
-CxxPaddleApiImpl::CxxPaddleApiImpl() {}
+CxxPaddleApiImpl::CxxPaddleApiImpl() : raw_predictor_(new Predictor) {}
 
 void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
   auto places = config.valid_places();
   places.emplace_back(TARGET(kHost), PRECISION(kAny), DATALAYOUT(kAny));
-  raw_predictor_.Build(config, places);
+  raw_predictor_->Build(config, places);
 }
 
 std::unique_ptr<lite_api::Tensor> CxxPaddleApiImpl::GetInput(int i) {
-  auto *x = raw_predictor_.GetInput(i);
+  auto *x = raw_predictor_->GetInput(i);
   return std::unique_ptr<lite_api::Tensor>(new lite_api::Tensor(x));
 }
 
 std::unique_ptr<const lite_api::Tensor> CxxPaddleApiImpl::GetOutput(
     int i) const {
-  const auto *x = raw_predictor_.GetOutput(i);
+  const auto *x = raw_predictor_->GetOutput(i);
   return std::unique_ptr<lite_api::Tensor>(new lite_api::Tensor(x));
 }
 
-void CxxPaddleApiImpl::Run() { raw_predictor_.Run(); }
+std::unique_ptr<lite_api::Tensor> CxxPaddleApiImpl::GetMutableOutput(int i) {
+  auto *x = raw_predictor_->GetMutableOutput(i);
+  return std::unique_ptr<lite_api::Tensor>(new lite_api::Tensor(x));
+}
+
+void CxxPaddleApiImpl::Run() { raw_predictor_->Run(); }
+
+std::future<void> CxxPaddleApiImpl::RunAsync(
+    const std::function<void()> &done) {
+  return raw_predictor_->RunAsync(done);
+}
+
+void CxxPaddleApiImpl::RunPartial(const std::vector<std::string> &targets,
+                                  const std::vector<std::string> &provided) {
+  raw_predictor_->RunPartial(targets, provided);
+}
+
+std::shared_ptr<lite_api::PaddlePredictor> CxxPaddleApiImpl::Clone() {
+  auto x = std::make_shared<CxxPaddleApiImpl>();
+  x->raw_predictor_ = raw_predictor_->Clone();
+  return x;
+}
 
 std::unique_ptr<const lite_api::Tensor> CxxPaddleApiImpl::GetTensor(
     const std::string &name) const {
-  auto *x = raw_predictor_.GetTensor(name);
+  auto *x = raw_predictor_->GetTensor(name);
   return std::unique_ptr<const lite_api::Tensor>(new lite_api::Tensor(x));
 }
 
+std::unique_ptr<lite_api::Tensor> CxxPaddleApiImpl::GetMutableTensor(
+    const std::string &name) {
+  auto *x = raw_predictor_->GetMutableTensor(name);
+  return std::unique_ptr<lite_api::Tensor>(new lite_api::Tensor(x));
+}
+
 void CxxPaddleApiImpl::SaveOptimizedModel(const std::string &model_dir,
                                           lite_api::LiteModelType model_type) {
-  raw_predictor_.SaveModel(model_dir, model_type);
+  raw_predictor_->SaveModel(model_dir, model_type);
 }
 
 }  // namespace lite
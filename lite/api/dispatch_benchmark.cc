@@ -0,0 +1,118 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * Measure the framework overhead of running an instruction. A chain of ops
+ * with no-op kernels is run, so the time per op is all spent by the program
+ * dispatching the kernels: the shape inference and the launching.
+ */
+#include <gflags/gflags.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/api/test_helper.h"
+#include "lite/core/program.h"
+#include "lite/utils/cp_logging.h"
+#include "lite/utils/string.h"
+
+DEFINE_int32(num_ops, 1000, "number of the no-op instructions in the program");
+
+namespace paddle {
+namespace lite {
+
+// An op passing the shape of its input to its output.
+class NoopOp : public OpLite {
+ public:
+  NoopOp() : OpLite("noop") {}
+
+  bool InferShape() const override {
+    out_->Resize(x_->dims());
+    return true;
+  }
+
+  bool AttachImpl(const cpp::OpDesc& opdesc, lite::Scope* scope) override {
+    x_ = scope->Var(opdesc.Input("X").front())->GetMutable<Tensor>();
+    out_ = scope->Var(opdesc.Output("Out").front())->GetMutable<Tensor>();
+    return true;
+  }
+  void AttachKernel(KernelBase* kernel) override {}
+  std::string DebugString() const override { return "noop"; }
+
+ private:
+  Tensor* x_{};
+  Tensor* out_{};
+};
+
+class NoopCompute
+    : public KernelLite<TARGET(kHost), PRECISION(kAny), DATALAYOUT(kAny)> {
+ public:
+  void Run() override {}
+};
+
+// x -> noop -> var_1 -> noop -> ... -> var_n
+std::unique_ptr<RuntimeProgram> CreateNoopProgram(Scope* scope, int num_ops) {
+  scope->Var("var_0")->GetMutable<Tensor>()->Resize({1, 16});
+  std::vector<Instruction> insts;
+  for (int i = 0; i < num_ops; ++i) {
+    cpp::OpDesc desc;
+    desc.SetType("noop");
+    desc.SetInput("X", {string_format("var_%d", i)});
+    desc.SetOutput("Out", {string_format("var_%d", i + 1)});
+    std::shared_ptr<OpLite> op(new NoopOp);
+    op->Attach(desc, scope);
+    insts.emplace_back(op, std::unique_ptr<KernelBase>(new NoopCompute));
+  }
+  std::unique_ptr<RuntimeProgram> program(
+      new RuntimeProgram(std::move(insts)));
+  program->set_exec_scope(scope);
+  program->set_memory_plan_enabled(false);
+  return program;
+}
+
+// Return the time per op in ns.
+double Measure(RuntimeProgram* program) {
+  for (int i = 0; i < FLAGS_warmup; ++i) {
+    program->Run();
+  }
+  auto start = GetCurrentUS();
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    program->Run();
+  }
+  return (GetCurrentUS() - start) * 1000. / FLAGS_repeats / FLAGS_num_ops;
+}
+
+}  // namespace lite
+}  // namespace paddle
+
+int main(int argc, char** argv) {
+  using paddle::lite::string_format;
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  FLAGS_warmup = std::max(FLAGS_warmup, 1);
+  FLAGS_repeats = std::max(FLAGS_repeats, 100);
+
+  paddle::lite::Scope scope;
+  auto program = paddle::lite::CreateNoopProgram(&scope, FLAGS_num_ops);
+  // The input shapes are not known without feeds, the shapes are inferred in
+  // every run unless they are static.
+  double infer_ns = paddle::lite::Measure(program.get());
+  program->set_static_shape(true);
+  double lean_ns = paddle::lite::Measure(program.get());
+
+  LOG(INFO) << FLAGS_num_ops << " ops, " << FLAGS_repeats << " repeats";
+  LOG(INFO) << string_format("shapes inferred: %8.1f ns/op", infer_ns);
+  LOG(INFO) << string_format("shapes reused:   %8.1f ns/op", lean_ns);
+  return 0;
+}
@@ -62,6 +62,12 @@ TEST(InceptionV4, test) {
             << ", spend " << (GetCurrentUS() - start) / FLAGS_repeats / 1000.0
             << " ms in average.";
 
+  if (FLAGS_inter_op_threads > 1) {
+    // Run the independent ops concurrently, and compare with the sequential
+    // run above.
+    EXPECT_LE(BenchmarkInterOpThreads(&predictor), 1e-6);
+  }
+
   // std::vector<float> results({0.00078033, 0.00083865, 0.00060029, 0.00057083,
   //                            0.00070094, 0.00080584, 0.00044525, 0.00074907,
   //                            0.00059774, 0.00063654});
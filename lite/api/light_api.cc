@@ -22,7 +22,7 @@ void LightPredictor::Build(const std::string& model_dir,
                            const std::string& param_buffer,
                            lite_api::LiteModelType model_type,
                            bool model_from_memory) {
-  cpp::ProgramDesc desc;
+  auto& desc = program_desc_;
   switch (model_type) {
 #ifndef LITE_ON_TINY_PUBLISH
     case lite_api::LiteModelType::kProtobuf:
@@ -44,7 +44,46 @@ void LightPredictor::Build(const std::string& model_dir,
   BuildRuntimeProgram(desc);
 }
 
+void LightPredictor::RunProgram() {
+  if (program_cache_) {
+    program_cache_->Run();
+  } else {
+    program_->Run();
+  }
+}
+
+void LightPredictor::set_program_cache_size(size_t x) {
+  if (x == 0) {
+    program_cache_.reset();
+    return;
+  }
+  auto create = [this] {
+    std::unique_ptr<RuntimeProgram> res(
+        new RuntimeProgram(program_desc_, scope_));
+    res->CopySettingsFrom(*program_);
+    return res;
+  };
+  program_cache_.reset(new RuntimeProgramCache(program_.get(), create, x));
+}
+
+std::future<void> LightPredictor::RunAsync(const std::function<void()>& done) {
+  if (!async_runner_) {
+    async_runner_.reset(
+        new AsyncRunner(program_->exec_scope(), [this] { RunProgram(); }));
+  }
+  return async_runner_->RunAsync(done);
+}
+
+void LightPredictor::RunPartial(const std::vector<std::string>& targets,
+                                const std::vector<std::string>& provided) {
+  if (async_runner_) async_runner_->Wait();
+  program_->RunPartial(targets, provided);
+}
+
 Tensor* LightPredictor::GetInput(size_t offset) {
+  if (async_runner_) {
+    return async_runner_->GetInput(offset);
+  }
   auto* _feed_list = program_->exec_scope()->FindVar("feed");
   CHECK(_feed_list) << "no feed variable in exec_scope";
   auto* feed_list = _feed_list->GetMutable<std::vector<Tensor>>();
@@ -55,6 +94,9 @@ Tensor* LightPredictor::GetInput(size_t offset) {
 }
 
 const Tensor* LightPredictor::GetOutput(size_t offset) {
+  if (async_runner_) {
+    return async_runner_->GetOutput(offset);
+  }
   auto* _fetch_list = program_->exec_scope()->FindVar("fetch");
   CHECK(_fetch_list) << "no fatch variable in exec_scope";
   auto& fetch_list = *_fetch_list->GetMutable<std::vector<lite::Tensor>>();
@@ -62,33 +104,35 @@ const Tensor* LightPredictor::GetOutput(size_t offset) {
   return &fetch_list.at(offset);
 }
 
-void LightPredictor::BuildRuntimeProgram(const cpp::ProgramDesc& prog) {
-  std::vector<Instruction> insts;
-  // 1. Create op first
-  Program program(prog, scope_, {});
-
-  // 2. Create Instructs
+Tensor* LightPredictor::GetMutableOutput(size_t offset) {
+  CHECK(!async_runner_) << "the outputs of RunAsync are double buffered";
+  auto* _fetch_list = program_->exec_scope()->FindVar("fetch");
+  CHECK(_fetch_list) << "no fatch variable in exec_scope";
+  auto* fetch_list = _fetch_list->GetMutable<std::vector<Tensor>>();
+  if (offset >= fetch_list->size()) {
+    fetch_list->resize(offset + 1);
+  }
+  return &fetch_list->at(offset);
+}
 
-  // Create the kernels of the target places, and filter out the specific
-  // kernel with the target alias.
-  for (auto& op : program.ops()) {
-    auto kernel_type = op->op_info()->GetAttr<std::string>(kKernelTypeAttr);
-    std::string op_type, alias;
-    Place place;
-    KernelBase::ParseKernelType(kernel_type, &op_type, &alias, &place);
-    auto kernels = op->CreateKernels({place});
-    // filter out a kernel
-    auto it = std::find_if(
-        kernels.begin(), kernels.end(), [&](std::unique_ptr<KernelBase>& it) {
-          return it->alias() == alias;
-        });
-    CHECK(it != kernels.end());
-    (*it)->SetContext(ContextScheduler::Global().NewContext((*it)->target()));
-    insts.emplace_back(op, std::move(*it));
+const std::vector<Tensor>* LightPredictor::GetOutputs() {
+  if (async_runner_) {
+    return async_runner_->GetOutputs();
   }
-  program_.reset(new RuntimeProgram(std::move(insts)));
-  CHECK(program.exec_scope());
-  program_->set_exec_scope(program.exec_scope());
+  auto* _fetch_list = program_->exec_scope()->FindVar("fetch");
+  CHECK(_fetch_list) << "no fatch variable in exec_scope";
+  return _fetch_list->GetMutable<std::vector<lite::Tensor>>();
+}
+
+void LightPredictor::BuildRuntimeProgram(const cpp::ProgramDesc& prog) {
+  program_.reset(new RuntimeProgram(prog, scope_));
+}
+
+std::unique_ptr<LightPredictor> LightPredictor::Clone() const {
+  std::unique_ptr<LightPredictor> res(new LightPredictor(program_desc_, scope_));
+  res->program_->CopySettingsFrom(*program_);
+  res->set_program_cache_size(program_cache_size());
+  return res;
 }
 
 }  // namespace lite
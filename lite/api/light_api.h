@@ -22,9 +22,11 @@
 #include <string>
 #include <utility>
 #include <vector>
+#include "lite/api/async_runner.h"
 #include "lite/api/paddle_api.h"
 #include "lite/core/context.h"
 #include "lite/core/program.h"
+#include "lite/core/program_cache.h"
 #include "lite/core/tensor.h"
 #include "lite/core/types.h"
 #include "lite/model_parser/model_parser.h"
@@ -48,18 +50,77 @@ class LITE_API LightPredictor {
     Build(model_dir, model_buffer, param_buffer, model_type, model_from_memory);
   }
 
-  void Run() { program_->Run(); }
+  // Create a predictor from the program loaded, the weights are shared.
+  LightPredictor(const cpp::ProgramDesc& desc,
+                 const std::shared_ptr<Scope>& scope)
+      : program_desc_(desc), scope_(scope) {
+    BuildRuntimeProgram(program_desc_);
+  }
+
+  void Run() {
+    if (async_runner_) {
+      RunAsync(nullptr).get();
+      return;
+    }
+    RunProgram();
+  }
+
+  // Run in a worker thread, the inputs and outputs are double buffered after
+  // the first call, see AsyncRunner.
+  std::future<void> RunAsync(const std::function<void()>& done);
+
+  // Run the instructions needed for the `targets` only, taking the `provided`
+  // variables as computed, see RuntimeProgram::RunPartial. It runs the first
+  // program in the caller's thread, the program cache is not used.
+  void RunPartial(const std::vector<std::string>& targets,
+                  const std::vector<std::string>& provided = {});
+
+  // Create a predictor sharing the weights with this one, and the weights
+  // packed by the kernels, see PackedWeights. It has its own exec scope and
+  // kernels, and can run concurrently with this one.
+  std::unique_ptr<LightPredictor> Clone() const;
+
+  // Infer the shapes in the first run only, see RuntimeProgram.
+  void set_static_shape(bool x) { program_->set_static_shape(x); }
+  // Cache the host memory of the temporary tensors, see RuntimeProgram.
+  void set_memory_pool_enabled(bool x) {
+    program_->set_memory_pool_enabled(x);
+  }
+  // Set the power mode and threads to run with, see RuntimeProgram.
+  void SetRunMode(lite_api::PowerMode mode, int threads) {
+    program_->SetRunMode(mode, threads);
+  }
+  // Run the independent ops concurrently, see RuntimeProgram.
+  void set_inter_op_threads(int x) { program_->set_inter_op_threads(x); }
+  // Keep the programs of `x` recent input shapes besides the first one, 0 to
+  // disable, see RuntimeProgramCache. It should be set after the settings
+  // above, which are copied to the programs created.
+  void set_program_cache_size(size_t x);
+  size_t program_cache_size() const {
+    return program_cache_ ? program_cache_->capacity() : 0;
+  }
 
   // Get offset-th col of feed inputs.
   Tensor* GetInput(size_t offset);
 
   // Get offset-th col of fetch outputs.
   const Tensor* GetOutput(size_t offset);
+  const std::vector<Tensor>* GetOutputs();
+  // Get offset-th col of fetch outputs to bind an external memory, not for
+  // the runs by RunAsync.
+  Tensor* GetMutableOutput(size_t offset);
 
   const lite::Tensor* GetTensor(const std::string& name) const {
     auto* var = program_->exec_scope()->FindVar(name);
     return &var->Get<lite::Tensor>();
   }
+  lite::Tensor* GetMutableTensor(const std::string& name) {
+    auto* var = program_->exec_scope()->FindVar(name);
+    CHECK(var) << "no variable " << name << " in exec_scope";
+    return var->GetMutable<lite::Tensor>();
+  }
+
+  const RuntimeProgram& runtime_program() const { return *program_; }
 
  private:
   void Build(
@@ -70,10 +131,14 @@ class LITE_API LightPredictor {
       bool model_from_memory = false);
 
   void BuildRuntimeProgram(const cpp::ProgramDesc& prog);
+  void RunProgram();
 
  private:
+  cpp::ProgramDesc program_desc_;
   std::shared_ptr<Scope> scope_;
   std::unique_ptr<RuntimeProgram> program_;
+  std::unique_ptr<RuntimeProgramCache> program_cache_;
+  std::unique_ptr<AsyncRunner> async_runner_;
 };
 
 }  // namespace lite
@@ -29,9 +29,20 @@ class LightPredictorImpl : public PaddlePredictor {
 
   void Run() override;
 
+  std::unique_ptr<Tensor> GetMutableOutput(int i) override;
+
+  std::future<void> RunAsync(const std::function<void()>& done) override;
+
+  void RunPartial(const std::vector<std::string>& targets,
+                  const std::vector<std::string>& provided) override;
+
+  std::shared_ptr<PaddlePredictor> Clone() override;
+
   std::unique_ptr<const Tensor> GetTensor(
       const std::string& name) const override;
 
+  std::unique_ptr<Tensor> GetMutableTensor(const std::string& name) override;
+
   void Init(const MobileConfig& config);
 
  private:
@@ -42,13 +53,18 @@ void LightPredictorImpl::Init(const MobileConfig& config) {
 // LightPredictor Only support NaiveBuffer backend in publish lib
 #ifdef LITE_WITH_ARM
   lite::DeviceInfo::Init();
-  lite::DeviceInfo::Global().SetRunMode(config.power_mode(), config.threads());
 #endif
   raw_predictor_.reset(new lite::LightPredictor(config.model_dir(),
                                                 config.model_buffer(),
                                                 config.param_buffer(),
                                                 config.model_from_memory(),
                                                 LiteModelType::kNaiveBuffer));
+  raw_predictor_->set_static_shape(config.static_shape());
+  raw_predictor_->set_memory_pool_enabled(config.memory_pool_enabled());
+  raw_predictor_->set_inter_op_threads(config.inter_op_threads());
+  // The run mode is kept in the program, and bound to the threads running it.
+  raw_predictor_->SetRunMode(config.power_mode(), config.threads());
+  raw_predictor_->set_program_cache_size(config.program_cache_size());
 }
 
 std::unique_ptr<Tensor> LightPredictorImpl::GetInput(int i) {
@@ -61,12 +77,39 @@ std::unique_ptr<const Tensor> LightPredictorImpl::GetOutput(int i) const {
 
 void LightPredictorImpl::Run() { raw_predictor_->Run(); }
 
+std::unique_ptr<Tensor> LightPredictorImpl::GetMutableOutput(int i) {
+  return std::unique_ptr<Tensor>(
+      new Tensor(raw_predictor_->GetMutableOutput(i)));
+}
+
+std::future<void> LightPredictorImpl::RunAsync(
+    const std::function<void()>& done) {
+  return raw_predictor_->RunAsync(done);
+}
+
+void LightPredictorImpl::RunPartial(const std::vector<std::string>& targets,
+                                    const std::vector<std::string>& provided) {
+  raw_predictor_->RunPartial(targets, provided);
+}
+
+std::shared_ptr<PaddlePredictor> LightPredictorImpl::Clone() {
+  auto x = std::make_shared<LightPredictorImpl>();
+  x->raw_predictor_ = raw_predictor_->Clone();
+  return x;
+}
+
 std::unique_ptr<const Tensor> LightPredictorImpl::GetTensor(
     const std::string& name) const {
   return std::unique_ptr<const Tensor>(
       new Tensor(raw_predictor_->GetTensor(name)));
 }
 
+std::unique_ptr<Tensor> LightPredictorImpl::GetMutableTensor(
+    const std::string& name) {
+  return std::unique_ptr<Tensor>(
+      new Tensor(raw_predictor_->GetMutableTensor(name)));
+}
+
 template <>
 std::shared_ptr<PaddlePredictor> CreatePaddlePredictor(
     const MobileConfig& config) {
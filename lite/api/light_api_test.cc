@@ -13,8 +13,11 @@
 // limitations under the License.
 
 #include "lite/api/light_api.h"
+#include <algorithm>
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
+#include <set>
+#include <string>
 #include "lite/api/paddle_use_kernels.h"
 #include "lite/api/paddle_use_ops.h"
 #include "lite/api/paddle_use_passes.h"
@@ -86,5 +89,66 @@ TEST(LightAPI, loadNaiveBuffer) {
   }
 }
 
+TEST(LightAPI, run_partial) {
+  if (FLAGS_optimized_model.empty()) {
+    FLAGS_optimized_model = "lite_naive_model";
+  }
+  LightPredictor predictor(FLAGS_optimized_model, "", "");
+  auto* input_tensor = predictor.GetInput(0);
+  input_tensor->Resize(DDim(std::vector<int64_t>({100, 100})));
+  auto* data = input_tensor->mutable_data<float>();
+  for (int i = 0; i < 100 * 100; i++) {
+    data[i] = i;
+  }
+  predictor.Run();
+  Tensor expected;
+  expected.CopyDataFrom(*predictor.GetOutput(0));
+
+  // The variable fetched, and an input of the op computing it, which is
+  // computed by the ops before.
+  auto& insts = predictor.runtime_program().instructions();
+  std::string target;
+  for (auto& inst : insts) {
+    if (inst.op()->op_info()->Type() == "fetch") {
+      target = inst.op()->op_info()->Input("X").front();
+    }
+  }
+  ASSERT_FALSE(target.empty());
+  std::string provided;
+  std::set<std::string> computed;
+  for (auto& inst : insts) {
+    auto* op_info = inst.op()->op_info();
+    auto outputs = op_info->output_names();
+    if (std::find(outputs.begin(), outputs.end(), target) != outputs.end()) {
+      for (auto& name : op_info->input_names()) {
+        if (computed.count(name)) provided = name;
+      }
+      break;
+    }
+    computed.insert(outputs.begin(), outputs.end());
+  }
+  ASSERT_FALSE(provided.empty());
+
+  auto check_target = [&] {
+    auto* out = predictor.GetTensor(target);
+    ASSERT_EQ(out->dims(), expected.dims());
+    for (int i = 0; i < out->dims().production(); i++) {
+      EXPECT_NEAR(out->data<float>()[i], expected.data<float>()[i], 1e-5);
+    }
+  };
+  predictor.RunPartial({target});
+  check_target();
+
+  // Resume from the provided variable, the feeds are not used.
+  Tensor saved;
+  saved.CopyDataFrom(*predictor.GetTensor(provided));
+  for (int i = 0; i < 100 * 100; i++) {
+    data[i] = 0;
+  }
+  predictor.GetMutableTensor(provided)->CopyDataFrom(saved);
+  predictor.RunPartial({target}, {provided});
+  check_target();
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -57,6 +57,12 @@ void TestModel(const std::vector<Place>& valid_places,
             << ", spend " << (GetCurrentUS() - start) / FLAGS_repeats / 1000.0
             << " ms in average.";
 
+  if (FLAGS_inter_op_threads > 1) {
+    // Run the independent ops concurrently, and compare with the sequential
+    // run above.
+    EXPECT_LE(BenchmarkInterOpThreads(&predictor), 1e-6);
+  }
+
   std::vector<std::vector<float>> results;
   // i = 1
   results.emplace_back(std::vector<float>(
@@ -58,6 +58,42 @@ lod_t Tensor::lod() const { return ctensor(raw_tensor_)->lod(); }
 
 void Tensor::SetLoD(const lod_t &lod) { tensor(raw_tensor_)->set_lod(lod); }
 
+void Tensor::ShareExternalMemory(void *data,
+                                 size_t memory_size,
+                                 TargetType target) {
+#ifdef LITE_WITH_FPGA
+  LOG(FATAL) << "The external memory is not supported by the FPGA tensor.";
+#else
+  const size_t kAlignment = 64;
+  CHECK_EQ(reinterpret_cast<uintptr_t>(data) % kAlignment, 0UL)
+      << "the external memory should be aligned to " << kAlignment
+      << " bytes";
+  tensor(raw_tensor_)->ShareExternalMemory(data, memory_size, target);
+#endif  // LITE_WITH_FPGA
+}
+
+std::unique_ptr<Tensor> PaddlePredictor::GetMutableOutput(int i) {
+  LOG(FATAL) << "The GetMutableOutput API is not supported by this predictor.";
+  return nullptr;
+}
+
+std::future<void> PaddlePredictor::RunAsync(
+    const std::function<void()> &done) {
+  LOG(FATAL) << "The RunAsync API is not supported by this predictor.";
+  return std::future<void>();
+}
+
+void PaddlePredictor::RunPartial(const std::vector<std::string> &targets,
+                                 const std::vector<std::string> &provided) {
+  LOG(FATAL) << "The RunPartial API is not supported by this predictor.";
+}
+
+std::unique_ptr<Tensor> PaddlePredictor::GetMutableTensor(
+    const std::string &name) {
+  LOG(FATAL) << "The GetMutableTensor API is not supported by this predictor.";
+  return nullptr;
+}
+
 void PaddlePredictor::SaveOptimizedModel(const std::string &model_dir,
                                          LiteModelType model_type) {
   LOG(FATAL)
@@ -19,6 +19,8 @@
 
 #ifndef PADDLE_LITE_API_H_  // NOLINT
 #define PADDLE_LITE_API_H_
+#include <functional>
+#include <future>  // NOLINT
 #include <memory>
 #include <string>
 #include <vector>
@@ -54,6 +56,16 @@ struct LITE_API Tensor {
   // Set LoD of the tensor
   void SetLoD(const lod_t& lod);
 
+  /// Use the memory of the caller as the storage, without copying. `data`
+  /// should be aligned to 64 bytes and outlive the use of the tensor, and the
+  /// shape should be set before. An input bound is read by the predictor in
+  /// place. An output bound, got by GetMutableOutput, is written by the op
+  /// computing it in place from the second run on. If the tensor outgrows the
+  /// memory, the predictor allocates its own instead.
+  void ShareExternalMemory(void* data,
+                           size_t memory_size,
+                           TargetType target = TargetType::kHost);
+
  private:
   void* raw_tensor_;
 };
@@ -70,12 +82,44 @@ class LITE_API PaddlePredictor {
   /// Get i-th output.
   virtual std::unique_ptr<const Tensor> GetOutput(int i) const = 0;
 
+  /// Get i-th output to bind an external memory by ShareExternalMemory.
+  virtual std::unique_ptr<Tensor> GetMutableOutput(int i);
+
   virtual void Run() = 0;
 
+  /// Run in a worker thread of the predictor and return at once, `done` is
+  /// called in the worker thread when the run is done, and then the returned
+  /// future is ready. After the first call, the inputs and outputs are double
+  /// buffered: GetInput returns the inputs of the next run, which can be set
+  /// while this run is in flight and should all be set for every run, and
+  /// GetOutput returns the outputs of the last run done, which stay valid
+  /// until the next run is done. The next run starts after this one is done,
+  /// so `done` should not call RunAsync.
+  virtual std::future<void> RunAsync(
+      const std::function<void()>& done = nullptr);
+
+  /// Run only the ops needed to compute the variables `targets`, read them by
+  /// GetTensor after. The variables `provided` are taken as computed, they
+  /// should be set by GetMutableTensor before, and the ops computing them are
+  /// skipped. It runs in the caller's thread and ignores the program cache.
+  /// The variables of the original model should be kept by
+  /// CxxConfig::set_kept_vars, or they may be renamed by the optimization.
+  virtual void RunPartial(const std::vector<std::string>& targets,
+                          const std::vector<std::string>& provided = {});
+
+  /// Create a predictor sharing the weights with this one, including the ones
+  /// packed by the kernels. The clone has its own inputs, outputs and
+  /// temporary variables, and can run concurrently with this one in another
+  /// thread.
+  virtual std::shared_ptr<PaddlePredictor> Clone() = 0;
+
   /// Get a readonly tensor, return null if no one called `name` exists.
   virtual std::unique_ptr<const Tensor> GetTensor(
       const std::string& name) const = 0;
 
+  /// Get a tensor to set, such as a variable provided to RunPartial.
+  virtual std::unique_ptr<Tensor> GetMutableTensor(const std::string& name);
+
   /// Persist the optimized model to disk. This API is only supported by
   /// CxxConfig, and the persisted model can be reused for MobileConfig.
   virtual void SaveOptimizedModel(
@@ -88,11 +132,30 @@ class LITE_API PaddlePredictor {
 /// Base class for all the configs.
 class LITE_API ConfigBase {
   std::string model_dir_;
+  bool static_shape_{false};
+  bool memory_pool_enabled_{false};
+  int inter_op_threads_{0};
+  int program_cache_size_{0};
 
  public:
   void set_model_dir(const std::string& x) { model_dir_ = x; }
+  /// The input shapes are fixed, the shapes are inferred in the first run only.
+  void set_static_shape(bool x) { static_shape_ = x; }
+  /// Cache the host memory of the temporary tensors by a memory pool.
+  void set_memory_pool_enabled(bool x) { memory_pool_enabled_ = x; }
+  /// Run the independent ops concurrently on `x` threads, 0 or 1 to run the
+  /// ops in sequence.
+  void set_inter_op_threads(int x) { inter_op_threads_ = x; }
+  /// Keep the compiled programs of `x` recent input shapes besides the first
+  /// one, so that switching among a few input shapes needs no re-planning.
+  /// They share the weights, 0 to disable.
+  void set_program_cache_size(int x) { program_cache_size_ = x; }
 
   const std::string& model_dir() const { return model_dir_; }
+  bool static_shape() const { return static_shape_; }
+  bool memory_pool_enabled() const { return memory_pool_enabled_; }
+  int inter_op_threads() const { return inter_op_threads_; }
+  int program_cache_size() const { return program_cache_size_; }
 };
 
 /// CxxConfig is the config for the Full feature predictor.
@@ -102,6 +165,9 @@ class LITE_API CxxConfig : public ConfigBase {
   std::string model_file_;
   std::string param_file_;
   bool model_from_memory_{false};
+  std::vector<std::string> kept_vars_;
+  int x86_math_library_num_threads_{0};
+  std::vector<int> x86_cpu_ids_;
 
  public:
   void set_preferred_place(const Place& x) { preferred_place_ = x; }
@@ -116,12 +182,30 @@ class LITE_API CxxConfig : public ConfigBase {
     param_file_ = std::string(param_buffer, param_buffer + param_buffer_size);
     model_from_memory_ = true;
   }
+  /// Keep the variables computed besides the fetched ones, such as the ones
+  /// read by GetTensor and the targets and the provided variables of
+  /// RunPartial. The ops reaching neither them nor the fetch ops are removed
+  /// from the optimized model, with their weights, and the kept variables are
+  /// not renamed by the inplace and the memory optimizations.
+  void set_kept_vars(const std::vector<std::string>& x) { kept_vars_ = x; }
+  /// The threads of the math library (MKL and OpenMP) for the X86 kernels,
+  /// 0 to keep the settings of the thread running the predictor.
+  void set_x86_math_library_num_threads(int threads) {
+    x86_math_library_num_threads_ = threads;
+  }
+  /// Bind the threads running the X86 kernels to the cores, empty to not bind.
+  void set_x86_cpu_ids(const std::vector<int>& x) { x86_cpu_ids_ = x; }
 
   const Place& preferred_place() const { return preferred_place_; }
   const std::vector<Place>& valid_places() const { return valid_places_; }
   std::string model_file() const { return model_file_; }
   std::string param_file() const { return param_file_; }
   bool model_from_memory() const { return model_from_memory_; }
+  const std::vector<std::string>& kept_vars() const { return kept_vars_; }
+  int x86_math_library_num_threads() const {
+    return x86_math_library_num_threads_;
+  }
+  const std::vector<int>& x86_cpu_ids() const { return x86_cpu_ids_; }
 };
 
 /// MobileConfig is the config for the light weight predictor, it will skip
@@ -15,6 +15,12 @@
 #include "lite/api/paddle_api.h"
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
 #include "lite/api/paddle_use_kernels.h"
 #include "lite/api/paddle_use_ops.h"
 #include "lite/api/paddle_use_passes.h"
@@ -58,6 +64,185 @@ TEST(CxxApi, run) {
                                 LiteModelType::kNaiveBuffer);
 }
 
+TEST(CxxApi, clone) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_preferred_place(Place{TARGET(kX86), PRECISION(kFloat)});
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+  std::vector<std::shared_ptr<PaddlePredictor>> predictors({predictor});
+  for (int i = 0; i < 3; i++) {
+    predictors.push_back(predictor->Clone());
+  }
+
+  // The clones share the weights and run concurrently.
+  std::vector<std::thread> threads;
+  for (auto& x : predictors) {
+    threads.emplace_back([x] {
+      auto input_tensor = x->GetInput(0);
+      input_tensor->Resize(std::vector<int64_t>({100, 100}));
+      auto* data = input_tensor->mutable_data<float>();
+      for (int i = 0; i < 100 * 100; i++) {
+        data[i] = i;
+      }
+      for (int i = 0; i < 10; i++) {
+        x->Run();
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  for (auto& x : predictors) {
+    auto* out = x->GetOutput(0)->data<float>();
+    EXPECT_NEAR(out[0], 50.2132, 1e-3);
+    EXPECT_NEAR(out[1], -28.8729, 1e-3);
+  }
+}
+
+// Fill the inputs of the next run while the current one is in flight.
+TEST(CxxApi, run_async) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_preferred_place(Place{TARGET(kX86), PRECISION(kFloat)});
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+  auto reference = predictor->Clone();
+  auto fill = [](PaddlePredictor* x, int k) {
+    auto input_tensor = x->GetInput(0);
+    input_tensor->Resize(std::vector<int64_t>({100, 100}));
+    auto* data = input_tensor->mutable_data<float>();
+    for (int i = 0; i < 100 * 100; i++) {
+      data[i] = i + k;
+    }
+  };
+  auto output_of = [](const PaddlePredictor* x) {
+    auto output = x->GetOutput(0);
+    auto* out = output->data<float>();
+    int64_t size = 1;
+    for (auto dim : output->shape()) {
+      size *= dim;
+    }
+    return std::vector<float>(out, out + size);
+  };
+
+  const int num_runs = 5;
+  std::vector<std::vector<float>> expected;
+  for (int k = 0; k < num_runs; k++) {
+    fill(reference.get(), k);
+    reference->Run();
+    expected.push_back(output_of(reference.get()));
+  }
+
+  std::vector<std::vector<float>> results(num_runs);
+  std::future<void> last;
+  fill(predictor.get(), 0);
+  for (int k = 0; k < num_runs; k++) {
+    last = predictor->RunAsync(
+        [&, k] { results[k] = output_of(predictor.get()); });
+    if (k + 1 < num_runs) {
+      fill(predictor.get(), k + 1);
+    }
+  }
+  last.get();
+  for (int k = 0; k < num_runs; k++) {
+    EXPECT_EQ(results[k], expected[k]) << "run " << k;
+  }
+
+  // The outputs of the last run stay readable after it is done.
+  EXPECT_EQ(output_of(predictor.get()), expected.back());
+}
+
+// Switch among a few input shapes, each one runs its own cached program.
+TEST(CxxApi, program_cache) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_preferred_place(Place{TARGET(kX86), PRECISION(kFloat)});
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+  auto reference = lite_api::CreatePaddlePredictor(config);
+  config.set_program_cache_size(2);
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+
+  auto run = [](PaddlePredictor* x, int64_t batch_size) {
+    auto input_tensor = x->GetInput(0);
+    input_tensor->Resize(std::vector<int64_t>({batch_size, 100}));
+    auto* data = input_tensor->mutable_data<float>();
+    for (int i = 0; i < batch_size * 100; i++) {
+      data[i] = i % 100;
+    }
+    x->Run();
+    auto output = x->GetOutput(0);
+    auto* out = output->data<float>();
+    int64_t size = 1;
+    for (auto dim : output->shape()) {
+      size *= dim;
+    }
+    return std::vector<float>(out, out + size);
+  };
+
+  for (int64_t batch_size : {100, 10, 50, 10, 100, 1, 50}) {
+    EXPECT_EQ(run(predictor.get(), batch_size),
+              run(reference.get(), batch_size))
+        << "batch size " << batch_size;
+  }
+}
+
+// Read the input from and write the output into the caller's memory.
+TEST(CxxApi, external_memory) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_preferred_place(Place{TARGET(kX86), PRECISION(kFloat)});
+  config.set_valid_places({
+      Place{TARGET(kX86), PRECISION(kFloat)},
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+
+  const int kAlignment = 64;
+  auto aligned_alloc = [&](size_t size) {
+    void* ptr = nullptr;
+    CHECK_EQ(posix_memalign(&ptr, kAlignment, size), 0);
+    return std::unique_ptr<float, decltype(&free)>(static_cast<float*>(ptr),
+                                                   &free);
+  };
+  auto input_memory = aligned_alloc(100 * 100 * sizeof(float));
+  for (int i = 0; i < 100 * 100; i++) {
+    input_memory.get()[i] = i;
+  }
+  auto input_tensor = predictor->GetInput(0);
+  input_tensor->Resize(std::vector<int64_t>({100, 100}));
+  input_tensor->ShareExternalMemory(input_memory.get(),
+                                    100 * 100 * sizeof(float));
+
+  // Run once to get the output shape.
+  predictor->Run();
+  int64_t output_size = 1;
+  for (auto x : predictor->GetOutput(0)->shape()) output_size *= x;
+  auto output_memory = aligned_alloc(output_size * sizeof(float));
+  predictor->GetMutableOutput(0)->ShareExternalMemory(
+      output_memory.get(), output_size * sizeof(float));
+
+  for (int i = 0; i < 2; i++) {
+    predictor->Run();
+    auto* out = predictor->GetOutput(0)->data<float>();
+    EXPECT_EQ(out, output_memory.get());
+    EXPECT_NEAR(out[0], 50.2132, 1e-3);
+    EXPECT_NEAR(out[1], -28.8729, 1e-3);
+  }
+}
+
 // Demo1 for Mobile Devices :Load model from file and run
 #ifdef LITE_WITH_LIGHT_WEIGHT_FRAMEWORK
 TEST(LightApi, run) {
@@ -84,6 +269,72 @@ TEST(LightApi, run) {
   EXPECT_NEAR(out[1], -28.8729, 1e-3);
 }
 
+// The predictors with different run modes run concurrently.
+TEST(LightApi, run_modes_in_parallel) {
+  std::vector<std::pair<PowerMode, int>> run_modes({
+      {LITE_POWER_HIGH, 2},
+      {LITE_POWER_LOW, 1},
+      {LITE_POWER_NO_BIND, 4},
+      {LITE_POWER_FULL, 2},
+  });
+  std::vector<std::shared_ptr<PaddlePredictor>> predictors;
+  for (auto& mode : run_modes) {
+    lite_api::MobileConfig config;
+    config.set_model_dir(FLAGS_model_dir + ".opt2.naive");
+    config.set_power_mode(mode.first);
+    config.set_threads(mode.second);
+    predictors.push_back(lite_api::CreatePaddlePredictor(config));
+  }
+
+  auto run = [](PaddlePredictor* predictor) {
+    auto input_tensor = predictor->GetInput(0);
+    input_tensor->Resize(std::vector<int64_t>({100, 100}));
+    auto* data = input_tensor->mutable_data<float>();
+    for (int i = 0; i < 100 * 100; i++) {
+      data[i] = i;
+    }
+    predictor->Run();
+    auto output = predictor->GetOutput(0);
+    auto* out = output->data<float>();
+    int64_t size = 1;
+    for (auto dim : output->shape()) {
+      size *= dim;
+    }
+    return std::vector<float>(out, out + size);
+  };
+
+  // The results of the sequential runs.
+  std::vector<std::vector<float>> expected;
+  for (auto& x : predictors) {
+    expected.push_back(run(x.get()));
+    EXPECT_NEAR(expected.back()[0], 50.2132, 1e-3);
+    EXPECT_NEAR(expected.back()[1], -28.8729, 1e-3);
+  }
+
+  std::vector<std::thread> threads;
+  std::vector<int> mismatches(predictors.size(), 0);
+  for (size_t i = 0; i < predictors.size(); i++) {
+    threads.emplace_back([&, i] {
+      for (int j = 0; j < 20; j++) {
+        auto out = run(predictors[i].get());
+        if (out.size() != expected[i].size() ||
+            memcmp(out.data(),
+                   expected[i].data(),
+                   out.size() * sizeof(float)) != 0) {
+          mismatches[i]++;
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (size_t i = 0; i < predictors.size(); i++) {
+    EXPECT_EQ(mismatches[i], 0) << "run mode " << run_modes[i].first
+                                << ", threads " << run_modes[i].second;
+  }
+}
+
 // Demo2 for Loading model from memory
 TEST(MobileConfig, LoadfromMemory) {
   // Get naive buffer
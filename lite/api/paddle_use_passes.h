@@ -25,6 +25,9 @@ USE_MIR_PASS(subgraph_program_pass);
 USE_MIR_PASS(io_copy_kernel_pick_pass);
 USE_MIR_PASS(argument_type_display_pass);
 USE_MIR_PASS(runtime_context_assign_pass);
+USE_MIR_PASS(memory_schedule_pass);
+USE_MIR_PASS(inplace_pass);
+USE_MIR_PASS(memory_optimize_pass);
 USE_MIR_PASS(graph_visualze);
 
 USE_MIR_PASS(lite_conv_bn_fuse_pass);
@@ -32,6 +35,9 @@ USE_MIR_PASS(lite_fc_fuse_pass);
 USE_MIR_PASS(lite_shuffle_channel_fuse_pass);
 USE_MIR_PASS(lite_transpose_softmax_transpose_fuse_pass);
 USE_MIR_PASS(identity_scale_eliminate_pass);
+USE_MIR_PASS(dead_code_eliminate_pass);
+USE_MIR_PASS(common_subexpression_eliminate_pass);
+USE_MIR_PASS(constant_fold_pass);
 USE_MIR_PASS(lite_conv_elementwise_fuse_pass);
 USE_MIR_PASS(lite_conv_activation_fuse_pass);
 USE_MIR_PASS(lite_elementwise_add_activation_fuse_pass);
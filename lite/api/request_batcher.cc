@@ -0,0 +1,296 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/request_batcher.h"
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+namespace paddle {
+namespace lite {
+
+namespace {
+
+// The tensors are copied by memcpy.
+bool IsHostMemory(TargetType target) {
+  return target == TARGET(kHost) || target == TARGET(kX86) ||
+         target == TARGET(kARM);
+}
+
+size_t RowBytes(const Tensor& x) {
+  CHECK(IsHostMemory(x.target())) << "Only the host tensors can be batched";
+  CHECK_GT(x.dims().size(), 0UL);
+  CHECK_GT(x.dims()[0], 0);
+  CHECK_EQ(x.memory_size() % x.dims()[0], 0UL);
+  return x.memory_size() / x.dims()[0];
+}
+
+// Copy rows [begin, end) of x to out.
+void CopyRows(const Tensor& x, int64_t begin, int64_t end, Tensor* out) {
+  size_t row_bytes = RowBytes(x);
+  auto dims = x.dims();
+  dims[0] = end - begin;
+  out->Resize(dims);
+  out->set_precision(x.precision());
+  auto* dst = out->mutable_data(x.target(), (end - begin) * row_bytes);
+  std::memcpy(dst,
+              static_cast<const char*>(x.raw_data()) + begin * row_bytes,
+              (end - begin) * row_bytes);
+}
+
+// Whether two requests can be coalesced.
+bool Compatible(const std::vector<Tensor>& a, const std::vector<Tensor>& b) {
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); i++) {
+    auto& x = a[i].dims();
+    auto& y = b[i].dims();
+    if (x.size() != y.size() || x.size() == 0) return false;
+    if (x.Slice(1, x.size()) != y.Slice(1, y.size())) return false;
+    if (RowBytes(a[i]) != RowBytes(b[i])) return false;
+    if (a[i].lod().size() != b[i].lod().size()) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+int64_t RequestBatchSize(const std::vector<Tensor>& inputs) {
+  CHECK(!inputs.empty());
+  auto& x = inputs.front();
+  if (!x.lod().empty()) {
+    return static_cast<int64_t>(x.lod()[0].size()) - 1;
+  }
+  CHECK_GT(x.dims().size(), 0UL);
+  return x.dims()[0];
+}
+
+void ConcatBatch(const std::vector<const Tensor*>& xs, Tensor* out) {
+  CHECK(!xs.empty());
+  auto& first = *xs.front();
+  size_t row_bytes = RowBytes(first);
+  auto dims = first.dims();
+  dims[0] = 0;
+  for (auto* x : xs) {
+    dims[0] += x->dims()[0];
+  }
+  out->Resize(dims);
+  out->set_precision(first.precision());
+  auto* dst = static_cast<char*>(
+      out->mutable_data(first.target(), dims[0] * row_bytes));
+  for (auto* x : xs) {
+    std::memcpy(dst, x->raw_data(), x->memory_size());
+    dst += x->memory_size();
+  }
+
+  // The offsets of every level are shifted by the ones of the tensors before.
+  LoD lod(first.lod().size(), std::vector<uint64_t>({0}));
+  for (auto* x : xs) {
+    CHECK_EQ(x->lod().size(), lod.size());
+    for (size_t level = 0; level < lod.size(); level++) {
+      auto& offsets = x->lod()[level];
+      uint64_t base = lod[level].back();
+      for (size_t i = 1; i < offsets.size(); i++) {
+        lod[level].push_back(base + offsets[i]);
+      }
+    }
+  }
+  out->set_lod(lod);
+}
+
+bool SplitBatch(const Tensor& x,
+                const std::vector<int64_t>& batch_sizes,
+                std::vector<Tensor>* res) {
+  res->clear();
+  res->resize(batch_sizes.size());
+  int64_t total = 0;
+  for (auto size : batch_sizes) total += size;
+  auto& lod = x.lod();
+  if (lod.empty()) {
+    if (x.dims().size() == 0 || x.dims()[0] != total) {
+      LOG(ERROR) << "Failed to split the output of dims " << x.dims()
+                 << " by rows into " << total;
+      return false;
+    }
+    int64_t begin = 0;
+    for (size_t k = 0; k < batch_sizes.size(); k++) {
+      CopyRows(x, begin, begin + batch_sizes[k], &(*res)[k]);
+      begin += batch_sizes[k];
+    }
+    return true;
+  }
+
+  if (static_cast<int64_t>(lod[0].size()) - 1 != total) {
+    LOG(ERROR) << "Failed to split the output of " << lod[0].size() - 1
+               << " sequences into " << total;
+    return false;
+  }
+  // The first item of the requests in every level.
+  std::vector<uint64_t> begins(lod.size(), 0);
+  for (size_t k = 0; k < batch_sizes.size(); k++) {
+    LoD sub_lod(lod.size());
+    uint64_t count = batch_sizes[k];
+    uint64_t row_begin = 0;
+    uint64_t row_end = 0;
+    for (size_t level = 0; level < lod.size(); level++) {
+      auto& offsets = lod[level];
+      uint64_t begin = begins[level];
+      if (begin + count >= offsets.size()) {
+        LOG(ERROR) << "Failed to split the output by the LoD of level "
+                   << level;
+        return false;
+      }
+      for (uint64_t i = begin; i <= begin + count; i++) {
+        sub_lod[level].push_back(offsets[i] - offsets[begin]);
+      }
+      begins[level] = begin + count;
+      // The items of the next level, or the rows.
+      row_begin = offsets[begin];
+      row_end = offsets[begin + count];
+      count = row_end - row_begin;
+    }
+    if (x.dims().size() == 0 ||
+        row_end > static_cast<uint64_t>(x.dims()[0])) {
+      LOG(ERROR) << "Failed to split the output of dims " << x.dims()
+                 << " by the LoD";
+      return false;
+    }
+    CopyRows(x, row_begin, row_end, &(*res)[k]);
+    (*res)[k].set_lod(sub_lod);
+  }
+  return true;
+}
+
+RequestBatcher::RequestBatcher(const run_fn_t& run,
+                               const BatchingOptions& options)
+    : run_(run), options_(options) {
+  CHECK_GT(options_.max_batch_size, 0);
+  worker_ = std::thread([this] { WorkerLoop(); });
+}
+
+RequestBatcher::~RequestBatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  cv_.notify_all();
+  worker_.join();
+}
+
+std::future<std::vector<Tensor>> RequestBatcher::Submit(
+    std::vector<Tensor>&& inputs) {
+  Request request;
+  request.batch_size = RequestBatchSize(inputs);
+  request.inputs = std::move(inputs);
+  request.enqueue_time = std::chrono::steady_clock::now();
+  auto res = request.promise.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK(!stopped_);
+    queue_.push_back(std::move(request));
+  }
+  cv_.notify_all();
+  return res;
+}
+
+int64_t RequestBatcher::HeadBatchSize() const {
+  int64_t batch_size = 0;
+  for (auto& request : queue_) {
+    if (Compatible(queue_.front().inputs, request.inputs)) {
+      batch_size += request.batch_size;
+    }
+  }
+  return batch_size;
+}
+
+void RequestBatcher::WorkerLoop() {
+  while (true) {
+    std::vector<Request> batch;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stopped_ || !queue_.empty(); });
+      if (queue_.empty()) return;
+      // Wait for more requests until the batch of the first one is full.
+      auto deadline = queue_.front().enqueue_time +
+                      std::chrono::microseconds(options_.max_wait_us);
+      cv_.wait_until(lock, deadline, [this] {
+        return stopped_ || HeadBatchSize() >= options_.max_batch_size;
+      });
+      // Take the requests of the same shapes as the first one, the others are
+      // kept in the queue in order, to be batched by their own shapes.
+      int64_t batch_size = 0;
+      for (auto it = queue_.begin(); it != queue_.end();) {
+        if (!batch.empty()) {
+          if (!Compatible(batch.front().inputs, it->inputs)) {
+            ++it;
+            continue;
+          }
+          if (batch_size + it->batch_size > options_.max_batch_size) break;
+        }
+        batch_size += it->batch_size;
+        batch.push_back(std::move(*it));
+        it = queue_.erase(it);
+      }
+    }
+    RunBatch(&batch);
+  }
+}
+
+void RequestBatcher::RunBatch(std::vector<Request>* batch) {
+  std::vector<int64_t> batch_sizes;
+  for (auto& request : *batch) {
+    batch_sizes.push_back(request.batch_size);
+  }
+  size_t num_inputs = batch->front().inputs.size();
+  std::vector<Tensor> inputs(num_inputs);
+  for (size_t i = 0; i < num_inputs; i++) {
+    if (batch->size() == 1) {
+      inputs[i] = batch->front().inputs[i];
+      continue;
+    }
+    std::vector<const Tensor*> xs;
+    for (auto& request : *batch) {
+      xs.push_back(&request.inputs[i]);
+    }
+    ConcatBatch(xs, &inputs[i]);
+  }
+
+  std::vector<Tensor> outputs;
+  run_(inputs, &outputs);
+  num_batches_++;
+  num_requests_ += batch->size();
+
+  // The outputs are copied out, for the buffers are reused by the next run.
+  std::vector<std::vector<Tensor>> results(batch->size());
+  std::vector<Tensor> parts;
+  for (auto& output : outputs) {
+    if (!SplitBatch(output, batch_sizes, &parts)) {
+      for (auto& request : *batch) {
+        request.promise.set_exception(std::make_exception_ptr(
+            std::runtime_error("Failed to split the outputs of the batch, "
+                               "whose dim 0 is not the batch size")));
+      }
+      return;
+    }
+    for (size_t k = 0; k < batch->size(); k++) {
+      results[k].push_back(std::move(parts[k]));
+    }
+  }
+  for (size_t k = 0; k < batch->size(); k++) {
+    (*batch)[k].promise.set_value(std::move(results[k]));
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
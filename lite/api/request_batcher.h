@@ -0,0 +1,127 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <functional>
+#include <future>  // NOLINT
+#include <memory>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+
+struct BatchingOptions {
+  // The max batch size of a run, in rows of dim 0, or sequences of the first
+  // LoD level for the inputs with LoD.
+  int max_batch_size{8};
+  // The max time to wait for more requests after the first one is queued.
+  int max_wait_us{1000};
+};
+
+/*
+ * RequestBatcher queues the requests from multiple threads, and coalesces
+ * them along dim 0 into one batch, to run the GEMM based kernels with a larger
+ * batch size. A batch is run when it is full or the first request of it has
+ * waited for max_wait_us, and the outputs are split back to the requests.
+ *
+ * The requests coalesced have the same number of inputs, and the same shapes
+ * except dim 0. The batch of the first request in the queue takes the later
+ * requests of its shapes, the ones of other shapes stay in the queue in order
+ * and are batched by their own shapes. The LoD of the inputs are merged, and
+ * the outputs with LoD are split by the sequences of the first level, so the
+ * ops should produce one top level sequence for every input row or sequence,
+ * as the detection ops do. The outputs without LoD are split by rows. If an
+ * output can not be split, the futures of the batch get an exception.
+ */
+class RequestBatcher {
+ public:
+  // Run the model with the batched inputs, and return the outputs.
+  using run_fn_t = std::function<void(const std::vector<Tensor>& inputs,
+                                      std::vector<Tensor>* outputs)>;
+
+  RequestBatcher(const run_fn_t& run, const BatchingOptions& options);
+  // Run the requests queued, and stop the worker.
+  ~RequestBatcher();
+
+  // Queue a request, the future is ready when its outputs are split back.
+  std::future<std::vector<Tensor>> Submit(std::vector<Tensor>&& inputs);
+
+  // The number of batches and requests run, for the statistics.
+  int64_t num_batches() const { return num_batches_; }
+  int64_t num_requests() const { return num_requests_; }
+
+ private:
+  struct Request {
+    std::vector<Tensor> inputs;
+    int64_t batch_size{};
+    std::chrono::steady_clock::time_point enqueue_time;
+    std::promise<std::vector<Tensor>> promise;
+  };
+
+  // The batch size of the queued requests coalescable with the first one.
+  int64_t HeadBatchSize() const;
+  void WorkerLoop();
+  void RunBatch(std::vector<Request>* batch);
+
+  run_fn_t run_;
+  BatchingOptions options_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Request> queue_;
+  bool stopped_{false};
+
+  std::atomic<int64_t> num_batches_{0};
+  std::atomic<int64_t> num_requests_{0};
+
+  std::thread worker_;
+};
+
+// The batch size of a request, dim 0 of the first input, or its sequences of
+// the first LoD level.
+int64_t RequestBatchSize(const std::vector<Tensor>& inputs);
+
+// Concatenate the tensors along dim 0 and merge their LoD.
+void ConcatBatch(const std::vector<const Tensor*>& xs, Tensor* out);
+
+// Split a tensor by the batch sizes, see RequestBatcher. Return false if its
+// dim 0 or LoD does not match the batch sizes.
+bool SplitBatch(const Tensor& x,
+                const std::vector<int64_t>& batch_sizes,
+                std::vector<Tensor>* res);
+
+// Create a RequestBatcher to run a Predictor or LightPredictor.
+template <typename PredictorT>
+std::unique_ptr<RequestBatcher> CreateRequestBatcher(
+    PredictorT* predictor, const BatchingOptions& options) {
+  auto run = [predictor](const std::vector<Tensor>& inputs,
+                         std::vector<Tensor>* outputs) {
+    for (size_t i = 0; i < inputs.size(); i++) {
+      predictor->GetInput(i)->ShareDataWith(inputs[i]);
+    }
+    predictor->Run();
+    *outputs = *predictor->GetOutputs();
+  };
+  return std::unique_ptr<RequestBatcher>(new RequestBatcher(run, options));
+}
+
+}  // namespace lite
+}  // namespace paddle
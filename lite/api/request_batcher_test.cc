@@ -0,0 +1,154 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/request_batcher.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+Tensor MakeTensor(const std::vector<int64_t>& shape, float start) {
+  Tensor x;
+  x.Resize(shape);
+  auto* data = x.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    data[i] = start + i;
+  }
+  return x;
+}
+
+TEST(RequestBatcher, concat_and_split_lod) {
+  // Two levels, the first request has 2 sequences of 3 rows, and the second
+  // has 1 sequence of 2 rows.
+  Tensor a = MakeTensor({3, 2}, 0);
+  a.set_lod({{0, 1, 2}, {0, 2, 3}});
+  Tensor b = MakeTensor({2, 2}, 100);
+  b.set_lod({{0, 2}, {0, 1, 2}});
+
+  Tensor merged;
+  ConcatBatch({&a, &b}, &merged);
+  ASSERT_EQ(merged.dims(), DDim(std::vector<int64_t>({5, 2})));
+  EXPECT_EQ(merged.lod(), LoD({{0, 1, 2, 4}, {0, 2, 3, 4, 5}}));
+  EXPECT_EQ(merged.data<float>()[6], 100);
+
+  std::vector<Tensor> parts;
+  ASSERT_TRUE(SplitBatch(merged, {2, 1}, &parts));
+  ASSERT_EQ(parts.size(), 2UL);
+  EXPECT_EQ(parts[0].dims(), a.dims());
+  EXPECT_EQ(parts[0].lod(), a.lod());
+  EXPECT_EQ(parts[1].dims(), b.dims());
+  EXPECT_EQ(parts[1].lod(), b.lod());
+  EXPECT_TRUE(TensorCompareWith(parts[0], a));
+  EXPECT_TRUE(TensorCompareWith(parts[1], b));
+}
+
+TEST(RequestBatcher, run) {
+  std::vector<int64_t> run_batch_sizes;
+  // out = x * 2
+  auto run = [&](const std::vector<Tensor>& inputs,
+                 std::vector<Tensor>* outputs) {
+    auto& x = inputs[0];
+    run_batch_sizes.push_back(x.dims()[0]);
+    outputs->resize(1);
+    auto& out = outputs->at(0);
+    out.Resize(x.dims());
+    auto* out_data = out.mutable_data<float>();
+    for (int64_t i = 0; i < x.numel(); i++) {
+      out_data[i] = x.data<float>()[i] * 2;
+    }
+  };
+  BatchingOptions options;
+  options.max_batch_size = 4;
+  options.max_wait_us = 100000;
+  RequestBatcher batcher(run, options);
+
+  const int num_requests = 8;
+  std::vector<std::future<std::vector<Tensor>>> futures;
+  for (int k = 0; k < num_requests; k++) {
+    std::vector<Tensor> inputs({MakeTensor({1, 3}, k * 10)});
+    futures.push_back(batcher.Submit(std::move(inputs)));
+  }
+  for (int k = 0; k < num_requests; k++) {
+    auto outputs = futures[k].get();
+    ASSERT_EQ(outputs.size(), 1UL);
+    ASSERT_EQ(outputs[0].dims(), DDim(std::vector<int64_t>({1, 3})));
+    for (int i = 0; i < 3; i++) {
+      EXPECT_EQ(outputs[0].data<float>()[i], (k * 10 + i) * 2);
+    }
+  }
+  EXPECT_EQ(batcher.num_batches(), 2);
+  EXPECT_EQ(batcher.num_requests(), num_requests);
+  EXPECT_EQ(run_batch_sizes, std::vector<int64_t>({4, 4}));
+}
+
+// The requests of different shapes are not coalesced, but the interleaved
+// requests of the same shapes are.
+TEST(RequestBatcher, incompatible) {
+  std::vector<int64_t> run_widths;
+  auto run = [&](const std::vector<Tensor>& inputs,
+                 std::vector<Tensor>* outputs) {
+    run_widths.push_back(inputs[0].dims()[1]);
+    *outputs = inputs;
+  };
+  BatchingOptions options;
+  options.max_batch_size = 2;
+  options.max_wait_us = 1000000;
+  RequestBatcher batcher(run, options);
+
+  std::vector<std::future<std::vector<Tensor>>> futures;
+  for (int k = 0; k < 4; k++) {
+    std::vector<Tensor> inputs({MakeTensor({1, k % 2 + 1}, k)});
+    futures.push_back(batcher.Submit(std::move(inputs)));
+  }
+  for (int k = 0; k < 4; k++) {
+    auto outputs = futures[k].get();
+    ASSERT_EQ(outputs[0].dims()[1], k % 2 + 1);
+    EXPECT_EQ(outputs[0].data<float>()[0], k);
+  }
+  // Every batch is run once full, without waiting for max_wait_us.
+  EXPECT_EQ(batcher.num_batches(), 2);
+  EXPECT_EQ(run_widths, std::vector<int64_t>({1, 2}));
+}
+
+// The outputs whose dim 0 is not the batch fail the requests, but not the
+// batcher.
+TEST(RequestBatcher, split_error) {
+  auto run = [](const std::vector<Tensor>& inputs,
+                std::vector<Tensor>* outputs) {
+    outputs->assign(1, MakeTensor({3}, 0));
+  };
+  BatchingOptions options;
+  options.max_batch_size = 2;
+  options.max_wait_us = 1000000;
+  RequestBatcher batcher(run, options);
+
+  std::vector<std::future<std::vector<Tensor>>> futures;
+  for (int k = 0; k < 2; k++) {
+    std::vector<Tensor> inputs({MakeTensor({1, 2}, k)});
+    futures.push_back(batcher.Submit(std::move(inputs)));
+  }
+  for (auto& future : futures) {
+    EXPECT_THROW(future.get(), std::runtime_error);
+  }
+  std::vector<Tensor> inputs({MakeTensor({3, 2}, 0)});
+  auto outputs = batcher.Submit(std::move(inputs)).get();
+  EXPECT_EQ(outputs[0].dims()[0], 3);
+}
+
+}  // namespace lite
+}  // namespace paddle
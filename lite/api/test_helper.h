@@ -17,6 +17,11 @@
 #include <gflags/gflags.h>
 #include <sys/time.h>
 #include <time.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "lite/core/tensor.h"
+#include "lite/utils/cp_logging.h"
 
 // for eval
 DEFINE_string(model_dir, "", "model dir");
@@ -26,6 +31,7 @@ DEFINE_int32(threads, 1, "threads num");
 DEFINE_int32(im_width, 224, "image width");
 DEFINE_int32(im_height, 224, "image height");
 DEFINE_bool(int8, false, "is run int8");
+DEFINE_int32(inter_op_threads, 0, "threads to run the independent ops");
 
 namespace paddle {
 namespace lite {
@@ -36,5 +42,39 @@ inline double GetCurrentUS() {
   return 1e+6 * time.tv_sec + time.tv_usec;
 }
 
+// Time a clone of `predictor` running the independent ops concurrently on
+// FLAGS_inter_op_threads threads, fed with the same input. Return the max
+// difference of its first output from the one of `predictor`, which should
+// have run with the input, or infinity if the dims differ.
+template <typename PredictorT>
+float BenchmarkInterOpThreads(PredictorT* predictor) {
+  auto parallel_predictor = predictor->Clone();
+  parallel_predictor->set_inter_op_threads(FLAGS_inter_op_threads);
+  parallel_predictor->GetInput(0)->CopyDataFrom(*predictor->GetInput(0));
+  for (int i = 0; i < FLAGS_warmup; ++i) {
+    parallel_predictor->Run();
+  }
+  auto start = GetCurrentUS();
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    parallel_predictor->Run();
+  }
+  LOG(INFO) << "inter-op threads " << FLAGS_inter_op_threads << ", spend "
+            << (GetCurrentUS() - start) / FLAGS_repeats / 1000.0
+            << " ms in average.";
+
+  const Tensor* out = predictor->GetOutput(0);
+  const Tensor* parallel_out = parallel_predictor->GetOutput(0);
+  if (out->dims() != parallel_out->dims()) {
+    return std::numeric_limits<float>::infinity();
+  }
+  float max_diff = 0.f;
+  for (int i = 0; i < out->dims().production(); ++i) {
+    max_diff = std::max(
+        max_diff,
+        std::fabs(out->data<float>()[i] - parallel_out->data<float>()[i]));
+  }
+  return max_diff;
+}
+
 }  // namespace lite
 }  // namespace paddle
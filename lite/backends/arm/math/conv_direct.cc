@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "lite/backends/arm/math/conv_direct.h"
+#include <memory>
+#include <string>
 #include "lite/backends/arm/math/conv_block_utils.h"
 #include "lite/backends/arm/math/conv_impl.h"
 
@@ -21,6 +23,33 @@ namespace lite {
 namespace arm {
 namespace math {
 
+namespace {
+
+// Transform the filter to the blocks of `cblock` output channels, shared by
+// the predictors sharing the filter.
+template <typename T>
+std::shared_ptr<const Tensor> TransWeights(const operators::ConvParam& param,
+                                           const T* w_data,
+                                           int cblock) {
+  return PackWeight(
+      param.packed_weights,
+      param.filter_name,
+      "conv_direct_c" + std::to_string(cblock),
+      [&](Tensor* weights_trans) {
+        auto w_dims = param.filter->dims();
+        int oc = w_dims[0];
+        int ic = w_dims[1];
+        int kw = w_dims[3];
+        int cround = (oc + cblock - 1) / cblock * cblock;
+        weights_trans->Resize({cround, ic, kw, kw});
+        T* transed_w_data = weights_trans->mutable_data<T>();
+        conv_trans_weights_numc(
+            w_data, transed_w_data, oc, ic, cblock, kw * kw);
+      });
+}
+
+}  // namespace
+
 template <>
 bool DirectConv<PRECISION(kFloat)>::create(const operators::ConvParam& param,
                                            ARMContext* ctx) {
@@ -42,21 +71,14 @@ bool DirectConv<PRECISION(kFloat)>::create(const operators::ConvParam& param,
     impl_ = conv_3x3s1_direct_fp32;
 
     constexpr int cblock = 4;
-    int cround = (oc + cblock - 1) / cblock * cblock;
-    weights_trans_.Resize({cround, ic, kw, kw});
-    float* transed_w_data = weights_trans_.mutable_data<float>();
-
-    conv_trans_weights_numc(w_data, transed_w_data, oc, ic, cblock, kw * kw);
+    weights_trans_ = TransWeights(param, w_data, cblock);
     is_weights_transed_ = true;
   } else if (kw == 3 && sw == 2) {
     VLOG(5) << "invoke 3x3s2 direct conv";
     impl_ = conv_3x3s2_direct_fp32;
 
     constexpr int cblock = 4;
-    int cround = (oc + cblock - 1) / cblock * cblock;
-    weights_trans_.Resize({cround, ic, kw, kw});
-    float* transed_w_data = weights_trans_.mutable_data<float>();
-    conv_trans_weights_numc(w_data, transed_w_data, oc, ic, cblock, kw * kw);
+    weights_trans_ = TransWeights(param, w_data, cblock);
     is_weights_transed_ = true;
   } else {
     LOG(ERROR) << "this type direct conv not impl";
@@ -81,7 +103,7 @@ bool DirectConv<PRECISION(kFloat)>::run(const operators::ConvParam& param) {
   auto* o_data = param.output->mutable_data<float>();
 
   if (is_weights_transed_ == true) {
-    w_data = weights_trans_.data<float>();
+    w_data = weights_trans_->data<float>();
   }
   auto x_dims = param.x->dims();
   auto w_dims = param.filter->dims();
@@ -147,10 +169,7 @@ bool DirectConvInt8<Ptype_out>::create(const operators::ConvParam& param,
 
     constexpr int cblock = 4;
     int inpad = 4;
-    int cround = (oc + cblock - 1) / cblock * cblock;
-    weights_trans_.Resize({cround, ic, kw, kw});
-    int8_t* transed_w_data = weights_trans_.mutable_data<int8_t>();
-    conv_trans_weights_numc(w_data, transed_w_data, oc, ic, cblock, kw * kw);
+    weights_trans_ = TransWeights(param, w_data, cblock);
 
     int wout_round = ((ow + 3) / 4) * 4;
     int win_round = wout_round * sw + inpad;
@@ -169,10 +188,7 @@ bool DirectConvInt8<Ptype_out>::create(const operators::ConvParam& param,
 
     // constexpr int cblock = 4;
     int cblock = conv_3x3s2_direct_int8_c_num();
-    int cround = (oc + cblock - 1) / cblock * cblock;
-    weights_trans_.Resize({cround, ic, kw, kw});
-    int8_t* transed_w_data = weights_trans_.mutable_data<int8_t>();
-    conv_trans_weights_numc(w_data, transed_w_data, oc, ic, cblock, kw * kw);
+    weights_trans_ = TransWeights(param, w_data, cblock);
     is_weights_transed_ = true;
 
   } else {
@@ -197,7 +213,7 @@ bool DirectConvInt8<Ptype_out>::run(const operators::ConvParam& param) {
   const auto* b_data = param.bias ? param.bias->data<int32_t>() : nullptr;
   auto* o_data = param.output->mutable_data<int32_t>();
   if (is_weights_transed_ == true) {
-    w_data = weights_trans_.data<int8_t>();
+    w_data = weights_trans_->data<int8_t>();
   }
   auto x_dims = param.x->dims();
   auto w_dims = param.filter->dims();
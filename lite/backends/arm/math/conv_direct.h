@@ -15,6 +15,7 @@
 #pragma once
 
 #include <cmath>
+#include <memory>
 #include <vector>
 #include "lite/backends/arm/math/conv_impl.h"
 #include "lite/core/context.h"
@@ -55,7 +56,7 @@ class DirectConv : public ImplBase<TARGET(kARM), Ptype, operators::ConvParam> {
 
  protected:
   bool is_weights_transed_{false};
-  Tensor weights_trans_;
+  std::shared_ptr<const Tensor> weights_trans_;
   Tensor _tmp_out;
 
  private:
@@ -95,7 +96,7 @@ class DirectConvInt8
 
  private:
   bool is_weights_transed_{false};
-  Tensor weights_trans_;
+  std::shared_ptr<const Tensor> weights_trans_;
   Tensor _tmp_out;
   conv_direct_int8_impl impl_int8_{nullptr};
   std::vector<float> w_scale_;
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/backends/arm/math/conv_gemmlike.h"
+#include <string>
 #include <vector>
 #include "lite/backends/arm/math/gemm_prepacked_int8.h"
 #include "lite/backends/arm/math/packed_sgemm.h"
@@ -73,27 +74,33 @@ bool GemmLikeConv<PRECISION(kFloat)>::create(const operators::ConvParam& param,
   }
 
   if (n > 1) {
-    int hblock = get_hblock(this->ctx_->arch());
-    int m_roundup = hblock * ((m + hblock - 1) / hblock);
-    int group_size_round_up = ((m_roundup * k + 15) / 16) * 16;
-    float* w_trans_ptr = nullptr;
-    weights_trans_.Resize({1, 1, 1, group_size_round_up * param.groups});
-    w_trans_ptr = weights_trans_.mutable_data<float>();
-    const auto* w_data = param.filter->data<float>();
-    for (int g = 0; g < param.groups; ++g) {
-      const float* weights_group = w_data + g * m * k;
-      float* weights_trans_ptr = w_trans_ptr + g * group_size_round_up;
-      prepackA(weights_trans_ptr,
-               weights_group,
-               1.f,
-               k,
-               0,
-               m,
-               0,
-               k,
-               false,
-               this->ctx_);
-    }
+    // The packed weights are shared by the predictors sharing the filter.
+    weights_trans_ = PackWeight(
+        param.packed_weights,
+        param.filter_name,
+        "conv_gemm_g" + std::to_string(param.groups),
+        [&](Tensor* weights_trans) {
+          int hblock = get_hblock(this->ctx_->arch());
+          int m_roundup = hblock * ((m + hblock - 1) / hblock);
+          int group_size_round_up = ((m_roundup * k + 15) / 16) * 16;
+          weights_trans->Resize({1, 1, 1, group_size_round_up * param.groups});
+          float* w_trans_ptr = weights_trans->mutable_data<float>();
+          const auto* w_data = param.filter->data<float>();
+          for (int g = 0; g < param.groups; ++g) {
+            const float* weights_group = w_data + g * m * k;
+            float* weights_trans_ptr = w_trans_ptr + g * group_size_round_up;
+            prepackA(weights_trans_ptr,
+                     weights_group,
+                     1.f,
+                     k,
+                     0,
+                     m,
+                     0,
+                     k,
+                     false,
+                     this->ctx_);
+          }
+        });
     is_weights_transed_ = true;
   }
   return true;
@@ -116,7 +123,7 @@ bool GemmLikeConv<PRECISION(kFloat)>::run(const operators::ConvParam& param) {
   const int* idx_data = idx_data_.mutable_data<int>();
 
   if (is_weights_transed_) {
-    w_data = weights_trans_.data<float>();
+    w_data = weights_trans_->data<float>();
   }
   auto x_dims = param.x->dims();
   auto w_dims = param.filter->dims();
@@ -213,13 +220,15 @@ bool GemmLikeConvInt8<Ptype_out>::create(const operators::ConvParam& param,
   }
 
   if (n > 1) {
-    prepackA_int8(&this->weights_trans_,
-                  *param.filter,
-                  m,
-                  k,
-                  param.groups,
-                  false,
-                  this->ctx_);
+    // The packed weights are shared by the predictors sharing the filter.
+    this->weights_trans_ = PackWeight(
+        param.packed_weights,
+        param.filter_name,
+        "conv_gemm_g" + std::to_string(param.groups),
+        [&](Tensor* weights_trans) {
+          prepackA_int8(
+              weights_trans, *param.filter, m, k, param.groups, false, ctx);
+        });
     this->is_weights_transed_ = true;
   }
   return true;
@@ -241,7 +250,7 @@ bool GemmLikeConvInt8<Ptype_out>::run(const operators::ConvParam& param) {
   const int32_t* idx_data = idx_data_.mutable_data<int32_t>();
 
   if (this->is_weights_transed_ == true) {
-    w_data = this->weights_trans_.template data<int8_t>();
+    w_data = this->weights_trans_->template data<int8_t>();
   }
   auto x_dims = param.x->dims();
   auto w_dims = param.filter->dims();
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <cmath>
+#include <memory>
 #include <vector>
 #include "lite/backends/arm/math/conv_impl.h"
 #include "lite/core/context.h"
@@ -62,7 +63,7 @@ class GemmLikeConv
  protected:
   bool is_weights_transed_{false};
   Tensor idx_data_;
-  Tensor weights_trans_;
+  std::shared_ptr<const Tensor> weights_trans_;
 
  private:
   conv_im2col_gemm_impl impl_{nullptr};
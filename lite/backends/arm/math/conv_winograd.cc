@@ -49,37 +49,41 @@ bool WinogradConv<PRECISION(kFloat)>::create(const operators::ConvParam& param,
     const int n_wino = size_tile;
     int hblock = get_hblock(this->ctx_->arch());
     int m_round = hblock * ((m_wino + hblock - 1) / hblock);
-    weights_trans_.Resize({1, 1, 1, 8 * 8 * m_round * ic});
     this->ctx_->ExtendWorkspace((size_trans_channel * max_ch * 2 + n_wino) *
                                 sizeof(float));
-    auto weights_wino =
-        static_cast<float*>(malloc(sizeof(float) * 8 * 8 * oc * ic));
-    void* trans_tmp_ptr = malloc(sizeof(float) * 8 * 8 * oc * ic);
-    if (weights_wino && trans_tmp_ptr) {
-      winograd_transform_weights(
-          weights_wino, param.filter->data<float>(), oc, ic, trans_tmp_ptr);
-      auto weights_trans = weights_trans_.mutable_data<float>();
-      for (int i = 0; i < 64; ++i) {
-        float* packed_weights = weights_trans + i * m_round * ic;
-        const float* weights_wino_ptr = weights_wino + i * oc * ic;
-        prepackA(packed_weights,
-                 weights_wino_ptr,
-                 1.f,
-                 ic,
-                 0,
-                 m_wino,
-                 0,
-                 ic,
-                 false,
-                 this->ctx_);
-      }
-      impl_ = conv_winograd3x3;
-      free(trans_tmp_ptr);
-      free(weights_wino);
-      return true;
-    }
-    free(trans_tmp_ptr);
-    free(weights_wino);
+    // The transformed weights are shared by the predictors sharing the filter.
+    weights_trans_ = PackWeight(
+        param.packed_weights,
+        param.filter_name,
+        "conv_winograd",
+        [&](Tensor* weights_trans) {
+          weights_trans->Resize({1, 1, 1, 8 * 8 * m_round * ic});
+          auto weights_wino =
+              static_cast<float*>(malloc(sizeof(float) * 8 * 8 * oc * ic));
+          void* trans_tmp_ptr = malloc(sizeof(float) * 8 * 8 * oc * ic);
+          CHECK(weights_wino && trans_tmp_ptr);
+          winograd_transform_weights(
+              weights_wino, param.filter->data<float>(), oc, ic, trans_tmp_ptr);
+          auto weights_trans_data = weights_trans->mutable_data<float>();
+          for (int i = 0; i < 64; ++i) {
+            float* packed_weights = weights_trans_data + i * m_round * ic;
+            const float* weights_wino_ptr = weights_wino + i * oc * ic;
+            prepackA(packed_weights,
+                     weights_wino_ptr,
+                     1.f,
+                     ic,
+                     0,
+                     m_wino,
+                     0,
+                     ic,
+                     false,
+                     this->ctx_);
+          }
+          free(trans_tmp_ptr);
+          free(weights_wino);
+        });
+    impl_ = conv_winograd3x3;
+    return true;
   } else {
     LOG(ERROR) << "this type winograd conv not impl";
   }
@@ -102,7 +106,7 @@ bool WinogradConv<PRECISION(kFloat)>::run(const operators::ConvParam& param) {
   auto* o_data = param.output->mutable_data<float>();
 
   if (is_weights_transed_) {
-    w_data = weights_trans_.data<float>();
+    w_data = weights_trans_->data<float>();
   }
 
   auto x_dims = param.x->dims();
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <cmath>
+#include <memory>
 #include "lite/backends/arm/math/conv_impl.h"
 #include "lite/core/context.h"
 #include "lite/core/target_wrapper.h"
@@ -56,7 +57,7 @@ class WinogradConv
  private:
   conv_winograd_impl impl_{nullptr};
   bool is_weights_transed_{false};
-  Tensor weights_trans_;
+  std::shared_ptr<const Tensor> weights_trans_;
 };
 
 }  // namespace math
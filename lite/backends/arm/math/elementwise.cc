@@ -15,6 +15,7 @@
 #include "lite/backends/arm/math/elementwise.h"
 #include <algorithm>
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
@@ -28,8 +29,7 @@ void elementwise_add<float>(const float* dinx,
                             int num) {
   int cnt = num >> 4;
   int remain = num % 16;
-#pragma omp parallel for
-  for (int i = 0; i < cnt; i++) {
+  LITE_PARALLEL_BEGIN(i, tid, cnt) {
     const float* dinx_ptr = dinx + (i << 4);
     const float* diny_ptr = diny + (i << 4);
     float* dout_ptr = dout + (i << 4);
@@ -54,6 +54,7 @@ void elementwise_add<float>(const float* dinx,
     vst1q_f32(dout_ptr + 8, dinx2);
     vst1q_f32(dout_ptr + 12, dinx3);
   }
+  LITE_PARALLEL_END();
   if (remain > 0) {
     const float* dinx_ptr = dinx + (cnt << 4);
     const float* diny_ptr = diny + (cnt << 4);
@@ -75,8 +76,7 @@ void elementwise_add_relu<float>(const float* dinx,
   int cnt = num >> 4;
   int remain = num % 16;
   float32x4_t vzero = vdupq_n_f32(0.f);
-#pragma omp parallel for
-  for (int i = 0; i < cnt; i++) {
+  LITE_PARALLEL_BEGIN(i, tid, cnt) {
     const float* dinx_ptr = dinx + (i << 4);
     const float* diny_ptr = diny + (i << 4);
     float* dout_ptr = dout + (i << 4);
@@ -107,6 +107,7 @@ void elementwise_add_relu<float>(const float* dinx,
     vst1q_f32(dout_ptr + 8, dinx2);
     vst1q_f32(dout_ptr + 12, dinx3);
   }
+  LITE_PARALLEL_END();
   if (remain > 0) {
     const float* dinx_ptr = dinx + (cnt << 4);
     const float* diny_ptr = diny + (cnt << 4);
@@ -128,63 +129,63 @@ void elementwise_add_broadcast<float>(const float* dinx,
                                       int batch,
                                       int channels,
                                       int num) {
-#pragma omp parallel for collapse(2)
-  for (int i = 0; i < batch; ++i) {
-    for (int j = 0; j < channels; ++j) {
-      int offset = (i * channels + j) * num;
-      const float* din_ptr = dinx + offset;
-      const float diny_data = diny[j];
-      float* dout_ptr = dout + offset;
-
-      int cnt = num >> 4;
-      int remain = num % 16;
-      float32x4_t rb = vdupq_n_f32(diny_data);
-      for (int k = 0; k < cnt; ++k) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        float32x4_t din1 = vld1q_f32(din_ptr + 4);
-        float32x4_t din2 = vld1q_f32(din_ptr + 8);
-        float32x4_t din3 = vld1q_f32(din_ptr + 12);
-
-        din0 = vaddq_f32(din0, rb);
-        din1 = vaddq_f32(din1, rb);
-        din2 = vaddq_f32(din2, rb);
-        din3 = vaddq_f32(din3, rb);
-
-        vst1q_f32(dout_ptr, din0);
-        vst1q_f32(dout_ptr + 4, din1);
-        vst1q_f32(dout_ptr + 8, din2);
-        vst1q_f32(dout_ptr + 12, din3);
-        din_ptr += 16;
-        dout_ptr += 16;
-      }
-      if (remain >= 8) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        float32x4_t din1 = vld1q_f32(din_ptr + 4);
-        din0 = vaddq_f32(din0, rb);
-        din1 = vaddq_f32(din1, rb);
-        vst1q_f32(dout_ptr, din0);
-        vst1q_f32(dout_ptr + 4, din1);
-        din_ptr += 8;
-        dout_ptr += 8;
-        remain -= 8;
-      }
-      if (remain >= 4) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        din0 = vaddq_f32(din0, rb);
-        vst1q_f32(dout_ptr, din0);
-        din_ptr += 4;
-        dout_ptr += 4;
-        remain -= 4;
-      }
-      if (remain > 0) {
-        for (int p = 0; p < remain; p++) {
-          *dout_ptr = *din_ptr + diny_data;
-          dout_ptr++;
-          din_ptr++;
-        }
+  LITE_PARALLEL_BEGIN(i_j, tid, batch * channels) {
+    int i = i_j / channels;
+    int j = i_j % channels;
+    int offset = (i * channels + j) * num;
+    const float* din_ptr = dinx + offset;
+    const float diny_data = diny[j];
+    float* dout_ptr = dout + offset;
+
+    int cnt = num >> 4;
+    int remain = num % 16;
+    float32x4_t rb = vdupq_n_f32(diny_data);
+    for (int k = 0; k < cnt; ++k) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      float32x4_t din1 = vld1q_f32(din_ptr + 4);
+      float32x4_t din2 = vld1q_f32(din_ptr + 8);
+      float32x4_t din3 = vld1q_f32(din_ptr + 12);
+
+      din0 = vaddq_f32(din0, rb);
+      din1 = vaddq_f32(din1, rb);
+      din2 = vaddq_f32(din2, rb);
+      din3 = vaddq_f32(din3, rb);
+
+      vst1q_f32(dout_ptr, din0);
+      vst1q_f32(dout_ptr + 4, din1);
+      vst1q_f32(dout_ptr + 8, din2);
+      vst1q_f32(dout_ptr + 12, din3);
+      din_ptr += 16;
+      dout_ptr += 16;
+    }
+    if (remain >= 8) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      float32x4_t din1 = vld1q_f32(din_ptr + 4);
+      din0 = vaddq_f32(din0, rb);
+      din1 = vaddq_f32(din1, rb);
+      vst1q_f32(dout_ptr, din0);
+      vst1q_f32(dout_ptr + 4, din1);
+      din_ptr += 8;
+      dout_ptr += 8;
+      remain -= 8;
+    }
+    if (remain >= 4) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      din0 = vaddq_f32(din0, rb);
+      vst1q_f32(dout_ptr, din0);
+      din_ptr += 4;
+      dout_ptr += 4;
+      remain -= 4;
+    }
+    if (remain > 0) {
+      for (int p = 0; p < remain; p++) {
+        *dout_ptr = *din_ptr + diny_data;
+        dout_ptr++;
+        din_ptr++;
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 template <>
@@ -195,75 +196,75 @@ void elementwise_add_relu_broadcast<float>(const float* dinx,
                                            int channels,
                                            int num) {
   float32x4_t vzero = vdupq_n_f32(0.f);
-#pragma omp parallel for collapse(2)
-  for (int i = 0; i < batch; ++i) {
-    for (int j = 0; j < channels; ++j) {
-      int offset = (i * channels + j) * num;
-      const float* din_ptr = dinx + offset;
-      const float diny_data = diny[j];
-      float* dout_ptr = dout + offset;
-
-      int cnt = num >> 4;
-      int remain = num % 16;
-      float32x4_t rb = vdupq_n_f32(diny_data);
-      for (int k = 0; k < cnt; ++k) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        float32x4_t din1 = vld1q_f32(din_ptr + 4);
-        float32x4_t din2 = vld1q_f32(din_ptr + 8);
-        float32x4_t din3 = vld1q_f32(din_ptr + 12);
-
-        din0 = vaddq_f32(din0, rb);
-        din1 = vaddq_f32(din1, rb);
-        din2 = vaddq_f32(din2, rb);
-        din3 = vaddq_f32(din3, rb);
-
-        // relu
-        din0 = vmaxq_f32(din0, vzero);
-        din1 = vmaxq_f32(din1, vzero);
-        din2 = vmaxq_f32(din2, vzero);
-        din3 = vmaxq_f32(din3, vzero);
-
-        vst1q_f32(dout_ptr, din0);
-        vst1q_f32(dout_ptr + 4, din1);
-        vst1q_f32(dout_ptr + 8, din2);
-        vst1q_f32(dout_ptr + 12, din3);
-        din_ptr += 16;
-        dout_ptr += 16;
-      }
-      if (remain >= 8) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        float32x4_t din1 = vld1q_f32(din_ptr + 4);
-        din0 = vaddq_f32(din0, rb);
-        din1 = vaddq_f32(din1, rb);
-        // relu
-        din0 = vmaxq_f32(din0, vzero);
-        din1 = vmaxq_f32(din1, vzero);
-        vst1q_f32(dout_ptr, din0);
-        vst1q_f32(dout_ptr + 4, din1);
-        din_ptr += 8;
-        dout_ptr += 8;
-        remain -= 8;
-      }
-      if (remain >= 4) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        din0 = vaddq_f32(din0, rb);
-        // relu
-        din0 = vmaxq_f32(din0, vzero);
-        vst1q_f32(dout_ptr, din0);
-        din_ptr += 4;
-        dout_ptr += 4;
-        remain -= 4;
-      }
-      if (remain > 0) {
-        for (int p = 0; p < remain; p++) {
-          float tmp = *din_ptr + diny_data;
-          *dout_ptr = tmp > 0.f ? tmp : 0.f;
-          dout_ptr++;
-          din_ptr++;
-        }
+  LITE_PARALLEL_BEGIN(i_j, tid, batch * channels) {
+    int i = i_j / channels;
+    int j = i_j % channels;
+    int offset = (i * channels + j) * num;
+    const float* din_ptr = dinx + offset;
+    const float diny_data = diny[j];
+    float* dout_ptr = dout + offset;
+
+    int cnt = num >> 4;
+    int remain = num % 16;
+    float32x4_t rb = vdupq_n_f32(diny_data);
+    for (int k = 0; k < cnt; ++k) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      float32x4_t din1 = vld1q_f32(din_ptr + 4);
+      float32x4_t din2 = vld1q_f32(din_ptr + 8);
+      float32x4_t din3 = vld1q_f32(din_ptr + 12);
+
+      din0 = vaddq_f32(din0, rb);
+      din1 = vaddq_f32(din1, rb);
+      din2 = vaddq_f32(din2, rb);
+      din3 = vaddq_f32(din3, rb);
+
+      // relu
+      din0 = vmaxq_f32(din0, vzero);
+      din1 = vmaxq_f32(din1, vzero);
+      din2 = vmaxq_f32(din2, vzero);
+      din3 = vmaxq_f32(din3, vzero);
+
+      vst1q_f32(dout_ptr, din0);
+      vst1q_f32(dout_ptr + 4, din1);
+      vst1q_f32(dout_ptr + 8, din2);
+      vst1q_f32(dout_ptr + 12, din3);
+      din_ptr += 16;
+      dout_ptr += 16;
+    }
+    if (remain >= 8) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      float32x4_t din1 = vld1q_f32(din_ptr + 4);
+      din0 = vaddq_f32(din0, rb);
+      din1 = vaddq_f32(din1, rb);
+      // relu
+      din0 = vmaxq_f32(din0, vzero);
+      din1 = vmaxq_f32(din1, vzero);
+      vst1q_f32(dout_ptr, din0);
+      vst1q_f32(dout_ptr + 4, din1);
+      din_ptr += 8;
+      dout_ptr += 8;
+      remain -= 8;
+    }
+    if (remain >= 4) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      din0 = vaddq_f32(din0, rb);
+      // relu
+      din0 = vmaxq_f32(din0, vzero);
+      vst1q_f32(dout_ptr, din0);
+      din_ptr += 4;
+      dout_ptr += 4;
+      remain -= 4;
+    }
+    if (remain > 0) {
+      for (int p = 0; p < remain; p++) {
+        float tmp = *din_ptr + diny_data;
+        *dout_ptr = tmp > 0.f ? tmp : 0.f;
+        dout_ptr++;
+        din_ptr++;
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 template <>
@@ -273,8 +274,7 @@ void elementwise_mul<float>(const float* dinx,
                             int num) {
   int cnt = num >> 4;
   int remain = num % 16;
-#pragma omp parallel for
-  for (int i = 0; i < cnt; ++i) {
+  LITE_PARALLEL_BEGIN(i, tid, cnt) {
     const float* dinx_ptr = dinx + (i << 4);
     const float* diny_ptr = diny + (i << 4);
     float* dout_ptr = dout + (i << 4);
@@ -299,6 +299,7 @@ void elementwise_mul<float>(const float* dinx,
     vst1q_f32(dout_ptr + 8, dinx2);
     vst1q_f32(dout_ptr + 12, dinx3);
   }
+  LITE_PARALLEL_END();
   if (remain > 0) {
     const float* dinx_ptr = dinx + (cnt << 4);
     const float* diny_ptr = diny + (cnt << 4);
@@ -320,8 +321,7 @@ void elementwise_mul_relu<float>(const float* dinx,
   int cnt = num >> 4;
   int remain = num % 16;
   float32x4_t vzero = vdupq_n_f32(0.f);
-#pragma omp parallel for
-  for (int i = 0; i < cnt; ++i) {
+  LITE_PARALLEL_BEGIN(i, tid, cnt) {
     const float* dinx_ptr = dinx + (i << 4);
     const float* diny_ptr = diny + (i << 4);
     float* dout_ptr = dout + (i << 4);
@@ -352,6 +352,7 @@ void elementwise_mul_relu<float>(const float* dinx,
     vst1q_f32(dout_ptr + 8, dinx2);
     vst1q_f32(dout_ptr + 12, dinx3);
   }
+  LITE_PARALLEL_END();
   if (remain > 0) {
     const float* dinx_ptr = dinx + (cnt << 4);
     const float* diny_ptr = diny + (cnt << 4);
@@ -373,64 +374,64 @@ void elementwise_mul_broadcast<float>(const float* dinx,
                                       int batch,
                                       int channels,
                                       int num) {
-#pragma omp parallel for collapse(2)
-  for (int i = 0; i < batch; ++i) {
-    for (int j = 0; j < channels; ++j) {
-      int offset = (i * channels + j) * num;
-      const float* din_ptr = dinx + offset;
-      const float diny_data = diny[j];
-      float* dout_ptr = dout + offset;
-
-      int cnt = num >> 4;
-      int remain = num % 16;
-      float32x4_t rb = vdupq_n_f32(diny_data);
-      for (int k = 0; k < cnt; ++k) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        float32x4_t din1 = vld1q_f32(din_ptr + 4);
-        float32x4_t din2 = vld1q_f32(din_ptr + 8);
-        float32x4_t din3 = vld1q_f32(din_ptr + 12);
-
-        din0 = vmulq_f32(din0, rb);
-        din1 = vmulq_f32(din1, rb);
-        din2 = vmulq_f32(din2, rb);
-        din3 = vmulq_f32(din3, rb);
-
-        vst1q_f32(dout_ptr, din0);
-        vst1q_f32(dout_ptr + 4, din1);
-        vst1q_f32(dout_ptr + 8, din2);
-        vst1q_f32(dout_ptr + 12, din3);
-
-        din_ptr += 16;
-        dout_ptr += 16;
-      }
-      if (remain >= 8) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        float32x4_t din1 = vld1q_f32(din_ptr + 4);
-        din0 = vmulq_f32(din0, rb);
-        din1 = vmulq_f32(din1, rb);
-        vst1q_f32(dout_ptr, din0);
-        vst1q_f32(dout_ptr + 4, din1);
-        din_ptr += 8;
-        dout_ptr += 8;
-        remain -= 8;
-      }
-      if (remain >= 4) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        din0 = vmulq_f32(din0, rb);
-        vst1q_f32(dout_ptr, din0);
-        din_ptr += 4;
-        dout_ptr += 4;
-        remain -= 4;
-      }
-      if (remain > 0) {
-        for (int p = 0; p < remain; ++p) {
-          *dout_ptr = *din_ptr * diny_data;
-          dout_ptr++;
-          din_ptr++;
-        }
+  LITE_PARALLEL_BEGIN(i_j, tid, batch * channels) {
+    int i = i_j / channels;
+    int j = i_j % channels;
+    int offset = (i * channels + j) * num;
+    const float* din_ptr = dinx + offset;
+    const float diny_data = diny[j];
+    float* dout_ptr = dout + offset;
+
+    int cnt = num >> 4;
+    int remain = num % 16;
+    float32x4_t rb = vdupq_n_f32(diny_data);
+    for (int k = 0; k < cnt; ++k) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      float32x4_t din1 = vld1q_f32(din_ptr + 4);
+      float32x4_t din2 = vld1q_f32(din_ptr + 8);
+      float32x4_t din3 = vld1q_f32(din_ptr + 12);
+
+      din0 = vmulq_f32(din0, rb);
+      din1 = vmulq_f32(din1, rb);
+      din2 = vmulq_f32(din2, rb);
+      din3 = vmulq_f32(din3, rb);
+
+      vst1q_f32(dout_ptr, din0);
+      vst1q_f32(dout_ptr + 4, din1);
+      vst1q_f32(dout_ptr + 8, din2);
+      vst1q_f32(dout_ptr + 12, din3);
+
+      din_ptr += 16;
+      dout_ptr += 16;
+    }
+    if (remain >= 8) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      float32x4_t din1 = vld1q_f32(din_ptr + 4);
+      din0 = vmulq_f32(din0, rb);
+      din1 = vmulq_f32(din1, rb);
+      vst1q_f32(dout_ptr, din0);
+      vst1q_f32(dout_ptr + 4, din1);
+      din_ptr += 8;
+      dout_ptr += 8;
+      remain -= 8;
+    }
+    if (remain >= 4) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      din0 = vmulq_f32(din0, rb);
+      vst1q_f32(dout_ptr, din0);
+      din_ptr += 4;
+      dout_ptr += 4;
+      remain -= 4;
+    }
+    if (remain > 0) {
+      for (int p = 0; p < remain; ++p) {
+        *dout_ptr = *din_ptr * diny_data;
+        dout_ptr++;
+        din_ptr++;
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 template <>
@@ -441,75 +442,75 @@ void elementwise_mul_relu_broadcast<float>(const float* dinx,
                                            int channels,
                                            int num) {
   float32x4_t vzero = vdupq_n_f32(0.f);
-#pragma omp parallel for collapse(2)
-  for (int i = 0; i < batch; ++i) {
-    for (int j = 0; j < channels; ++j) {
-      int offset = (i * channels + j) * num;
-      const float* din_ptr = dinx + offset;
-      const float diny_data = diny[j];
-      float* dout_ptr = dout + offset;
-
-      int cnt = num >> 4;
-      int remain = num % 16;
-      float32x4_t rb = vdupq_n_f32(diny_data);
-      for (int k = 0; k < cnt; ++k) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        float32x4_t din1 = vld1q_f32(din_ptr + 4);
-        float32x4_t din2 = vld1q_f32(din_ptr + 8);
-        float32x4_t din3 = vld1q_f32(din_ptr + 12);
-
-        din0 = vmulq_f32(din0, rb);
-        din1 = vmulq_f32(din1, rb);
-        din2 = vmulq_f32(din2, rb);
-        din3 = vmulq_f32(din3, rb);
-
-        // relu
-        din0 = vmaxq_f32(din0, vzero);
-        din1 = vmaxq_f32(din1, vzero);
-        din2 = vmaxq_f32(din2, vzero);
-        din3 = vmaxq_f32(din3, vzero);
-
-        vst1q_f32(dout_ptr, din0);
-        vst1q_f32(dout_ptr + 4, din1);
-        vst1q_f32(dout_ptr + 8, din2);
-        vst1q_f32(dout_ptr + 12, din3);
-        din_ptr += 16;
-        dout_ptr += 16;
-      }
-      if (remain >= 8) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        float32x4_t din1 = vld1q_f32(din_ptr + 4);
-        din0 = vmulq_f32(din0, rb);
-        din1 = vmulq_f32(din1, rb);
-        // relu
-        din0 = vmaxq_f32(din0, vzero);
-        din1 = vmaxq_f32(din1, vzero);
-        vst1q_f32(dout_ptr, din0);
-        vst1q_f32(dout_ptr + 4, din1);
-        din_ptr += 8;
-        dout_ptr += 8;
-        remain -= 8;
-      }
-      if (remain >= 4) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        din0 = vmulq_f32(din0, rb);
-        // relu
-        din0 = vmaxq_f32(din0, vzero);
-        vst1q_f32(dout_ptr, din0);
-        din_ptr += 4;
-        dout_ptr += 4;
-        remain -= 4;
-      }
-      if (remain > 0) {
-        for (int p = 0; p < remain; ++p) {
-          float tmp = *din_ptr * diny_data;
-          *dout_ptr = tmp > 0.f ? tmp : 0.f;
-          dout_ptr++;
-          din_ptr++;
-        }
+  LITE_PARALLEL_BEGIN(i_j, tid, batch * channels) {
+    int i = i_j / channels;
+    int j = i_j % channels;
+    int offset = (i * channels + j) * num;
+    const float* din_ptr = dinx + offset;
+    const float diny_data = diny[j];
+    float* dout_ptr = dout + offset;
+
+    int cnt = num >> 4;
+    int remain = num % 16;
+    float32x4_t rb = vdupq_n_f32(diny_data);
+    for (int k = 0; k < cnt; ++k) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      float32x4_t din1 = vld1q_f32(din_ptr + 4);
+      float32x4_t din2 = vld1q_f32(din_ptr + 8);
+      float32x4_t din3 = vld1q_f32(din_ptr + 12);
+
+      din0 = vmulq_f32(din0, rb);
+      din1 = vmulq_f32(din1, rb);
+      din2 = vmulq_f32(din2, rb);
+      din3 = vmulq_f32(din3, rb);
+
+      // relu
+      din0 = vmaxq_f32(din0, vzero);
+      din1 = vmaxq_f32(din1, vzero);
+      din2 = vmaxq_f32(din2, vzero);
+      din3 = vmaxq_f32(din3, vzero);
+
+      vst1q_f32(dout_ptr, din0);
+      vst1q_f32(dout_ptr + 4, din1);
+      vst1q_f32(dout_ptr + 8, din2);
+      vst1q_f32(dout_ptr + 12, din3);
+      din_ptr += 16;
+      dout_ptr += 16;
+    }
+    if (remain >= 8) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      float32x4_t din1 = vld1q_f32(din_ptr + 4);
+      din0 = vmulq_f32(din0, rb);
+      din1 = vmulq_f32(din1, rb);
+      // relu
+      din0 = vmaxq_f32(din0, vzero);
+      din1 = vmaxq_f32(din1, vzero);
+      vst1q_f32(dout_ptr, din0);
+      vst1q_f32(dout_ptr + 4, din1);
+      din_ptr += 8;
+      dout_ptr += 8;
+      remain -= 8;
+    }
+    if (remain >= 4) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      din0 = vmulq_f32(din0, rb);
+      // relu
+      din0 = vmaxq_f32(din0, vzero);
+      vst1q_f32(dout_ptr, din0);
+      din_ptr += 4;
+      dout_ptr += 4;
+      remain -= 4;
+    }
+    if (remain > 0) {
+      for (int p = 0; p < remain; ++p) {
+        float tmp = *din_ptr * diny_data;
+        *dout_ptr = tmp > 0.f ? tmp : 0.f;
+        dout_ptr++;
+        din_ptr++;
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 template <>
@@ -519,8 +520,7 @@ void elementwise_max<float>(const float* dinx,
                             int num) {
   int cnt = num >> 4;
   int remain = num % 16;
-#pragma omp parallel for
-  for (int i = 0; i < cnt; ++i) {
+  LITE_PARALLEL_BEGIN(i, tid, cnt) {
     const float* dinx_ptr = dinx + (i << 4);
     const float* diny_ptr = diny + (i << 4);
     float* dout_ptr = dout + (i << 4);
@@ -545,6 +545,7 @@ void elementwise_max<float>(const float* dinx,
     vst1q_f32(dout_ptr + 8, dinx2);
     vst1q_f32(dout_ptr + 12, dinx3);
   }
+  LITE_PARALLEL_END();
   if (remain > 0) {
     const float* dinx_ptr = dinx + (cnt << 4);
     const float* diny_ptr = diny + (cnt << 4);
@@ -563,8 +564,7 @@ void elementwise_max_relu<float>(const float* dinx,
   int cnt = num >> 4;
   int remain = num % 16;
   float32x4_t vzero = vdupq_n_f32(0.f);
-#pragma omp parallel for
-  for (int i = 0; i < cnt; ++i) {
+  LITE_PARALLEL_BEGIN(i, tid, cnt) {
     const float* dinx_ptr = dinx + (i << 4);
     const float* diny_ptr = diny + (i << 4);
     float* dout_ptr = dout + (i << 4);
@@ -595,6 +595,7 @@ void elementwise_max_relu<float>(const float* dinx,
     vst1q_f32(dout_ptr + 8, dinx2);
     vst1q_f32(dout_ptr + 12, dinx3);
   }
+  LITE_PARALLEL_END();
   if (remain > 0) {
     const float* dinx_ptr = dinx + (cnt << 4);
     const float* diny_ptr = diny + (cnt << 4);
@@ -613,64 +614,64 @@ void elementwise_max_broadcast<float>(const float* dinx,
                                       int batch,
                                       int channels,
                                       int num) {
-#pragma omp parallel for collapse(2)
-  for (int i = 0; i < batch; ++i) {
-    for (int j = 0; j < channels; ++j) {
-      int offset = (i * channels + j) * num;
-      const float* din_ptr = dinx + offset;
-      const float diny_data = diny[j];
-      float* dout_ptr = dout + offset;
-
-      int cnt = num >> 4;
-      int remain = num % 16;
-      float32x4_t rb = vdupq_n_f32(diny_data);
-      for (int k = 0; k < cnt; ++k) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        float32x4_t din1 = vld1q_f32(din_ptr + 4);
-        float32x4_t din2 = vld1q_f32(din_ptr + 8);
-        float32x4_t din3 = vld1q_f32(din_ptr + 12);
-
-        din0 = vmaxq_f32(din0, rb);
-        din1 = vmaxq_f32(din1, rb);
-        din2 = vmaxq_f32(din2, rb);
-        din3 = vmaxq_f32(din3, rb);
-
-        vst1q_f32(dout_ptr, din0);
-        vst1q_f32(dout_ptr + 4, din1);
-        vst1q_f32(dout_ptr + 8, din2);
-        vst1q_f32(dout_ptr + 12, din3);
-
-        din_ptr += 16;
-        dout_ptr += 16;
-      }
-      if (remain >= 8) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        float32x4_t din1 = vld1q_f32(din_ptr + 4);
-        din0 = vmaxq_f32(din0, rb);
-        din1 = vmaxq_f32(din1, rb);
-        vst1q_f32(dout_ptr, din0);
-        vst1q_f32(dout_ptr + 4, din1);
-        din_ptr += 8;
-        dout_ptr += 8;
-        remain -= 8;
-      }
-      if (remain >= 4) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        din0 = vmaxq_f32(din0, rb);
-        vst1q_f32(dout_ptr, din0);
-        din_ptr += 4;
-        dout_ptr += 4;
-        remain -= 4;
-      }
-      if (remain > 0) {
-        for (int p = 0; p < remain; ++p) {
-          *dout_ptr = std::max(*din_ptr, diny_data);
-          dout_ptr++;
-          din_ptr++;
-        }
+  LITE_PARALLEL_BEGIN(i_j, tid, batch * channels) {
+    int i = i_j / channels;
+    int j = i_j % channels;
+    int offset = (i * channels + j) * num;
+    const float* din_ptr = dinx + offset;
+    const float diny_data = diny[j];
+    float* dout_ptr = dout + offset;
+
+    int cnt = num >> 4;
+    int remain = num % 16;
+    float32x4_t rb = vdupq_n_f32(diny_data);
+    for (int k = 0; k < cnt; ++k) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      float32x4_t din1 = vld1q_f32(din_ptr + 4);
+      float32x4_t din2 = vld1q_f32(din_ptr + 8);
+      float32x4_t din3 = vld1q_f32(din_ptr + 12);
+
+      din0 = vmaxq_f32(din0, rb);
+      din1 = vmaxq_f32(din1, rb);
+      din2 = vmaxq_f32(din2, rb);
+      din3 = vmaxq_f32(din3, rb);
+
+      vst1q_f32(dout_ptr, din0);
+      vst1q_f32(dout_ptr + 4, din1);
+      vst1q_f32(dout_ptr + 8, din2);
+      vst1q_f32(dout_ptr + 12, din3);
+
+      din_ptr += 16;
+      dout_ptr += 16;
+    }
+    if (remain >= 8) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      float32x4_t din1 = vld1q_f32(din_ptr + 4);
+      din0 = vmaxq_f32(din0, rb);
+      din1 = vmaxq_f32(din1, rb);
+      vst1q_f32(dout_ptr, din0);
+      vst1q_f32(dout_ptr + 4, din1);
+      din_ptr += 8;
+      dout_ptr += 8;
+      remain -= 8;
+    }
+    if (remain >= 4) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      din0 = vmaxq_f32(din0, rb);
+      vst1q_f32(dout_ptr, din0);
+      din_ptr += 4;
+      dout_ptr += 4;
+      remain -= 4;
+    }
+    if (remain > 0) {
+      for (int p = 0; p < remain; ++p) {
+        *dout_ptr = std::max(*din_ptr, diny_data);
+        dout_ptr++;
+        din_ptr++;
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 template <>
@@ -681,75 +682,75 @@ void elementwise_max_relu_broadcast<float>(const float* dinx,
                                            int channels,
                                            int num) {
   float32x4_t vzero = vdupq_n_f32(0.f);
-#pragma omp parallel for collapse(2)
-  for (int i = 0; i < batch; ++i) {
-    for (int j = 0; j < channels; ++j) {
-      int offset = (i * channels + j) * num;
-      const float* din_ptr = dinx + offset;
-      const float diny_data = diny[j];
-      float* dout_ptr = dout + offset;
-
-      int cnt = num >> 4;
-      int remain = num % 16;
-      float32x4_t rb = vdupq_n_f32(diny_data);
-      for (int k = 0; k < cnt; ++k) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        float32x4_t din1 = vld1q_f32(din_ptr + 4);
-        float32x4_t din2 = vld1q_f32(din_ptr + 8);
-        float32x4_t din3 = vld1q_f32(din_ptr + 12);
-
-        din0 = vmaxq_f32(din0, rb);
-        din1 = vmaxq_f32(din1, rb);
-        din2 = vmaxq_f32(din2, rb);
-        din3 = vmaxq_f32(din3, rb);
-
-        // relu
-        din0 = vmaxq_f32(din0, vzero);
-        din1 = vmaxq_f32(din1, vzero);
-        din2 = vmaxq_f32(din2, vzero);
-        din3 = vmaxq_f32(din3, vzero);
-
-        vst1q_f32(dout_ptr, din0);
-        vst1q_f32(dout_ptr + 4, din1);
-        vst1q_f32(dout_ptr + 8, din2);
-        vst1q_f32(dout_ptr + 12, din3);
-        din_ptr += 16;
-        dout_ptr += 16;
-      }
-      if (remain >= 8) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        float32x4_t din1 = vld1q_f32(din_ptr + 4);
-        din0 = vmaxq_f32(din0, rb);
-        din1 = vmaxq_f32(din1, rb);
-        // relu
-        din0 = vmaxq_f32(din0, vzero);
-        din1 = vmaxq_f32(din1, vzero);
-        vst1q_f32(dout_ptr, din0);
-        vst1q_f32(dout_ptr + 4, din1);
-        din_ptr += 8;
-        dout_ptr += 8;
-        remain -= 8;
-      }
-      if (remain >= 4) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        din0 = vmaxq_f32(din0, rb);
-        // relu
-        din0 = vmaxq_f32(din0, vzero);
-        vst1q_f32(dout_ptr, din0);
-        din_ptr += 4;
-        dout_ptr += 4;
-        remain -= 4;
-      }
-      if (remain > 0) {
-        for (int p = 0; p < remain; ++p) {
-          float tmp = std::max(*din_ptr, diny_data);
-          *dout_ptr = tmp > 0.f ? tmp : 0.f;
-          dout_ptr++;
-          din_ptr++;
-        }
+  LITE_PARALLEL_BEGIN(i_j, tid, batch * channels) {
+    int i = i_j / channels;
+    int j = i_j % channels;
+    int offset = (i * channels + j) * num;
+    const float* din_ptr = dinx + offset;
+    const float diny_data = diny[j];
+    float* dout_ptr = dout + offset;
+
+    int cnt = num >> 4;
+    int remain = num % 16;
+    float32x4_t rb = vdupq_n_f32(diny_data);
+    for (int k = 0; k < cnt; ++k) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      float32x4_t din1 = vld1q_f32(din_ptr + 4);
+      float32x4_t din2 = vld1q_f32(din_ptr + 8);
+      float32x4_t din3 = vld1q_f32(din_ptr + 12);
+
+      din0 = vmaxq_f32(din0, rb);
+      din1 = vmaxq_f32(din1, rb);
+      din2 = vmaxq_f32(din2, rb);
+      din3 = vmaxq_f32(din3, rb);
+
+      // relu
+      din0 = vmaxq_f32(din0, vzero);
+      din1 = vmaxq_f32(din1, vzero);
+      din2 = vmaxq_f32(din2, vzero);
+      din3 = vmaxq_f32(din3, vzero);
+
+      vst1q_f32(dout_ptr, din0);
+      vst1q_f32(dout_ptr + 4, din1);
+      vst1q_f32(dout_ptr + 8, din2);
+      vst1q_f32(dout_ptr + 12, din3);
+      din_ptr += 16;
+      dout_ptr += 16;
+    }
+    if (remain >= 8) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      float32x4_t din1 = vld1q_f32(din_ptr + 4);
+      din0 = vmaxq_f32(din0, rb);
+      din1 = vmaxq_f32(din1, rb);
+      // relu
+      din0 = vmaxq_f32(din0, vzero);
+      din1 = vmaxq_f32(din1, vzero);
+      vst1q_f32(dout_ptr, din0);
+      vst1q_f32(dout_ptr + 4, din1);
+      din_ptr += 8;
+      dout_ptr += 8;
+      remain -= 8;
+    }
+    if (remain >= 4) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      din0 = vmaxq_f32(din0, rb);
+      // relu
+      din0 = vmaxq_f32(din0, vzero);
+      vst1q_f32(dout_ptr, din0);
+      din_ptr += 4;
+      dout_ptr += 4;
+      remain -= 4;
+    }
+    if (remain > 0) {
+      for (int p = 0; p < remain; ++p) {
+        float tmp = std::max(*din_ptr, diny_data);
+        *dout_ptr = tmp > 0.f ? tmp : 0.f;
+        dout_ptr++;
+        din_ptr++;
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 template <>
@@ -759,8 +760,7 @@ void elementwise_div<float>(const float* dinx,
                             int num) {
   int cnt = num >> 4;
   int remain = num % 16;
-#pragma omp parallel for
-  for (int i = 0; i < cnt; i++) {
+  LITE_PARALLEL_BEGIN(i, tid, cnt) {
     const float* dinx_ptr = dinx + (i << 4);
     const float* diny_ptr = diny + (i << 4);
     float* dout_ptr = dout + (i << 4);
@@ -791,6 +791,7 @@ void elementwise_div<float>(const float* dinx,
     vst1q_f32(dout_ptr + 8, dinx2);
     vst1q_f32(dout_ptr + 12, dinx3);
   }
+  LITE_PARALLEL_END();
   if (remain > 0) {
     const float* dinx_ptr = dinx + (cnt << 4);
     const float* diny_ptr = diny + (cnt << 4);
@@ -811,79 +812,79 @@ void elementwise_div_broadcast<float>(const float* dinx,
                                       int batch,
                                       int channels,
                                       int num) {
-#pragma omp parallel for collapse(2)
-  for (int i = 0; i < batch; ++i) {
-    for (int j = 0; j < channels; ++j) {
-      int offset = (i * channels + j) * num;
-      const float* din_ptr = dinx + offset;
-      const float diny_data = diny[j];
-      float* dout_ptr = dout + offset;
-
-      int cnt = num >> 4;
-      int remain = num % 16;
-      float32x4_t rb = vdupq_n_f32(diny_data);
-      for (int k = 0; k < cnt; ++k) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        float32x4_t din1 = vld1q_f32(din_ptr + 4);
-        float32x4_t din2 = vld1q_f32(din_ptr + 8);
-        float32x4_t din3 = vld1q_f32(din_ptr + 12);
+  LITE_PARALLEL_BEGIN(i_j, tid, batch * channels) {
+    int i = i_j / channels;
+    int j = i_j % channels;
+    int offset = (i * channels + j) * num;
+    const float* din_ptr = dinx + offset;
+    const float diny_data = diny[j];
+    float* dout_ptr = dout + offset;
+
+    int cnt = num >> 4;
+    int remain = num % 16;
+    float32x4_t rb = vdupq_n_f32(diny_data);
+    for (int k = 0; k < cnt; ++k) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      float32x4_t din1 = vld1q_f32(din_ptr + 4);
+      float32x4_t din2 = vld1q_f32(din_ptr + 8);
+      float32x4_t din3 = vld1q_f32(din_ptr + 12);
 
 #ifdef __aarch64__
-        din0 = vdivq_f32(din0, rb);
-        din1 = vdivq_f32(din1, rb);
-        din2 = vdivq_f32(din2, rb);
-        din3 = vdivq_f32(din3, rb);
+      din0 = vdivq_f32(din0, rb);
+      din1 = vdivq_f32(din1, rb);
+      din2 = vdivq_f32(din2, rb);
+      din3 = vdivq_f32(din3, rb);
 #else
-        din0 = div_ps(din0, rb);
-        din1 = div_ps(din1, rb);
-        din2 = div_ps(din2, rb);
-        din3 = div_ps(din3, rb);
+      din0 = div_ps(din0, rb);
+      din1 = div_ps(din1, rb);
+      din2 = div_ps(din2, rb);
+      din3 = div_ps(din3, rb);
 #endif
 
-        vst1q_f32(dout_ptr, din0);
-        vst1q_f32(dout_ptr + 4, din1);
-        vst1q_f32(dout_ptr + 8, din2);
-        vst1q_f32(dout_ptr + 12, din3);
-        din_ptr += 16;
-        dout_ptr += 16;
-      }
-      if (remain >= 8) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        float32x4_t din1 = vld1q_f32(din_ptr + 4);
+      vst1q_f32(dout_ptr, din0);
+      vst1q_f32(dout_ptr + 4, din1);
+      vst1q_f32(dout_ptr + 8, din2);
+      vst1q_f32(dout_ptr + 12, din3);
+      din_ptr += 16;
+      dout_ptr += 16;
+    }
+    if (remain >= 8) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      float32x4_t din1 = vld1q_f32(din_ptr + 4);
 #ifdef __aarch64__
-        din0 = vdivq_f32(din0, rb);
-        din1 = vdivq_f32(din1, rb);
+      din0 = vdivq_f32(din0, rb);
+      din1 = vdivq_f32(din1, rb);
 #else
-        din0 = div_ps(din0, rb);
-        din1 = div_ps(din1, rb);
+      din0 = div_ps(din0, rb);
+      din1 = div_ps(din1, rb);
 #endif
-        vst1q_f32(dout_ptr, din0);
-        vst1q_f32(dout_ptr + 4, din1);
-        din_ptr += 8;
-        dout_ptr += 8;
-        remain -= 8;
-      }
-      if (remain >= 4) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
+      vst1q_f32(dout_ptr, din0);
+      vst1q_f32(dout_ptr + 4, din1);
+      din_ptr += 8;
+      dout_ptr += 8;
+      remain -= 8;
+    }
+    if (remain >= 4) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
 #ifdef __aarch64__
-        din0 = vdivq_f32(din0, rb);
+      din0 = vdivq_f32(din0, rb);
 #else
-        din0 = div_ps(din0, rb);
+      din0 = div_ps(din0, rb);
 #endif
-        vst1q_f32(dout_ptr, din0);
-        din_ptr += 4;
-        dout_ptr += 4;
-        remain -= 4;
-      }
-      if (remain > 0) {
-        for (int p = 0; p < remain; p++) {
-          *dout_ptr = *din_ptr / diny_data;
-          dout_ptr++;
-          din_ptr++;
-        }
+      vst1q_f32(dout_ptr, din0);
+      din_ptr += 4;
+      dout_ptr += 4;
+      remain -= 4;
+    }
+    if (remain > 0) {
+      for (int p = 0; p < remain; p++) {
+        *dout_ptr = *din_ptr / diny_data;
+        dout_ptr++;
+        din_ptr++;
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 template <>
@@ -894,8 +895,7 @@ void elementwise_div_relu<float>(const float* dinx,
   int cnt = num >> 4;
   int remain = num % 16;
   float32x4_t vzero = vdupq_n_f32(0.f);
-#pragma omp parallel for
-  for (int i = 0; i < cnt; ++i) {
+  LITE_PARALLEL_BEGIN(i, tid, cnt) {
     const float* dinx_ptr = dinx + (i << 4);
     const float* diny_ptr = diny + (i << 4);
     float* dout_ptr = dout + (i << 4);
@@ -932,6 +932,7 @@ void elementwise_div_relu<float>(const float* dinx,
     vst1q_f32(dout_ptr + 8, dinx2);
     vst1q_f32(dout_ptr + 12, dinx3);
   }
+  LITE_PARALLEL_END();
   if (remain > 0) {
     const float* dinx_ptr = dinx + (cnt << 4);
     const float* diny_ptr = diny + (cnt << 4);
@@ -953,90 +954,90 @@ void elementwise_div_relu_broadcast<float>(const float* dinx,
                                            int channels,
                                            int num) {
   float32x4_t vzero = vdupq_n_f32(0.f);
-#pragma omp parallel for collapse(2)
-  for (int i = 0; i < batch; ++i) {
-    for (int j = 0; j < channels; ++j) {
-      int offset = (i * channels + j) * num;
-      const float* din_ptr = dinx + offset;
-      const float diny_data = diny[j];
-      float* dout_ptr = dout + offset;
-
-      int cnt = num >> 4;
-      int remain = num % 16;
-      float32x4_t rb = vdupq_n_f32(diny_data);
-      for (int k = 0; k < cnt; ++k) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        float32x4_t din1 = vld1q_f32(din_ptr + 4);
-        float32x4_t din2 = vld1q_f32(din_ptr + 8);
-        float32x4_t din3 = vld1q_f32(din_ptr + 12);
+  LITE_PARALLEL_BEGIN(i_j, tid, batch * channels) {
+    int i = i_j / channels;
+    int j = i_j % channels;
+    int offset = (i * channels + j) * num;
+    const float* din_ptr = dinx + offset;
+    const float diny_data = diny[j];
+    float* dout_ptr = dout + offset;
+
+    int cnt = num >> 4;
+    int remain = num % 16;
+    float32x4_t rb = vdupq_n_f32(diny_data);
+    for (int k = 0; k < cnt; ++k) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      float32x4_t din1 = vld1q_f32(din_ptr + 4);
+      float32x4_t din2 = vld1q_f32(din_ptr + 8);
+      float32x4_t din3 = vld1q_f32(din_ptr + 12);
 
 #ifdef __aarch64__
-        din0 = vdivq_f32(din0, rb);
-        din1 = vdivq_f32(din1, rb);
-        din2 = vdivq_f32(din2, rb);
-        din3 = vdivq_f32(din3, rb);
+      din0 = vdivq_f32(din0, rb);
+      din1 = vdivq_f32(din1, rb);
+      din2 = vdivq_f32(din2, rb);
+      din3 = vdivq_f32(din3, rb);
 #else
-        din0 = div_ps(din0, rb);
-        din1 = div_ps(din1, rb);
-        din2 = div_ps(din2, rb);
-        din3 = div_ps(din3, rb);
+      din0 = div_ps(din0, rb);
+      din1 = div_ps(din1, rb);
+      din2 = div_ps(din2, rb);
+      din3 = div_ps(din3, rb);
 #endif
-        // relu
-        din0 = vmaxq_f32(din0, vzero);
-        din1 = vmaxq_f32(din1, vzero);
-        din2 = vmaxq_f32(din2, vzero);
-        din3 = vmaxq_f32(din3, vzero);
-
-        vst1q_f32(dout_ptr, din0);
-        vst1q_f32(dout_ptr + 4, din1);
-        vst1q_f32(dout_ptr + 8, din2);
-        vst1q_f32(dout_ptr + 12, din3);
-        din_ptr += 16;
-        dout_ptr += 16;
-      }
-      if (remain >= 8) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
-        float32x4_t din1 = vld1q_f32(din_ptr + 4);
+      // relu
+      din0 = vmaxq_f32(din0, vzero);
+      din1 = vmaxq_f32(din1, vzero);
+      din2 = vmaxq_f32(din2, vzero);
+      din3 = vmaxq_f32(din3, vzero);
+
+      vst1q_f32(dout_ptr, din0);
+      vst1q_f32(dout_ptr + 4, din1);
+      vst1q_f32(dout_ptr + 8, din2);
+      vst1q_f32(dout_ptr + 12, din3);
+      din_ptr += 16;
+      dout_ptr += 16;
+    }
+    if (remain >= 8) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
+      float32x4_t din1 = vld1q_f32(din_ptr + 4);
 #ifdef __aarch64__
-        din0 = vdivq_f32(din0, rb);
-        din1 = vdivq_f32(din1, rb);
+      din0 = vdivq_f32(din0, rb);
+      din1 = vdivq_f32(din1, rb);
 #else
-        din0 = div_ps(din0, rb);
-        din1 = div_ps(din1, rb);
+      din0 = div_ps(din0, rb);
+      din1 = div_ps(din1, rb);
 #endif
-        // relu
-        din0 = vmaxq_f32(din0, vzero);
-        din1 = vmaxq_f32(din1, vzero);
-        vst1q_f32(dout_ptr, din0);
-        vst1q_f32(dout_ptr + 4, din1);
-        din_ptr += 8;
-        dout_ptr += 8;
-        remain -= 8;
-      }
-      if (remain >= 4) {
-        float32x4_t din0 = vld1q_f32(din_ptr);
+      // relu
+      din0 = vmaxq_f32(din0, vzero);
+      din1 = vmaxq_f32(din1, vzero);
+      vst1q_f32(dout_ptr, din0);
+      vst1q_f32(dout_ptr + 4, din1);
+      din_ptr += 8;
+      dout_ptr += 8;
+      remain -= 8;
+    }
+    if (remain >= 4) {
+      float32x4_t din0 = vld1q_f32(din_ptr);
 #ifdef __aarch64__
-        din0 = vdivq_f32(din0, rb);
+      din0 = vdivq_f32(din0, rb);
 #else
-        din0 = div_ps(din0, rb);
+      din0 = div_ps(din0, rb);
 #endif
-        // relu
-        din0 = vmaxq_f32(din0, vzero);
-        vst1q_f32(dout_ptr, din0);
-        din_ptr += 4;
-        dout_ptr += 4;
-        remain -= 4;
-      }
-      if (remain > 0) {
-        for (int p = 0; p < remain; p++) {
-          float tmp = *din_ptr / diny_data;
-          *dout_ptr = tmp > 0.f ? tmp : 0.f;
-          dout_ptr++;
-          din_ptr++;
-        }
+      // relu
+      din0 = vmaxq_f32(din0, vzero);
+      vst1q_f32(dout_ptr, din0);
+      din_ptr += 4;
+      dout_ptr += 4;
+      remain -= 4;
+    }
+    if (remain > 0) {
+      for (int p = 0; p < remain; p++) {
+        float tmp = *din_ptr / diny_data;
+        *dout_ptr = tmp > 0.f ? tmp : 0.f;
+        dout_ptr++;
+        din_ptr++;
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 }  // namespace math
@@ -14,6 +14,7 @@
 
 #include "lite/backends/arm/math/packed_sgemm.h"
 #include <arm_neon.h>
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
@@ -303,8 +304,7 @@ void prepackA_8x12(float *dout,
   memset(zerobuff, 0, sizeof(float) * x_len);
   bool has_alpha = fabsf(alpha - 1.f) > 1e-8f;
 
-#pragma omp parallel for
-  for (int y = m0; y < mmax; y += 8) {
+  LITE_PARALLEL_COMMON_BEGIN(y, tid, mmax, m0, 8) {
     float *outptr = dout + stride * (y - m0) / 8;
 
     const float *inptr0 = inptr + y * ldin + k0;
@@ -521,6 +521,7 @@ void prepackA_8x12(float *dout,
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 void prepackA_trans_8x12(float *outptr,
@@ -547,8 +548,7 @@ void prepackA_trans_8x12(float *outptr,
   bool has_alpha = fabsf(alpha - 1.f) > 1e-8f;
   float32x4_t valpha = vdupq_n_f32(alpha);
 
-#pragma omp parallel for
-  for (int y = 0; y < y_len - 3; y += 4) {
+  LITE_PARALLEL_COMMON_BEGIN(y, tid, y_len - 3, 0, 4) {
     const float *ptr0 = inptr + y * ldin;
     const float *ptr1 = ptr0 + ldin;
     const float *ptr2 = ptr1 + ldin;
@@ -645,9 +645,9 @@ void prepackA_trans_8x12(float *outptr,
       vst1q_f32(outptr_row_col + 28, vr31_1);
     }
   }
+  LITE_PARALLEL_END();
 
-#pragma omp parallel for
-  for (int y = 4 * (y_len / 4); y < y_len; ++y) {
+  LITE_PARALLEL_COMMON_BEGIN(y, tid, y_len, 4 * (y_len / 4), 1) {
     const float *ptr0 = inptr + y * ldin;
     float *outptr_row_col = outptr + y * 8;
     int i = 0;
@@ -681,6 +681,7 @@ void prepackA_trans_8x12(float *outptr,
       vst1q_f32(outptr_row_col + 4, vr1_1);
     }
   }
+  LITE_PARALLEL_END();
 }
 
 #else  // __aarch64__
@@ -871,8 +872,7 @@ void prepackA_trans_6x8(float* outptr,
   uint32x4_t vmask2 =
       vcltq_u32(vld1q_u32(mask_buffer + 4), vdupq_n_u32(right_remain));
 
-#pragma omp parallel for
-  for (int y = 0; y < y_len - 3; y += 4) {
+  LITE_PARALLEL_COMMON_BEGIN(y, tid, y_len - 3, 0, 4) {
     const float* ptr0 = inptr + y * ldin;
     const float* ptr1 = ptr0 + ldin;
     const float* ptr2 = ptr1 + ldin;
@@ -954,9 +954,9 @@ void prepackA_trans_6x8(float* outptr,
           : "q0", "q1", "q2", "q3", "q4", "q5", "q6", "q7", "cc", "memory");
     }
   }
+  LITE_PARALLEL_END();
 
-#pragma omp parallel for
-  for (int y = 4 * (y_len / 4); y < y_len; ++y) {
+  LITE_PARALLEL_COMMON_BEGIN(y, tid, y_len, 4 * (y_len / 4), 1) {
     const float* ptr0 = inptr + y * ldin;
     float* outptr_row_col = outptr_row + y * 6;
     int i = 0;
@@ -996,6 +996,7 @@ void prepackA_trans_6x8(float* outptr,
           : "q0", "q1", "cc", "memory");
     }
   }
+  LITE_PARALLEL_END();
 }
 
 void prepackA_4x8(float* outptr,
@@ -1135,8 +1136,7 @@ void prepackA_trans_4x8(float* outptr,
   uint32x4_t vmask1 =
       vcltq_u32(vld1q_u32(mask_buffer), vdupq_n_u32(right_remain));
 
-#pragma omp parallel for
-  for (int y = 0; y < y_len - 3; y += 4) {
+  LITE_PARALLEL_COMMON_BEGIN(y, tid, y_len - 3, 0, 4) {
     const float* ptr0 = inptr + y * ldin;
     const float* ptr1 = ptr0 + ldin;
     const float* ptr2 = ptr1 + ldin;
@@ -1205,9 +1205,9 @@ void prepackA_trans_4x8(float* outptr,
           : "q0", "q1", "q2", "q3", "cc", "memory");
     }
   }
+  LITE_PARALLEL_END();
 
-#pragma omp parallel for
-  for (int y = 4 * (y_len / 4); y < y_len; ++y) {
+  LITE_PARALLEL_COMMON_BEGIN(y, tid, y_len, 4 * (y_len / 4), 1) {
     const float* ptr0 = inptr + y * ldin;
     float* outptr_row_col = outptr + y * 4;
     int i = 0;
@@ -1243,6 +1243,7 @@ void prepackA_trans_4x8(float* outptr,
           : "q0", "q1", "cc", "memory");
     }
   }
+  LITE_PARALLEL_END();
 }
 
 #endif  // __aarch64__
@@ -1274,8 +1275,7 @@ void loadb(
   uint32x4_t vmask3 =
       vcltq_u32(vld1q_u32(mask_buffer + 8), vdupq_n_u32(right_remain));
 
-#pragma omp parallel for
-  for (int y = 0; y < y_len - 3; y += 4) {
+  LITE_PARALLEL_COMMON_BEGIN(y, tid, y_len - 3, 0, 4) {
     const uint32_t *ptr0 = inptr + y * ldin;
     const uint32_t *ptr1 = ptr0 + ldin;
     const uint32_t *ptr2 = ptr1 + ldin;
@@ -1386,9 +1386,9 @@ void loadb(
       vst1q_u32(outptr_row_col + 44, vr32_1);
     }
   }
+  LITE_PARALLEL_END();
 
-#pragma omp parallel for
-  for (int y = 4 * (y_len / 4); y < y_len; ++y) {
+  LITE_PARALLEL_COMMON_BEGIN(y, tid, y_len, 4 * (y_len / 4), 1) {
     const uint32_t *ptr0 = inptr + y * ldin;
     uint32_t *outptr_row_col = outptr_row + y * 12;
 
@@ -1419,6 +1419,7 @@ void loadb(
       vst1q_u32(outptr_row_col + 8, vr2_1);
     }
   }
+  LITE_PARALLEL_END();
 }
 
 void loadb_trans(
@@ -1711,8 +1712,7 @@ void loadb(
   uint32x4_t vmask2 =
       vcltq_u32(vld1q_u32(mask_buffer + 4), vdupq_n_u32(right_remain));
 
-#pragma omp parallel for
-  for (int y = 0; y < y_len - 3; y += 4) {
+  LITE_PARALLEL_COMMON_BEGIN(y, tid, y_len - 3, 0, 4) {
     const uint32_t* ptr0 = inptr + y * ldin;
     const uint32_t* ptr1 = ptr0 + ldin;
     const uint32_t* ptr2 = ptr1 + ldin;
@@ -1771,8 +1771,8 @@ void loadb(
           : "q0", "q1", "q2", "q3", "cc", "memory");
     }
   }
-#pragma omp parallel for
-  for (int y = 4 * (y_len / 4); y < y_len; ++y) {
+  LITE_PARALLEL_END();
+  LITE_PARALLEL_COMMON_BEGIN(y, tid, y_len, 4 * (y_len / 4), 1) {
     const uint32_t* ptr0 = inptr + y * ldin;
     uint32_t* outptr_row_col = outptr_row + y * 8;
     int i = 0;
@@ -1798,6 +1798,7 @@ void loadb(
           : "q0", "q1", "cc", "memory");
     }
   }
+  LITE_PARALLEL_END();
 }
 
 void loadb_trans(
@@ -2032,8 +2033,7 @@ void sgemm_prepacked_8x12(bool is_transB,
     } else {
       loadb(b_pannel, B, ldb, 0, K, x0, xmax);
     }
-#pragma omp parallel for num_threads(threads)
-    for (unsigned int y = 0; y < M; y += MBLOCK) {
+    LITE_PARALLEL_COMMON_BEGIN_THREADS(y, tid, M, 0, MBLOCK, threads) {
       unsigned int ymax = y + MBLOCK;
       if (ymax > M) {
         ymax = M;
@@ -2644,6 +2644,7 @@ void sgemm_prepacked_8x12(bool is_transB,
         }
       }
     }
+    LITE_PARALLEL_END();
   }
 }
 #else  // __aarch64__
@@ -2715,8 +2716,7 @@ void sgemm_prepacked_6x8(bool is_transB,
     } else {
       loadb(b_pannel, B, ldb, 0, K, x0, xmax);
     }
-#pragma omp parallel for num_threads(threads)
-    for (unsigned int y = 0; y < M; y += MBLOCK_OTH) {
+    LITE_PARALLEL_COMMON_BEGIN_THREADS(y, tid, M, 0, MBLOCK_OTH, threads) {
       unsigned int ymax = y + MBLOCK_OTH;
       if (ymax > M) {
         ymax = M;
@@ -3115,6 +3115,7 @@ void sgemm_prepacked_6x8(bool is_transB,
         }
       }
     }
+    LITE_PARALLEL_END();
   }
 }
 
@@ -3175,8 +3176,7 @@ void sgemm_prepacked_4x8(bool is_transB,
     } else {
       loadb(b_pannel, B, ldb, 0, K, x0, xmax);
     }
-#pragma omp parallel for num_threads(threads)
-    for (unsigned int y = 0; y < M; y += MBLOCK_A73) {
+    LITE_PARALLEL_COMMON_BEGIN_THREADS(y, tid, M, 0, MBLOCK_A73, threads) {
       unsigned int ymax = y + MBLOCK_A73;
       if (ymax > M) {
         ymax = M;
@@ -3471,6 +3471,7 @@ void sgemm_prepacked_4x8(bool is_transB,
         }
       }
     }
+    LITE_PARALLEL_END();
   }
 }
 #endif  // __aarch64__
@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <limits>
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
@@ -54,8 +55,7 @@ void pooling_basic(const float* din,
       for (int n = 0; n < num; ++n) {
         float* dout_batch = dout + n * chout * size_channel_out;
         const float* din_batch = din + n * chin * size_channel_in;
-#pragma omp parallel for
-        for (int c = 0; c < chout; ++c) {
+        LITE_PARALLEL_BEGIN(c, tid, chout) {
           const float* din_ch = din_batch + c * size_channel_in;  // in address
           float tmp1 = din_ch[0];
           for (int i = 0; i < size_channel_in; ++i) {
@@ -64,6 +64,7 @@ void pooling_basic(const float* din,
           }
           dout_batch[c] = tmp1;
         }
+        LITE_PARALLEL_END();
       }
     } else if (pooling_type == "avg") {
       // Pooling_average_include_padding
@@ -71,8 +72,7 @@ void pooling_basic(const float* din,
       for (int n = 0; n < num; ++n) {
         float* dout_batch = dout + n * chout * size_channel_out;
         const float* din_batch = din + n * chin * size_channel_in;
-#pragma omp parallel for
-        for (int c = 0; c < chout; ++c) {
+        LITE_PARALLEL_BEGIN(c, tid, chout) {
           const float* din_ch = din_batch + c * size_channel_in;  // in address
           float sum = 0.f;
           for (int i = 0; i < size_channel_in; ++i) {
@@ -80,6 +80,7 @@ void pooling_basic(const float* din,
           }
           dout_batch[c] = sum / size_channel_in;
         }
+        LITE_PARALLEL_END();
       }
     } else {
       LOG(FATAL) << "unsupported pooling type: " << pooling_type;
@@ -90,8 +91,7 @@ void pooling_basic(const float* din,
       for (int n = 0; n < num; ++n) {
         float* dout_ch = dout + n * chout * size_channel_out;
         const float* din_batch = din + n * chin * size_channel_in;
-#pragma omp parallel for
-        for (int c = 0; c < chout; c++) {
+        LITE_PARALLEL_BEGIN(c, tid, chout) {
           float* dout_row = dout_ch + c * size_channel_out;
           const float* din_ch = din_batch + c * size_channel_in;
           for (int i = 0; i < hout; i++) {
@@ -118,6 +118,7 @@ void pooling_basic(const float* din,
             dout_row += wout;
           }
         }
+        LITE_PARALLEL_END();
       }
     } else if (pooling_type == "avg") {
       if (exclusive) {
@@ -125,8 +126,7 @@ void pooling_basic(const float* din,
         for (int n = 0; n < num; ++n) {
           float* dout_ch = dout + n * chout * size_channel_out;
           const float* din_batch = din + n * chin * size_channel_in;
-#pragma omp parallel for
-          for (int c = 0; c < chout; c++) {
+          LITE_PARALLEL_BEGIN(c, tid, chout) {
             float* dout_row = dout_ch + c * size_channel_out;
             const float* din_ch = din_batch + c * size_channel_in;
             for (int i = 0; i < hout; i++) {
@@ -152,13 +152,13 @@ void pooling_basic(const float* din,
               dout_row += wout;
             }
           }
+          LITE_PARALLEL_END();
         }
       } else {  // Pooling_average_include_padding
         for (int n = 0; n < num; ++n) {
           float* dout_ch = dout + n * chout * size_channel_out;
           const float* din_batch = din + n * chin * size_channel_in;
-#pragma omp parallel for
-          for (int c = 0; c < chout; c++) {
+          LITE_PARALLEL_BEGIN(c, tid, chout) {
             float* dout_row = dout_ch + c * size_channel_out;
             const float* din_ch = din_batch + c * size_channel_in;
             for (int i = 0; i < hout; i++) {
@@ -184,6 +184,7 @@ void pooling_basic(const float* din,
               dout_row += wout;
             }
           }
+          LITE_PARALLEL_END();
         }
       }
     } else {
@@ -206,8 +207,7 @@ void pooling_global_max(const float* din,
   for (int n = 0; n < num; ++n) {
     float* dout_batch = dout + n * chout;
     const float* din_batch = din + n * chin * size_channel_in;
-#pragma omp parallel for
-    for (int c = 0; c < chout; ++c) {
+    LITE_PARALLEL_BEGIN(c, tid, chout) {
       const float* din_ch = din_batch + c * size_channel_in;
       int i = 0;
       float minval = std::numeric_limits<float>::lowest();
@@ -247,6 +247,7 @@ void pooling_global_max(const float* din,
       }
       dout_batch[c] = max_tmp;
     }
+    LITE_PARALLEL_END();
   }
 }
 
@@ -264,8 +265,7 @@ void pooling_global_avg(const float* din,
   for (int n = 0; n < num; ++n) {
     float* dout_batch = dout + n * chout;
     const float* din_batch = din + n * chin * size_channel_in;
-#pragma omp parallel for
-    for (int c = 0; c < chout; c++) {
+    LITE_PARALLEL_BEGIN(c, tid, chout) {
       const float* din_ch = din_batch + c * size_channel_in;  // in address
       int i = 0;
       float32x4_t vsum = vdupq_n_f32(0.0f);
@@ -296,6 +296,7 @@ void pooling_global_avg(const float* din,
       }
       dout_batch[c] = sum / size_channel_in;
     }
+    LITE_PARALLEL_END();
   }
 }
 
@@ -326,8 +327,7 @@ void pooling2x2s2_max(const float* din,
   for (int n = 0; n < num; ++n) {
     float* dout_batch = dout + n * chout * size_channel_out;
     const float* din_batch = din + n * chin * size_channel_in;
-#pragma omp parallel for
-    for (int c = 0; c < chout; c++) {
+    LITE_PARALLEL_BEGIN(c, tid, chout) {
       float* dout_ch = dout_batch + c * size_channel_out;
       const float* din_ch = din_batch + c * size_channel_in;
       const float* r0 = din_ch;
@@ -436,6 +436,7 @@ void pooling2x2s2_max(const float* din,
         }
       }
     }
+    LITE_PARALLEL_END();
   }
 }
 
@@ -473,8 +474,7 @@ void pooling2x2s2_avg(const float* din,
   for (int n = 0; n < num; ++n) {
     float* dout_batch = dout + n * chout * size_channel_out;
     const float* din_batch = din + n * chin * size_channel_in;
-#pragma omp parallel for
-    for (int c = 0; c < chout; c++) {
+    LITE_PARALLEL_BEGIN(c, tid, chout) {
       float* dout_ch = dout_batch + c * size_channel_out;
       const float* din_ch = din_batch + c * size_channel_in;
       const float* r0 = din_ch;
@@ -590,6 +590,7 @@ void pooling2x2s2_avg(const float* din,
         }
       }
     }
+    LITE_PARALLEL_END();
   }
 }
 
@@ -614,8 +615,7 @@ void pooling3x3s1p1_max(const float* din,
   for (int n = 0; n < num; ++n) {
     float* dout_batch = dout + n * chout * size_channel_out;
     const float* din_batch = din + n * chin * size_channel_in;
-#pragma omp parallel for
-    for (int c = 0; c < chout; c++) {
+    LITE_PARALLEL_BEGIN(c, tid, chout) {
       float* dout_ch = dout_batch + c * size_channel_out;
       const float* din_ch = din_batch + c * size_channel_in;
       const float* r0 = din_ch;
@@ -915,6 +915,7 @@ void pooling3x3s1p1_max(const float* din,
       tmp = std::max(tmp, std::max(r0[win - 1], r1[win - 1]));
       dout_ch[wout - 1] = tmp;
     }
+    LITE_PARALLEL_END();
   }
 }
 
@@ -947,8 +948,7 @@ void pooling3x3s1p1_avg(const float* din,
   for (int n = 0; n < num; ++n) {
     float* dout_batch = dout + n * chout * size_channel_out;
     const float* din_batch = din + n * chin * size_channel_in;
-#pragma omp parallel for
-    for (int c = 0; c < chout; c++) {
+    LITE_PARALLEL_BEGIN(c, tid, chout) {
       float* dout_ch = dout_batch + c * size_channel_out;
       const float* din_ch = din_batch + c * size_channel_in;
       const float* r0 = din_ch;
@@ -1206,6 +1206,7 @@ void pooling3x3s1p1_avg(const float* din,
       tmp += (r0[win - 1] + r1[win - 1]);
       dout_ch[wout - 1] = tmp * coef_4;
     }
+    LITE_PARALLEL_END();
   }
 }
 
@@ -1239,8 +1240,7 @@ void pooling3x3s2p1_max(const float* din,
   for (int n = 0; n < num; ++n) {
     float* dout_batch = dout + n * chout * size_channel_out;
     const float* din_batch = din + n * chin * size_channel_in;
-#pragma omp parallel for
-    for (int c = 0; c < chout; c++) {
+    LITE_PARALLEL_BEGIN(c, tid, chout) {
       float* dout_ch = dout_batch + c * size_channel_out;
       const float* din_ch = din_batch + c * size_channel_in;
       const float* r0 = din_ch;
@@ -1796,6 +1796,7 @@ void pooling3x3s2p1_max(const float* din,
         }
       }
     }
+    LITE_PARALLEL_END();
   }
 }
 
@@ -1841,8 +1842,7 @@ void pooling3x3s2p1_avg(const float* din,
   for (int n = 0; n < num; ++n) {
     float* dout_batch = dout + n * chout * size_channel_out;
     const float* din_batch = din + n * chin * size_channel_in;
-#pragma omp parallel for
-    for (int c = 0; c < chout; c++) {
+    LITE_PARALLEL_BEGIN(c, tid, chout) {
       float* dout_ch = dout_batch + c * size_channel_out;
       const float* din_ch = din_batch + c * size_channel_in;
       const float* r0 = din_ch;
@@ -2435,6 +2435,7 @@ void pooling3x3s2p1_avg(const float* din,
         }
       }
     }
+    LITE_PARALLEL_END();
   }
 }
 
@@ -2468,8 +2469,7 @@ void pooling3x3s2p0_max(const float* din,
   for (int n = 0; n < num; ++n) {
     float* dout_batch = dout + n * chout * size_channel_out;
     const float* din_batch = din + n * chin * size_channel_in;
-#pragma omp parallel for
-    for (int c = 0; c < chout; c++) {
+    LITE_PARALLEL_BEGIN(c, tid, chout) {
       float* dout_ch = dout_batch + c * size_channel_out;
       const float* din_ch = din_batch + c * size_channel_in;
       const float* r0 = din_ch;
@@ -2800,6 +2800,7 @@ void pooling3x3s2p0_max(const float* din,
         }
       }
     }
+    LITE_PARALLEL_END();
   }
 }
 
@@ -2837,8 +2838,7 @@ void pooling3x3s2p0_avg(const float* din,
   for (int n = 0; n < num; ++n) {
     float* dout_batch = dout + n * chout * size_channel_out;
     const float* din_batch = din + n * chin * size_channel_in;
-#pragma omp parallel for
-    for (int c = 0; c < chout; c++) {
+    LITE_PARALLEL_BEGIN(c, tid, chout) {
       float* dout_ch = dout_batch + c * size_channel_out;
       const float* din_ch = din_batch + c * size_channel_in;
       const float* r0 = din_ch;
@@ -3164,6 +3164,7 @@ void pooling3x3s2p0_avg(const float* din,
         }
       }
     }
+    LITE_PARALLEL_END();
   }
 }
 
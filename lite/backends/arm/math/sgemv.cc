@@ -14,6 +14,7 @@
 
 #include "lite/backends/arm/math/sgemv.h"
 #include <arm_neon.h>
+#include "lite/core/parallel_defines.h"
 #include "lite/utils/cp_logging.h"
 
 namespace paddle {
@@ -439,8 +440,7 @@ void sgemv(const bool transA,
 #ifdef __aarch64__
   int out_cnt = M >> 3;
 
-#pragma omp parallel for
-  for (int j = 0; j < out_cnt; j++) {
+  LITE_PARALLEL_BEGIN(j, tid, out_cnt) {
     int out_idx = j * 8;
     float *ptr_out = data_out + out_idx;
     const float *ptr_in = data_in;
@@ -496,9 +496,9 @@ void sgemv(const bool transA,
                    "cc",
                    "memory");
   }
+  LITE_PARALLEL_END();
 //! deal with remains
-#pragma omp parallel for
-  for (int j = out_cnt * 8; j < M; ++j) {
+  LITE_PARALLEL_COMMON_BEGIN(j, tid, M, out_cnt * 8, 1) {
     float *ptr_out = data_out + j;
     const float *ptr_in = data_in;
     const float *ptr_w0 = weights_ptr + (N * j);
@@ -523,10 +523,10 @@ void sgemv(const bool transA,
           [tmp4] "r"(tmp4)
         : "v0", "v1", "v8", "v9", "v10", "v11", "v16", "v17", "cc", "memory");
   }
+  LITE_PARALLEL_END();
 #else  //__aarch64__
   int out_cnt = M >> 2;
-#pragma omp parallel for
-  for (int j = 0; j < out_cnt; j++) {
+  LITE_PARALLEL_BEGIN(j, tid, out_cnt) {
     int out_idx = j * 4;
     float *ptr_out = data_out + out_idx;
     const float *ptr_in = data_in;
@@ -563,9 +563,9 @@ void sgemv(const bool transA,
                    "cc",
                    "memory");
   }
+  LITE_PARALLEL_END();
 //! deal with remains
-#pragma omp parallel for
-  for (int j = out_cnt * 4; j < M; ++j) {
+  LITE_PARALLEL_COMMON_BEGIN(j, tid, M, out_cnt * 4, 1) {
     float *ptr_out = data_out + j;
     const float *ptr_in = data_in;
     const float *ptr_w0 = weights_ptr + (N * j);
@@ -579,6 +579,7 @@ void sgemv(const bool transA,
                  : [out] "r"(ptr_out)
                  : "q0", "q1", "q12", "q13", "q14", "q15", "cc", "memory");
   }
+  LITE_PARALLEL_END();
 #endif  //__aarch64__
 }
 
@@ -597,8 +598,7 @@ void sgemv_relu(const bool transA,
 
 #ifdef __aarch64__
   int out_cnt = M >> 3;
-#pragma omp parallel for
-  for (int j = 0; j < out_cnt; j++) {
+  LITE_PARALLEL_BEGIN(j, tid, out_cnt) {
     int out_idx = j * 8;
     float *ptr_out = data_out + out_idx;
     const float *ptr_in = data_in;
@@ -654,9 +654,9 @@ void sgemv_relu(const bool transA,
                    "cc",
                    "memory");
   }
+  LITE_PARALLEL_END();
 //! deal with remains
-#pragma omp parallel for
-  for (int j = out_cnt * 8; j < M; ++j) {
+  LITE_PARALLEL_COMMON_BEGIN(j, tid, M, out_cnt * 8, 1) {
     float *ptr_out = data_out + j;
     const float *ptr_in = data_in;
     const float *ptr_w0 = weights_ptr + (N * j);
@@ -671,10 +671,10 @@ void sgemv_relu(const bool transA,
         : [out] "r"(ptr_out)
         : "v0", "v1", "v8", "v9", "v10", "v11", "v16", "v17", "cc", "memory");
   }
+  LITE_PARALLEL_END();
 #else  //__aarch64__
   int out_cnt = M >> 2;
-#pragma omp parallel for
-  for (int j = 0; j < out_cnt; j++) {
+  LITE_PARALLEL_BEGIN(j, tid, out_cnt) {
     int out_idx = j * 4;
     float *ptr_out = data_out + out_idx;
     const float *ptr_in = data_in;
@@ -711,9 +711,9 @@ void sgemv_relu(const bool transA,
                    "cc",
                    "memory");
   }
+  LITE_PARALLEL_END();
 //! deal with remains
-#pragma omp parallel for
-  for (int j = out_cnt * 4; j < M; ++j) {
+  LITE_PARALLEL_COMMON_BEGIN(j, tid, M, out_cnt * 4, 1) {
     float *ptr_out = data_out + j;
     const float *ptr_in = data_in;
     const float *ptr_w0 = weights_ptr + (N * j);
@@ -727,6 +727,7 @@ void sgemv_relu(const bool transA,
                  : [out] "r"(ptr_out)
                  : "q0", "q1", "q12", "q13", "q14", "q15", "cc", "memory");
   }
+  LITE_PARALLEL_END();
 #endif  //__aarch64__
 }
 
@@ -746,8 +747,7 @@ void sgemv_bias(const bool transA,
 
 #ifdef __aarch64__
   int out_cnt = M >> 3;
-#pragma omp parallel for
-  for (int j = 0; j < out_cnt; j++) {
+  LITE_PARALLEL_BEGIN(j, tid, out_cnt) {
     int out_idx = j * 8;
     float *ptr_out = data_out + out_idx;
     const float *ptr_in = data_in;
@@ -804,9 +804,9 @@ void sgemv_bias(const bool transA,
                    "cc",
                    "memory");
   }
+  LITE_PARALLEL_END();
 //! deal with remains
-#pragma omp parallel for
-  for (int j = out_cnt * 8; j < M; ++j) {
+  LITE_PARALLEL_COMMON_BEGIN(j, tid, M, out_cnt * 8, 1) {
     float *ptr_out = data_out + j;
     const float *ptr_in = data_in;
     const float *ptr_w0 = weights_ptr + (N * j);
@@ -822,10 +822,10 @@ void sgemv_bias(const bool transA,
         : [out] "r"(ptr_out), [bias0] "r"(bias0)
         : "v0", "v1", "v8", "v9", "v10", "v11", "v16", "v17", "cc", "memory");
   }
+  LITE_PARALLEL_END();
 #else  //__aarch64__
   int out_cnt = M >> 2;
-#pragma omp parallel for
-  for (int j = 0; j < out_cnt; j++) {
+  LITE_PARALLEL_BEGIN(j, tid, out_cnt) {
     int out_idx = j * 4;
     float *ptr_out = data_out + out_idx;
     const float *ptr_in = data_in;
@@ -870,9 +870,9 @@ void sgemv_bias(const bool transA,
                    "cc",
                    "memory");
   }
+  LITE_PARALLEL_END();
 //! deal with remains
-#pragma omp parallel for
-  for (int j = out_cnt * 4; j < M; ++j) {
+  LITE_PARALLEL_COMMON_BEGIN(j, tid, M, out_cnt * 4, 1) {
     float *ptr_out = data_out + j;
     const float *ptr_in = data_in;
     const float *ptr_w0 = weights_ptr + (N * j);
@@ -887,6 +887,7 @@ void sgemv_bias(const bool transA,
                  : [out] "r"(ptr_out), [bias0] "r"(bias0)
                  : "q0", "q1", "q12", "q13", "q14", "q15", "cc", "memory");
   }
+  LITE_PARALLEL_END();
 #endif  //__aarch64__
 }
 
@@ -904,8 +905,7 @@ void sgemv_bias_relu(const bool transA,
   int tail = N & 7;
 #ifdef __aarch64__
   int out_cnt = M >> 3;
-#pragma omp parallel for
-  for (int j = 0; j < out_cnt; j++) {
+  LITE_PARALLEL_BEGIN(j, tid, out_cnt) {
     int out_idx = j * 8;
     float *ptr_out = data_out + out_idx;
     const float *ptr_in = data_in;
@@ -962,9 +962,9 @@ void sgemv_bias_relu(const bool transA,
                    "cc",
                    "memory");
   }
+  LITE_PARALLEL_END();
 //! deal with remains
-#pragma omp parallel for
-  for (int j = out_cnt * 8; j < M; ++j) {
+  LITE_PARALLEL_COMMON_BEGIN(j, tid, M, out_cnt * 8, 1) {
     float *ptr_out = data_out + j;
     const float *ptr_in = data_in;
     const float *ptr_w0 = weights_ptr + (N * j);
@@ -980,10 +980,10 @@ void sgemv_bias_relu(const bool transA,
         : [out] "r"(ptr_out), [bias0] "r"(bias0)
         : "v0", "v1", "v8", "v9", "v10", "v11", "v16", "v17", "cc", "memory");
   }
+  LITE_PARALLEL_END();
 #else  //__aarch64__
   int out_cnt = M >> 2;
-#pragma omp parallel for
-  for (int j = 0; j < out_cnt; j++) {
+  LITE_PARALLEL_BEGIN(j, tid, out_cnt) {
     int out_idx = j * 4;
     float *ptr_out = data_out + out_idx;
     const float *ptr_in = data_in;
@@ -1028,9 +1028,9 @@ void sgemv_bias_relu(const bool transA,
                    "cc",
                    "memory");
   }
+  LITE_PARALLEL_END();
 //! deal with remains
-#pragma omp parallel for
-  for (int j = out_cnt * 4; j < M; ++j) {
+  LITE_PARALLEL_COMMON_BEGIN(j, tid, M, out_cnt * 4, 1) {
     float *ptr_out = data_out + j;
     const float *ptr_in = data_in;
     const float *ptr_w0 = weights_ptr + (N * j);
@@ -1045,6 +1045,7 @@ void sgemv_bias_relu(const bool transA,
                  : [out] "r"(ptr_out), [bias0] "r"(bias0)
                  : "q0", "q1", "q12", "q13", "q14", "q15", "cc", "memory");
   }
+  LITE_PARALLEL_END();
 #endif  //__aarch64__
 }
 
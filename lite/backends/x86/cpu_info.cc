@@ -26,9 +26,17 @@
 #define NOMINMAX  // msvc max/min macro conflict with std::min/max
 #include <windows.h>
 #else
+#include <sched.h>
 #include <unistd.h>
 #endif  // _WIN32
 
+#ifdef PADDLE_WITH_MKLML
+#include "lite/backends/x86/mklml.h"
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <gflags/gflags.h>
 #include <algorithm>
 
@@ -155,6 +163,55 @@ bool MayIUse(const cpu_isa_t cpu_isa) {
 }
 #endif
 
+size_t CpuCacheSize(int level) {
+  static const std::vector<size_t> sizes = [] {
+    std::vector<size_t> res(3, 0);
+#ifdef __APPLE__
+    const char* names[] = {
+        "hw.l1dcachesize", "hw.l2cachesize", "hw.l3cachesize"};
+    for (int i = 0; i < 3; ++i) {
+      int64_t size = 0;
+      size_t len = sizeof(size);
+      if (sysctlbyname(names[i], &size, &len, NULL, 0) == 0 && size > 0) {
+        res[i] = static_cast<size_t>(size);
+      }
+    }
+#elif defined(_SC_LEVEL1_DCACHE_SIZE)
+    const int names[] = {
+        _SC_LEVEL1_DCACHE_SIZE, _SC_LEVEL2_CACHE_SIZE, _SC_LEVEL3_CACHE_SIZE};
+    for (int i = 0; i < 3; ++i) {
+      int64_t size = sysconf(names[i]);
+      res[i] = size > 0 ? static_cast<size_t>(size) : 0;
+    }
+#endif
+    return res;
+  }();
+  return level >= 1 && level <= 3 ? sizes[level - 1] : 0;
+}
+
+void SetNumThreads(int num_threads) {
+  num_threads = std::max(num_threads, 1);
+#ifdef PADDLE_WITH_MKLML
+  MKL_Set_Num_Threads(num_threads);
+#endif
+#ifdef _OPENMP
+  omp_set_num_threads(num_threads);
+#endif
+}
+
+bool BindCurrentThread(const std::vector<int>& cpu_ids) {
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (int id : cpu_ids) {
+    CPU_SET(id, &mask);
+  }
+  return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+  return false;
+#endif
+}
+
 }  // namespace x86
 }  // namespace lite
 }  // namespace paddle
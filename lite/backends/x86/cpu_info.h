@@ -15,6 +15,7 @@
 #pragma once
 
 #include <stddef.h>
+#include <vector>
 
 #ifdef _WIN32
 #if defined(__AVX2__)
@@ -75,6 +76,16 @@ typedef enum {
 // May I use some instruction
 bool MayIUse(const cpu_isa_t cpu_isa);
 
+//! Get the size in bytes of the data cache of `level` (1, 2 or 3), 0 if it is
+//! unknown.
+size_t CpuCacheSize(int level);
+
+//! Set the threads of the math library (MKL and OpenMP) in current thread.
+void SetNumThreads(int num_threads);
+
+//! Bind the current thread to the cores, return false if failed.
+bool BindCurrentThread(const std::vector<int>& cpu_ids);
+
 }  // namespace x86
 }  // namespace lite
 }  // namespace paddle
@@ -28,6 +28,9 @@
 #ifdef LITE_WITH_NPU
 #include "lite/backends/npu/npu_helper.h"
 #endif
+#ifdef LITE_WITH_X86
+#include "lite/backends/x86/cpu_info.h"
+#endif
 
 #include <map>
 #include <memory>
@@ -104,31 +107,81 @@ class Context<TargetType::kARM> {
   void SetRunMode(lite_api::PowerMode mode, int threads) {
     return DeviceInfo::Global().SetRunMode(mode, threads);
   }
+  // The run mode of the kernel resolved by DeviceInfo::GetRunMode, it is
+  // bound to the thread running the kernel by the program. The default run
+  // mode in DeviceInfo is used if not set.
+  void SetRunMode(lite_api::PowerMode mode,
+                  const std::vector<int>& active_ids) {
+    mode_ = mode;
+    active_ids_ = active_ids;
+  }
   void SetCache(int l1size, int l2size, int l3size) {
     return DeviceInfo::Global().SetCache(l1size, l2size, l3size);
   }
   void SetArch(ARMArch arch) { return DeviceInfo::Global().SetArch(arch); }
 
-  lite_api::PowerMode mode() const { return DeviceInfo::Global().mode(); }
-  int threads() const { return DeviceInfo::Global().threads(); }
-  ARMArch arch() const { return DeviceInfo::Global().arch(); }
-  int l1_cache_size() const { return DeviceInfo::Global().l1_cache_size(); }
-  int l2_cache_size() const { return DeviceInfo::Global().l2_cache_size(); }
-  int l3_cache_size() const { return DeviceInfo::Global().l3_cache_size(); }
-  int llc_size() const { return DeviceInfo::Global().llc_size(); }
-  bool has_dot() const { return DeviceInfo::Global().has_dot(); }
-  bool has_fp16() const { return DeviceInfo::Global().has_fp16(); }
+  lite_api::PowerMode mode() const {
+    return active_ids_.empty() ? DeviceInfo::Global().mode() : mode_;
+  }
+  int threads() const {
+    return active_ids_.empty() ? DeviceInfo::Global().threads()
+                               : active_ids_.size();
+  }
+  ARMArch arch() const {
+    return active_ids_.empty() ? DeviceInfo::Global().arch()
+                               : DeviceInfo::Global().arch(active_ids_[0]);
+  }
+  int l1_cache_size() const {
+    return DeviceInfo::Global().l1_cache_size(first_core());
+  }
+  int l2_cache_size() const {
+    return DeviceInfo::Global().l2_cache_size(first_core());
+  }
+  int l3_cache_size() const {
+    return DeviceInfo::Global().l3_cache_size(first_core());
+  }
+  int llc_size() const { return DeviceInfo::Global().llc_size(first_core()); }
+  bool has_dot() const { return DeviceInfo::Global().has_dot(first_core()); }
+  bool has_fp16() const {
+    return DeviceInfo::Global().has_fp16(first_core());
+  }
+
+  // Share a workspace among the kernels of a program, so that the programs
+  // running concurrently do not share one. The workspace in DeviceInfo is
+  // used if not set.
+  void set_workspace(const std::shared_ptr<TensorLite>& x) { workspace_ = x; }
 
   template <typename T>
   T* workspace_data() {
-    return DeviceInfo::Global().workspace_data<T>();
+    if (!workspace_) {
+      return DeviceInfo::Global().workspace_data<T>();
+    }
+    if (workspace_->numel() < llc_size()) {
+      ExtendWorkspace(0);
+    }
+    return reinterpret_cast<T*>(workspace_->mutable_data<int8_t>());
   }
 
   bool ExtendWorkspace(size_t size) {
-    return DeviceInfo::Global().ExtendWorkspace(size);
+    if (!workspace_) {
+      return DeviceInfo::Global().ExtendWorkspace(size);
+    }
+    workspace_->Resize({static_cast<int64_t>(size + llc_size())});
+    workspace_->mutable_data<int8_t>();
+    return true;
   }
 
   std::string name() const { return "ARMContext"; }
+
+ private:
+  int first_core() const {
+    return active_ids_.empty() ? DeviceInfo::Global().active_ids()[0]
+                               : active_ids_[0];
+  }
+
+  lite_api::PowerMode mode_{lite_api::LITE_POWER_NO_BIND};
+  std::vector<int> active_ids_;
+  std::shared_ptr<TensorLite> workspace_;
 };
 #endif
 
@@ -240,19 +293,58 @@ class Context<TargetType::kX86> {
  public:
   Context() {}
 
-  Context(Context&& ctx) {}
+  Context(Context&& ctx)
+      : threads_(ctx.threads_),
+        cpu_ids_(std::move(ctx.cpu_ids_)),
+        workspace_(std::move(ctx.workspace_)) {}
 
   // NOTE: InitOnce should only be used by ContextScheduler
   void InitOnce() {}
 
   void CopySharedTo(X86Context* ctx) {}
 
+  // The threads of the math library for the kernel, and the cores the thread
+  // running the kernel is bound to, empty if not bound. They are applied to
+  // the thread by the program.
+  void SetRunMode(int threads, const std::vector<int>& cpu_ids) {
+    threads_ = threads;
+    cpu_ids_ = cpu_ids;
+  }
+  int threads() const { return threads_; }
+  const std::vector<int>& cpu_ids() const { return cpu_ids_; }
+
+  int l1_cache_size() const { return x86::CpuCacheSize(1); }
+  int l2_cache_size() const { return x86::CpuCacheSize(2); }
+  int l3_cache_size() const { return x86::CpuCacheSize(3); }
+  int llc_size() const {
+    size_t size = x86::CpuCacheSize(3) > 0 ? x86::CpuCacheSize(3)
+                                           : x86::CpuCacheSize(2);
+    return size > 0 ? size : 512 * 1024;
+  }
+
+  // Share a workspace among the kernels of a program, instead of allocating
+  // the temporary buffers in each kernel.
+  void set_workspace(const std::shared_ptr<TensorLite>& x) { workspace_ = x; }
+
+  // The workspace of `size` bytes at least, aligned as the host memory. It
+  // grows to the largest size requested, the data are not kept when it grows.
+  template <typename T>
+  T* workspace_data(size_t size) {
+    if (!workspace_) {
+      workspace_ = std::make_shared<TensorLite>();
+    }
+    if (workspace_->numel() < static_cast<int64_t>(size)) {
+      workspace_->Resize({static_cast<int64_t>(size)});
+    }
+    return reinterpret_cast<T*>(workspace_->mutable_data<int8_t>());
+  }
+
   std::string name() const { return "X86Context"; }
 
  private:
-  // overall information
-  //
-  // kernel information
+  int threads_{1};
+  std::vector<int> cpu_ids_;
+  std::shared_ptr<TensorLite> workspace_;
 };
 #endif
 
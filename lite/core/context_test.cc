@@ -14,6 +14,8 @@
 
 #include "lite/core/context.h"
 #include <gtest/gtest.h>
+#include <thread>  // NOLINT
+#include <vector>
 
 namespace paddle {
 namespace lite {
@@ -47,5 +49,48 @@ namespace lite {
 // }
 // #endif
 
+#ifdef LITE_WITH_X86
+TEST(X86Context, workspace) {
+  auto ctx_p = ContextScheduler::Global().NewContext(TargetType::kX86);
+  auto& ctx = ctx_p->As<X86Context>();
+  ctx.SetRunMode(2, {0});
+  EXPECT_EQ(ctx.threads(), 2);
+  EXPECT_EQ(ctx.cpu_ids(), std::vector<int>({0}));
+  EXPECT_GT(ctx.llc_size(), 0);
+
+  // The kernels sharing a workspace get the memory of the largest request.
+  auto workspace = std::make_shared<TensorLite>();
+  ctx.set_workspace(workspace);
+  auto* small = ctx.workspace_data<float>(64);
+  auto* large = ctx.workspace_data<float>(1024);
+  EXPECT_EQ(reinterpret_cast<size_t>(large) % 64, 0u);
+  EXPECT_EQ(ctx.workspace_data<float>(64), large);
+  EXPECT_GE(workspace->memory_size(), 1024u);
+  (void)small;
+}
+#endif  // LITE_WITH_X86
+
+#ifdef LITE_WITH_ARM
+TEST(ARMContext, run_mode) {
+  DeviceInfo::Init();
+  DeviceInfo::Global().SetRunMode(lite_api::LITE_POWER_NO_BIND, 1);
+  auto ctx_p = ContextScheduler::Global().NewContext(TargetType::kARM);
+  auto& ctx = ctx_p->As<ARMContext>();
+  // The default run mode of the process is used if not set.
+  EXPECT_EQ(ctx.threads(), 1);
+
+  lite_api::PowerMode mode;
+  std::vector<int> active_ids;
+  DeviceInfo::Global().GetRunMode(
+      lite_api::LITE_POWER_NO_BIND, 2, &mode, &active_ids);
+  ctx.SetRunMode(mode, active_ids);
+  EXPECT_EQ(ctx.threads(), static_cast<int>(active_ids.size()));
+  EXPECT_GT(ctx.llc_size(), 0);
+  // The default run mode is not changed, and it is the same in all threads.
+  EXPECT_EQ(DeviceInfo::Global().threads(), 1);
+  std::thread([] { EXPECT_EQ(DeviceInfo::Global().threads(), 1); }).join();
+}
+#endif  // LITE_WITH_ARM
+
 }  // namespace lite
 }  // namespace paddle
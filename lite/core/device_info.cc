@@ -51,6 +51,9 @@
 #include <algorithm>
 #include <limits>
 #include "lite/core/device_info.h"
+#ifdef LITE_WITH_THREAD_POOL
+#include "lite/core/work_stealing_pool.h"
+#endif  // LITE_WITH_THREAD_POOL
 
 namespace paddle {
 namespace lite {
@@ -808,149 +811,163 @@ void DeviceInfo::SetCPUInfoByProb() {
 #endif  // LITE_WITH_LINUX
 }
 
-void DeviceInfo::RequestPowerFullMode(int thread_num) {
+void DeviceInfo::RequestPowerFullMode(int thread_num,
+                                      lite_api::PowerMode* mode,
+                                      std::vector<int>* active_ids) const {
   int big_core_size = big_core_ids_.size();
   int little_core_size = little_core_ids_.size();
-  active_ids_.clear();
+  active_ids->clear();
   for (int i = 0; i < thread_num; ++i) {
     if (i < big_core_size) {
-      active_ids_.push_back(big_core_ids_[i]);
+      active_ids->push_back(big_core_ids_[i]);
     } else if (i < big_core_size + little_core_size) {
-      active_ids_.push_back(little_core_ids_[i - big_core_size]);
+      active_ids->push_back(little_core_ids_[i - big_core_size]);
     }
   }
-  mode_ = lite_api::PowerMode::LITE_POWER_FULL;
+  *mode = lite_api::PowerMode::LITE_POWER_FULL;
 }
 
-void DeviceInfo::RequestPowerHighMode(int thread_num) {
+void DeviceInfo::RequestPowerHighMode(int thread_num,
+                                      lite_api::PowerMode* mode,
+                                      std::vector<int>* active_ids) const {
   int big_core_size = big_core_ids_.size();
   int little_core_size = little_core_ids_.size();
-  active_ids_.clear();
+  active_ids->clear();
   if (big_core_size > 0) {
-    mode_ = lite_api::PowerMode::LITE_POWER_HIGH;
+    *mode = lite_api::PowerMode::LITE_POWER_HIGH;
     if (thread_num > big_core_size) {
       LOG(ERROR) << "Request thread num: " << thread_num
                  << ", exceed the big cores size: " << big_core_size
                  << ", truncate thread num to " << big_core_size;
-      active_ids_ = big_core_ids_;
+      *active_ids = big_core_ids_;
     } else {
       for (int i = 0; i < thread_num; ++i) {
-        active_ids_.push_back(big_core_ids_[i]);
+        active_ids->push_back(big_core_ids_[i]);
       }
     }
   } else {
-    mode_ = lite_api::PowerMode::LITE_POWER_LOW;
+    *mode = lite_api::PowerMode::LITE_POWER_LOW;
     LOG(ERROR) << "HIGH POWER MODE is not support, switch to little cores.";
     if (thread_num > little_core_size) {
-      active_ids_ = little_core_ids_;
+      *active_ids = little_core_ids_;
     } else {
       for (int i = 0; i < thread_num; ++i) {
-        active_ids_.push_back(little_core_ids_[i]);
+        active_ids->push_back(little_core_ids_[i]);
       }
     }
   }
 }
 
-void DeviceInfo::RequestPowerLowMode(int thread_num) {
+void DeviceInfo::RequestPowerLowMode(int thread_num,
+                                     lite_api::PowerMode* mode,
+                                     std::vector<int>* active_ids) const {
   int big_core_size = big_core_ids_.size();
   int little_core_size = little_core_ids_.size();
-  active_ids_.clear();
+  active_ids->clear();
   if (little_core_size > 0) {
-    mode_ = lite_api::PowerMode::LITE_POWER_LOW;
+    *mode = lite_api::PowerMode::LITE_POWER_LOW;
     if (thread_num > little_core_size) {
       LOG(WARNING) << "Request thread num: " << thread_num
                    << ", exceed the little cores size: " << little_core_size
                    << ", truncate thread num to " << little_core_size;
-      active_ids_ = little_core_ids_;
+      *active_ids = little_core_ids_;
     } else {
       for (int i = 0; i < thread_num; i++) {
-        active_ids_.push_back(little_core_ids_[i]);
+        active_ids->push_back(little_core_ids_[i]);
       }
     }
   } else {
-    mode_ = lite_api::PowerMode::LITE_POWER_HIGH;
+    *mode = lite_api::PowerMode::LITE_POWER_HIGH;
     LOG(WARNING) << "LOW POWER MODE is not support, switch to big cores";
     if (thread_num > big_core_size) {
-      active_ids_ = big_core_ids_;
+      *active_ids = big_core_ids_;
     } else {
       for (int i = 0; i < thread_num; i++) {
-        active_ids_.push_back(big_core_ids_[i]);
+        active_ids->push_back(big_core_ids_[i]);
       }
     }
   }
 }
 
-void DeviceInfo::RequestPowerNoBindMode(int thread_num) {
-  active_ids_.clear();
+void DeviceInfo::RequestPowerNoBindMode(int thread_num,
+                                        lite_api::PowerMode* mode,
+                                        std::vector<int>* active_ids) const {
+  active_ids->clear();
   if (thread_num > core_ids_.size()) {
-    active_ids_ = core_ids_;
+    *active_ids = core_ids_;
   } else {
-    active_ids_.resize(thread_num);
+    active_ids->resize(thread_num);
     for (int i = 0; i < thread_num; ++i) {
       if (i < big_core_ids_.size()) {
-        active_ids_[i] = big_core_ids_[i];
+        (*active_ids)[i] = big_core_ids_[i];
       } else {
-        active_ids_[i] = little_core_ids_[i - big_core_ids_.size()];
+        (*active_ids)[i] = little_core_ids_[i - big_core_ids_.size()];
       }
     }
   }
-  mode_ = lite_api::PowerMode::LITE_POWER_NO_BIND;
+  *mode = lite_api::PowerMode::LITE_POWER_NO_BIND;
 }
 
-void DeviceInfo::RequestPowerRandHighMode(int shift_num, int thread_num) {
+void DeviceInfo::RequestPowerRandHighMode(int shift_num,
+                                          int thread_num,
+                                          lite_api::PowerMode* mode,
+                                          std::vector<int>* active_ids) const {
   int big_core_size = big_core_ids_.size();
   int little_core_size = little_core_ids_.size();
-  active_ids_.clear();
+  active_ids->clear();
   if (big_core_size > 0) {
-    mode_ = lite_api::PowerMode::LITE_POWER_RAND_HIGH;
+    *mode = lite_api::PowerMode::LITE_POWER_RAND_HIGH;
     if (thread_num > big_core_size) {
       LOG(WARNING) << "Request thread num: " << thread_num
                    << ", exceed the big cores size: " << big_core_size
                    << ", truncate thread num to " << big_core_size;
-      active_ids_ = big_core_ids_;
+      *active_ids = big_core_ids_;
     } else {
       for (int i = 0; i < thread_num; ++i) {
-        active_ids_.push_back(big_core_ids_[(i + shift_num) % big_core_size]);
+        active_ids->push_back(big_core_ids_[(i + shift_num) % big_core_size]);
       }
     }
   } else {
-    mode_ = lite_api::PowerMode::LITE_POWER_LOW;
+    *mode = lite_api::PowerMode::LITE_POWER_LOW;
     LOG(WARNING) << "HIGH POWER MODE is not support, switch to little cores.";
     if (thread_num > little_core_size) {
-      active_ids_ = little_core_ids_;
+      *active_ids = little_core_ids_;
     } else {
       for (int i = 0; i < thread_num; ++i) {
-        active_ids_.push_back(little_core_ids_[i]);
+        active_ids->push_back(little_core_ids_[i]);
       }
     }
   }
 }
 
-void DeviceInfo::RequestPowerRandLowMode(int shift_num, int thread_num) {
+void DeviceInfo::RequestPowerRandLowMode(int shift_num,
+                                         int thread_num,
+                                         lite_api::PowerMode* mode,
+                                         std::vector<int>* active_ids) const {
   int big_core_size = big_core_ids_.size();
   int little_core_size = little_core_ids_.size();
-  active_ids_.clear();
+  active_ids->clear();
   if (little_core_size > 0) {
-    mode_ = lite_api::PowerMode::LITE_POWER_RAND_LOW;
+    *mode = lite_api::PowerMode::LITE_POWER_RAND_LOW;
     if (thread_num > little_core_size) {
       LOG(WARNING) << "Request thread num: " << thread_num
                    << ", exceed the little cores size: " << little_core_size
                    << ", truncate thread num to " << little_core_size;
-      active_ids_ = little_core_ids_;
+      *active_ids = little_core_ids_;
     } else {
       for (int i = 0; i < thread_num; ++i) {
-        active_ids_.push_back(
+        active_ids->push_back(
             little_core_ids_[(i + shift_num) % little_core_size]);
       }
     }
   } else {
-    mode_ = lite_api::PowerMode::LITE_POWER_HIGH;
+    *mode = lite_api::PowerMode::LITE_POWER_HIGH;
     LOG(WARNING) << "LOW POWER MODE is not support, switch to big cores.";
     if (thread_num > big_core_size) {
-      active_ids_ = big_core_ids_;
+      *active_ids = big_core_ids_;
     } else {
       for (int i = 0; i < thread_num; ++i) {
-        active_ids_.push_back(big_core_ids_[i]);
+        active_ids->push_back(big_core_ids_[i]);
       }
     }
   }
@@ -1035,8 +1052,11 @@ int DeviceInfo::Setup() {
   return 0;
 }
 
-void DeviceInfo::SetRunMode(lite_api::PowerMode mode, int thread_num) {
-#ifdef ARM_WITH_OMP
+void DeviceInfo::GetRunMode(lite_api::PowerMode mode,
+                            int thread_num,
+                            lite_api::PowerMode* real_mode,
+                            std::vector<int>* active_ids) {
+#if defined(ARM_WITH_OMP) || defined(LITE_WITH_THREAD_POOL)
   thread_num = std::min(thread_num, core_num_);
 #else
   thread_num = 1;  // force thread_num to 1 if OpenMP is disabled
@@ -1046,52 +1066,75 @@ void DeviceInfo::SetRunMode(lite_api::PowerMode mode, int thread_num) {
   int little_core_size = little_core_ids_.size();
   int big_little_core_size = big_core_size + little_core_size;
   thread_num = std::min(thread_num, big_little_core_size);
-  count_++;
-  int shift_num = (count_ / 10) % big_core_size;
+  int64_t count = ++count_;
+  int shift_num = (count / 10) % big_core_size;
   switch (mode) {
     case lite_api::LITE_POWER_FULL:
-      RequestPowerFullMode(thread_num);
+      RequestPowerFullMode(thread_num, real_mode, active_ids);
       break;
     case lite_api::LITE_POWER_HIGH:
-      RequestPowerHighMode(thread_num);
+      RequestPowerHighMode(thread_num, real_mode, active_ids);
       break;
     case lite_api::LITE_POWER_LOW:
-      RequestPowerLowMode(thread_num);
+      RequestPowerLowMode(thread_num, real_mode, active_ids);
       break;
     case lite_api::LITE_POWER_NO_BIND:
-      RequestPowerNoBindMode(thread_num);
+      RequestPowerNoBindMode(thread_num, real_mode, active_ids);
       break;
     case lite_api::LITE_POWER_RAND_HIGH:
-      RequestPowerRandHighMode(shift_num, thread_num);
+      RequestPowerRandHighMode(shift_num, thread_num, real_mode, active_ids);
       break;
     case lite_api::LITE_POWER_RAND_LOW:
-      RequestPowerRandLowMode(shift_num, thread_num);
+      RequestPowerRandLowMode(shift_num, thread_num, real_mode, active_ids);
       break;
     default:
       LOG(FATAL) << "Unsupported power mode: " << mode;
       break;
   }
-  if (active_ids_.empty()) {
-    active_ids_.push_back(0);
+  if (active_ids->empty()) {
+    active_ids->push_back(0);
   }
-#ifdef ARM_WITH_OMP
-  omp_set_num_threads(active_ids_.size());
-#endif
-  if (mode_ != lite_api::LITE_POWER_NO_BIND) {
-    if (check_cpu_online(active_ids_)) {
-      bind_threads(active_ids_);
-    } else {
-      LOG(WARNING) << "Some cores are offline, switch to NO BIND MODE";
-      mode_ = lite_api::LITE_POWER_NO_BIND;
-    }
+  if (*real_mode != lite_api::LITE_POWER_NO_BIND &&
+      !check_cpu_online(*active_ids)) {
+    LOG(WARNING) << "Some cores are offline, switch to NO BIND MODE";
+    *real_mode = lite_api::LITE_POWER_NO_BIND;
   }
 #else  // LITE_WITH_LINUX
   // only LITE_POWER_NO_BIND is supported in other OS
-  RequestPowerNoBindMode(thread_num);
+  RequestPowerNoBindMode(thread_num, real_mode, active_ids);
+#endif  // LITE_WITH_LINUX
+}
+
+void DeviceInfo::BindRunMode(lite_api::PowerMode mode,
+                             const std::vector<int>& active_ids) const {
 #ifdef ARM_WITH_OMP
-  omp_set_num_threads(active_ids_.size());
+  omp_set_num_threads(active_ids.size());
 #endif
+#ifdef LITE_WITH_LINUX
+  if (mode != lite_api::LITE_POWER_NO_BIND) {
+    bind_threads(active_ids);
+  }
 #endif  // LITE_WITH_LINUX
+#ifdef LITE_WITH_THREAD_POOL
+  // The workers are bound to the active cores other than the first one, which
+  // the current thread is bound to.
+  std::vector<int> pool_cpu_ids;
+  if (mode != lite_api::LITE_POWER_NO_BIND) {
+    pool_cpu_ids = active_ids;
+  }
+  std::vector<int> pool_cluster_ids;
+  for (int id : active_ids) {
+    pool_cluster_ids.push_back(
+        id < static_cast<int>(cluster_ids_.size()) ? cluster_ids_[id] : 0);
+  }
+  WorkStealingPool::SetCurrent(WorkStealingPool::Shared(
+      active_ids.size(), pool_cpu_ids, pool_cluster_ids));
+#endif  // LITE_WITH_THREAD_POOL
+}
+
+void DeviceInfo::SetRunMode(lite_api::PowerMode mode, int thread_num) {
+  GetRunMode(mode, thread_num, &mode_, &active_ids_);
+  BindRunMode(mode_, active_ids_);
   //! alloc memory for sgemm in this context
   workspace_.Resize({llc_size()});
   workspace_.mutable_data<int8_t>();
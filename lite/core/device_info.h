@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdarg>
 #include <string>
 #include <vector>
@@ -37,6 +38,10 @@ typedef enum {
   kARMArch_UNKOWN = -1
 } ARMArch;
 
+// The hardware info and the default run mode of the process. A predictor may
+// run with its own run mode, which is resolved by `GetRunMode`, kept in the
+// ARM contexts of its kernels and bound to the threads running it by
+// `BindRunMode`, see RuntimeProgram::SetRunMode.
 class DeviceInfo {
  public:
   static DeviceInfo& Global() {
@@ -51,23 +56,43 @@ class DeviceInfo {
 
   int Setup();
 
+  // Set the default run mode, and bind the current thread to it.
   void SetRunMode(lite_api::PowerMode mode, int thread_num);
+  // Resolve the power mode and the active cores of a run mode, without
+  // changing the default one.
+  void GetRunMode(lite_api::PowerMode mode,
+                  int thread_num,
+                  lite_api::PowerMode* real_mode,
+                  std::vector<int>* active_ids);
+  // Bind the current thread to the active cores, and set the threads of
+  // OpenMP or the thread pool used by the current thread.
+  void BindRunMode(lite_api::PowerMode mode,
+                   const std::vector<int>& active_ids) const;
   void SetCache(int l1size, int l2size, int l3size);
   void SetArch(ARMArch arch) { arch_ = arch; }
 
   lite_api::PowerMode mode() const { return mode_; }
   int threads() const { return active_ids_.size(); }
+  const std::vector<int>& active_ids() const { return active_ids_; }
   ARMArch arch() const { return arch_; }
-  int l1_cache_size() const { return L1_cache_[active_ids_[0]]; }
-  int l2_cache_size() const { return L2_cache_[active_ids_[0]]; }
-  int l3_cache_size() const { return L3_cache_[active_ids_[0]]; }
-  int llc_size() const {
-    auto size = L3_cache_[active_ids_[0]] > 0 ? L3_cache_[active_ids_[0]]
-                                              : L2_cache_[active_ids_[0]];
+  int l1_cache_size() const { return l1_cache_size(active_ids_[0]); }
+  int l2_cache_size() const { return l2_cache_size(active_ids_[0]); }
+  int l3_cache_size() const { return l3_cache_size(active_ids_[0]); }
+  int llc_size() const { return llc_size(active_ids_[0]); }
+  bool has_dot() const { return has_dot(active_ids_[0]); }
+  bool has_fp16() const { return has_fp16(active_ids_[0]); }
+
+  // The info of a core.
+  ARMArch arch(int core) const { return archs_[core]; }
+  int l1_cache_size(int core) const { return L1_cache_[core]; }
+  int l2_cache_size(int core) const { return L2_cache_[core]; }
+  int l3_cache_size(int core) const { return L3_cache_[core]; }
+  int llc_size(int core) const {
+    auto size = L3_cache_[core] > 0 ? L3_cache_[core] : L2_cache_[core];
     return size > 0 ? size : 512 * 1024;
   }
-  bool has_dot() const { return dot_[active_ids_[0]]; }
-  bool has_fp16() const { return fp16_[active_ids_[0]]; }
+  bool has_dot(int core) const { return dot_[core]; }
+  bool has_fp16(int core) const { return fp16_[core]; }
 
   template <typename T>
   T* workspace_data() {
@@ -101,7 +126,8 @@ class DeviceInfo {
   lite_api::PowerMode mode_;
   std::vector<int> active_ids_;
   TensorLite workspace_;
-  int64_t count_{0};
+  // The run modes resolved, to shift the cores of the RAND modes.
+  std::atomic<int64_t> count_{0};
 
   void SetDotInfo(int argc, ...);
   void SetFP16Info(int argc, ...);
@@ -110,12 +136,26 @@ class DeviceInfo {
   void SetArchInfo(int argc, ...);
   bool SetCPUInfoByName();
   void SetCPUInfoByProb();
-  void RequestPowerFullMode(int thread_num);
-  void RequestPowerHighMode(int thread_num);
-  void RequestPowerLowMode(int thread_num);
-  void RequestPowerNoBindMode(int thread_num);
-  void RequestPowerRandHighMode(int shift_num, int thread_num);
-  void RequestPowerRandLowMode(int shift_num, int thread_num);
+  void RequestPowerFullMode(int thread_num,
+                            lite_api::PowerMode* mode,
+                            std::vector<int>* active_ids) const;
+  void RequestPowerHighMode(int thread_num,
+                            lite_api::PowerMode* mode,
+                            std::vector<int>* active_ids) const;
+  void RequestPowerLowMode(int thread_num,
+                           lite_api::PowerMode* mode,
+                           std::vector<int>* active_ids) const;
+  void RequestPowerNoBindMode(int thread_num,
+                              lite_api::PowerMode* mode,
+                              std::vector<int>* active_ids) const;
+  void RequestPowerRandHighMode(int shift_num,
+                                int thread_num,
+                                lite_api::PowerMode* mode,
+                                std::vector<int>* active_ids) const;
+  void RequestPowerRandLowMode(int shift_num,
+                               int thread_num,
+                               lite_api::PowerMode* mode,
+                               std::vector<int>* active_ids) const;
 
   DeviceInfo() = default;
 };
@@ -48,6 +48,11 @@ class KernelBase {
   /// `SetContext`, that is both the param_ and context_ are valid.
   virtual void PrepareForRun() {}
 
+  /// Re-initialize the kernel if needed before each `Run`, such as re-select
+  /// the algorithm or re-pack the weights when the input shapes changed. It is
+  /// invoked in every run, so the check should be cheap.
+  virtual void ReInitWhenNeeded() {}
+
   /// Run the kernel. Before Run, both the param_ and context_ should be valid.
   virtual void Run() = 0;
 
@@ -57,16 +62,15 @@ class KernelBase {
       PrepareForRun();
       is_first_epoch_ = false;
     }
+    ReInitWhenNeeded();
+    ResetWorkSpaces();
+    Run();
+  }
 
-    // Reset the workspace to make every kernel in the same thread to share the
-    // temporary memory.
-    WorkSpace::Global_Host().AllocReset();
-#if defined(LITE_WITH_X86)
-    WorkSpace::Global_X86().AllocReset();
-#endif
-#if defined(LITE_WITH_CUDA)
-    WorkSpace::Global_CUDA().AllocReset();
-#endif
+  // Launch the kernel launched before with the same input shapes, the
+  // preparation and the re-initialization are skipped.
+  void LaunchPrepared() {
+    ResetWorkSpaces();
     Run();
   }
 
@@ -97,6 +101,11 @@ class KernelBase {
     return nullptr;
   }
 
+  // Whether the output "Out" can be computed in the buffer of the input "X",
+  // that is each output element is computed after the input element of the
+  // same index is read, and no other input element is read after it.
+  virtual bool SupportsInplace() const { return false; }
+
   void set_op_type(const std::string& type) { op_type_ = type; }
   const std::string& op_type() const { return op_type_; }
 
@@ -143,6 +152,19 @@ class KernelBase {
   virtual ~KernelBase() = default;
   void Torch() {}
 
+ private:
+  // Reset the workspace to make every kernel in the same thread to share the
+  // temporary memory.
+  void ResetWorkSpaces() {
+    WorkSpace::Global_Host().AllocReset();
+#if defined(LITE_WITH_X86)
+    WorkSpace::Global_X86().AllocReset();
+#endif
+#if defined(LITE_WITH_CUDA)
+    WorkSpace::Global_CUDA().AllocReset();
+#endif
+  }
+
  protected:
   std::unique_ptr<KernelContext> ctx_{nullptr};
   mutable operators::param_t param_;
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/core/memory.h"
+#include "lite/core/memory_pool.h"
 
 namespace paddle {
 namespace lite {
@@ -23,7 +24,7 @@ void* TargetMalloc(TargetType target, size_t size) {
     case TargetType::kHost:
     case TargetType::kX86:
     case TargetType::kARM:
-      data = TargetWrapper<TARGET(kHost)>::Malloc(size);
+      data = HostMemoryPool::Global().Malloc(size);
       break;
 #ifdef LITE_WITH_CUDA
     case TargetType::kCUDA:
@@ -51,7 +52,7 @@ void TargetFree(TargetType target, void* data) {
     case TargetType::kHost:
     case TargetType::kX86:
     case TargetType::kARM:
-      TargetWrapper<TARGET(kHost)>::Free(data);
+      HostMemoryPool::Global().Free(data);
       break;
 
 #ifdef LITE_WITH_CUDA
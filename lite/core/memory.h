@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <memory>
 #include "lite/api/paddle_place.h"
 #include "lite/core/target_wrapper.h"
 #include "lite/utils/macros.h"
@@ -71,15 +72,30 @@ class Buffer {
  public:
   Buffer() = default;
   Buffer(TargetType target, size_t size) : space_(size), target_(target) {}
+  // Create a buffer that refers to an external memory, the memory is not owned
+  // and will not be freed by this buffer. Once it needs to grow, a new memory
+  // owned by this buffer will be allocated. The holder, if any, keeps the
+  // external memory alive while this buffer refers to it.
+  Buffer(void* data,
+         TargetType target,
+         size_t size,
+         const std::shared_ptr<void>& holder = nullptr)
+      : space_(size),
+        data_(data),
+        own_data_(false),
+        target_(target),
+        holder_(holder) {}
 
   void* data() const { return data_; }
   TargetType target() const { return target_; }
   size_t space() const { return space_; }
+  bool own_data() const { return own_data_; }
 
   void ResetLazy(TargetType target, size_t size) {
     if (target != target_ || space_ < size) {
       Free();
       data_ = TargetMalloc(target, size);
+      own_data_ = true;
       target_ = target;
       space_ = size;
     }
@@ -88,11 +104,14 @@ class Buffer {
   void ResizeLazy(size_t size) { ResetLazy(target_, size); }
 
   void Free() {
-    if (space_ > 0) {
+    if (space_ > 0 && own_data_) {
       TargetFree(target_, data_);
     }
+    data_ = nullptr;
+    own_data_ = true;
     target_ = TargetType::kHost;
     space_ = 0;
+    holder_.reset();
   }
 
   void CopyDataFrom(const Buffer& other, size_t nbytes) {
@@ -108,7 +127,9 @@ class Buffer {
   // memory it actually malloced.
   size_t space_{0};
   void* data_{nullptr};
+  bool own_data_{true};
   TargetType target_{TargetType::kHost};
+  std::shared_ptr<void> holder_;
 };
 
 }  // namespace lite
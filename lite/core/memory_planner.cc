@@ -0,0 +1,377 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/memory_planner.h"
+#include <algorithm>
+#include <set>
+
+namespace paddle {
+namespace lite {
+
+namespace {
+
+size_t AlignUp(size_t x, size_t alignment) {
+  return (x + alignment - 1) / alignment * alignment;
+}
+
+bool IsHostTarget(TargetType target) {
+  return target == TARGET(kHost) || target == TARGET(kX86) ||
+         target == TARGET(kARM);
+}
+
+}  // namespace
+
+bool IsOpMemoryReusable(const OpLite& op) {
+  static const std::set<std::string> invalid_op_types(
+      {"feed", "fetch", "while", "conditional_block"});
+  auto* op_info = op.op_info();
+  CHECK(op_info);
+  if (invalid_op_types.count(op_info->Type())) return false;
+  if (op.run_once()) return false;
+  if (op_info->HasAttr("inplace") && op_info->GetAttr<bool>("inplace")) {
+    return false;
+  }
+  return true;
+}
+
+void MemoryPlanner::Init(const std::vector<const OpLite*>& ops,
+                         Scope* exec_scope) {
+  CHECK(exec_scope);
+  ops_ = ops;
+  exec_scope_ = exec_scope;
+  lifecycles_.clear();
+  writers_.clear();
+  slots_.clear();
+  misses_.clear();
+  arena_size_ = 0;
+  planned_ = false;
+
+  std::set<std::string> invalid_var_names;
+  for (size_t i = 0; i < ops_.size(); ++i) {
+    bool reusable = IsOpMemoryReusable(*ops_[i]);
+    auto visit = [&](const std::string& name, bool is_output) {
+      if (is_output) writers_[name].push_back(i);
+      auto* var = exec_scope_->FindLocalVar(name);
+      if (!reusable || !var || !var->IsType<lite::Tensor>()) {
+        invalid_var_names.insert(name);
+        return;
+      }
+      auto it = lifecycles_.find(name);
+      if (it == lifecycles_.end()) {
+        // A temporary variable read before written comes from outside.
+        if (!is_output) invalid_var_names.insert(name);
+        lifecycles_.emplace(name, lifecycle_t(i, i));
+      } else {
+        it->second.second = i;
+      }
+    };
+    auto* op_info = ops_[i]->op_info();
+    for (auto& name : op_info->input_names()) visit(name, false);
+    for (auto& name : op_info->output_names()) visit(name, true);
+  }
+  for (auto& name : invalid_var_names) {
+    lifecycles_.erase(name);
+  }
+}
+
+void MemoryPlanner::Plan() {
+  CHECK(exec_scope_) << "MemoryPlanner should be initialized first";
+  // The tensor that keeps leaving its slot without outgrowing it, such as
+  // sharing the data with others, will not be planned any more.
+  if (arena_) {
+    for (auto& item : slots_) {
+      auto* tensor =
+          exec_scope_->FindLocalVar(item.first)->GetMutable<lite::Tensor>();
+      auto* slot_data =
+          static_cast<char*>(arena_->data()) + item.second.offset;
+      if (tensor->raw_data() != slot_data &&
+          tensor->memory_size() <= item.second.size &&
+          ++misses_[item.first] > 1) {
+        VLOG(3) << "tensor " << item.first << " excluded from memory plan";
+        lifecycles_.erase(item.first);
+      }
+    }
+  }
+
+  // The whole tensor of a concat or split is alive as long as its parts.
+  auto views = CollectViews();
+  auto lifecycles = lifecycles_;
+  for (auto& item : views) {
+    auto& whole = lifecycles[item.second.whole];
+    auto& part = lifecycles_.at(item.first);
+    whole.first = std::min(whole.first, part.first);
+    whole.second = std::max(whole.second, part.second);
+  }
+
+  struct Item {
+    std::string name;
+    size_t size;
+    lifecycle_t lifecycle;
+  };
+  std::vector<Item> items;
+  for (auto& item : lifecycles) {
+    if (views.count(item.first)) continue;
+    auto* tensor =
+        exec_scope_->FindLocalVar(item.first)->GetMutable<lite::Tensor>();
+    if (!IsHostTarget(tensor->target()) || tensor->memory_size() == 0) {
+      continue;
+    }
+    items.push_back(Item{item.first,
+                         AlignUp(tensor->memory_size(), kAlignment),
+                         item.second});
+  }
+  std::stable_sort(
+      items.begin(), items.end(), [](const Item& a, const Item& b) {
+        return a.size > b.size;
+      });
+
+  slots_.clear();
+  arena_size_ = 0;
+  std::vector<const Item*> placed;
+  for (auto& item : items) {
+    // The placed tensors alive at the same time, sorted by offset.
+    std::vector<const Item*> alive;
+    for (auto* x : placed) {
+      if (x->lifecycle.first <= item.lifecycle.second &&
+          item.lifecycle.first <= x->lifecycle.second) {
+        alive.push_back(x);
+      }
+    }
+    std::sort(alive.begin(), alive.end(), [&](const Item* a, const Item* b) {
+      return slots_[a->name].offset < slots_[b->name].offset;
+    });
+    // Place the tensor at the lowest offset that fits.
+    size_t offset = 0;
+    for (auto* x : alive) {
+      auto& slot = slots_[x->name];
+      if (slot.offset >= offset + item.size) break;
+      offset = std::max(offset, slot.offset + slot.size);
+    }
+    slots_[item.name] = Slot{offset, item.size};
+    arena_size_ = std::max(arena_size_, offset + item.size);
+    placed.push_back(&item);
+  }
+  for (auto& item : views) {
+    auto* tensor =
+        exec_scope_->FindLocalVar(item.first)->GetMutable<lite::Tensor>();
+    slots_[item.first] = Slot{
+        slots_.at(item.second.whole).offset + item.second.offset,
+        tensor->memory_size()};
+  }
+  planned_ = true;
+
+  size_t total_bytes = 0;
+  for (auto& item : items) total_bytes += item.size;
+  VLOG(3) << "memory plan: " << items.size() << " tensors, " << total_bytes
+          << " bytes packed into a " << arena_size_ << " bytes arena, "
+          << views.size() << " concat/split parts inside the whole tensors";
+}
+
+std::map<std::string, MemoryPlanner::View> MemoryPlanner::CollectViews()
+    const {
+  std::map<std::string, View> views;
+  // A whole tensor can be shared by several groups, such as a concat followed
+  // by a split, but a part is in one group only, and not split further.
+  std::set<std::string> grouped_wholes;
+  std::set<std::string> grouped_parts;
+  for (size_t i = 0; i < ops_.size(); ++i) {
+    auto* op_info = ops_[i]->op_info();
+    bool is_concat = op_info->Type() == "concat";
+    if (!is_concat && op_info->Type() != "split") continue;
+    if (!op_info->HasInput("X") || !op_info->HasOutput("Out") ||
+        !op_info->HasAttr("axis")) {
+      continue;
+    }
+    auto x_names = op_info->Input("X");
+    auto out_names = op_info->Output("Out");
+    // The axis or sections fed by tensors are not known ahead of the run.
+    if (op_info->input_names().size() != x_names.size()) continue;
+    auto& wholes = is_concat ? out_names : x_names;
+    auto& parts = is_concat ? x_names : out_names;
+    if (wholes.size() != 1 || parts.size() < 2) continue;
+    auto& whole = wholes.front();
+
+    // The parts are distinct. The inputs are written only before the op, and
+    // the outputs only by it, so the data in the slot of the whole tensor is
+    // not changed after the op.
+    std::set<std::string> members(parts.begin(), parts.end());
+    members.insert(whole);
+    bool valid = members.size() == parts.size() + 1;
+    for (auto& name : members) {
+      if (!valid) break;
+      auto it = writers_.find(name);
+      valid = lifecycles_.count(name) && it != writers_.end() &&
+              !grouped_parts.count(name) &&
+              (name == whole || !grouped_wholes.count(name));
+      bool is_input = is_concat ? name != whole : name == whole;
+      for (size_t j = 0; valid && j < it->second.size(); ++j) {
+        valid = is_input ? it->second[j] < static_cast<int>(i)
+                         : it->second[j] == static_cast<int>(i);
+      }
+    }
+    if (!valid) continue;
+
+    // The parts are contiguous in the whole tensor only if the dims before
+    // the axis are all 1.
+    auto* whole_tensor =
+        exec_scope_->FindLocalVar(whole)->GetMutable<lite::Tensor>();
+    auto& dims = whole_tensor->dims();
+    int axis = op_info->GetAttr<int>("axis");
+    if (axis < 0) axis += static_cast<int>(dims.size());
+    if (axis < 0 || axis >= static_cast<int>(dims.size())) continue;
+    int64_t outer = 1;
+    for (int j = 0; j < axis; ++j) outer *= dims[j];
+    if (outer != 1 || !IsHostTarget(whole_tensor->target()) ||
+        whole_tensor->memory_size() == 0) {
+      continue;
+    }
+    std::map<std::string, View> group;
+    size_t offset = 0;
+    for (auto& name : parts) {
+      auto* tensor =
+          exec_scope_->FindLocalVar(name)->GetMutable<lite::Tensor>();
+      // The parts have the same target and element size as the whole.
+      if (tensor->target() != whole_tensor->target() ||
+          tensor->memory_size() == 0 ||
+          tensor->memory_size() * static_cast<size_t>(dims.production()) !=
+              whole_tensor->memory_size() *
+                  static_cast<size_t>(tensor->dims().production())) {
+        break;
+      }
+      group[name] = View{whole, offset};
+      offset += tensor->memory_size();
+    }
+    if (group.size() != parts.size() ||
+        offset != whole_tensor->memory_size()) {
+      continue;
+    }
+    views.insert(group.begin(), group.end());
+    grouped_wholes.insert(whole);
+    grouped_parts.insert(parts.begin(), parts.end());
+  }
+  return views;
+}
+
+bool MemoryPlanner::LoadPlan() {
+  CHECK(exec_scope_) << "MemoryPlanner should be initialized first";
+  slots_.clear();
+  arena_size_ = 0;
+  for (auto* op : ops_) {
+    auto* op_info = op->op_info();
+    if (!op_info->HasAttr(kMemoryPlanVarsAttr) ||
+        !op_info->HasAttr(kMemoryPlanSlotsAttr)) {
+      continue;
+    }
+    auto names =
+        op_info->GetAttr<std::vector<std::string>>(kMemoryPlanVarsAttr);
+    auto values =
+        op_info->GetAttr<std::vector<int64_t>>(kMemoryPlanSlotsAttr);
+    CHECK_EQ(values.size(), 2 * names.size()) << "invalid memory plan";
+    for (size_t i = 0; i < names.size(); ++i) {
+      if (!lifecycles_.count(names[i])) {
+        VLOG(3) << "the persisted memory plan is out of date";
+        slots_.clear();
+        arena_size_ = 0;
+        return false;
+      }
+      Slot slot{static_cast<size_t>(values[2 * i]),
+                static_cast<size_t>(values[2 * i + 1])};
+      slots_[names[i]] = slot;
+      arena_size_ = std::max(arena_size_, slot.offset + slot.size);
+    }
+  }
+  planned_ = !slots_.empty();
+  return planned_;
+}
+
+void MemoryPlanner::SavePlan(std::vector<cpp::OpDesc*>* op_descs) const {
+  CHECK(op_descs);
+  CHECK_EQ(op_descs->size(), ops_.size());
+  if (!planned_) return;
+  for (size_t i = 0; i < ops_.size(); ++i) {
+    std::vector<std::string> names;
+    std::vector<int64_t> values;
+    for (auto& item : slots_) {
+      if (lifecycles_.at(item.first).first != static_cast<int>(i)) continue;
+      names.push_back(item.first);
+      values.push_back(static_cast<int64_t>(item.second.offset));
+      values.push_back(static_cast<int64_t>(item.second.size));
+    }
+    auto* desc = op_descs->at(i);
+    if (names.empty() && !desc->HasAttr(kMemoryPlanVarsAttr)) continue;
+    desc->SetAttr(kMemoryPlanVarsAttr, names);
+    desc->SetAttr(kMemoryPlanSlotsAttr, values);
+  }
+}
+
+void MemoryPlanner::Apply() {
+#ifdef LITE_WITH_FPGA
+  // The FPGA tensor manages its memory by itself.
+  slots_.clear();
+  arena_size_ = 0;
+#else
+  if (!planned_) return;
+  auto arena = std::make_shared<Buffer>();
+  arena->ResetLazy(TARGET(kHost), arena_size_);
+  for (auto& item : slots_) {
+    auto* tensor =
+        exec_scope_->FindLocalVar(item.first)->GetMutable<lite::Tensor>();
+    std::shared_ptr<Buffer> buffer(
+        new Buffer(static_cast<char*>(arena->data()) + item.second.offset,
+                   tensor->target(),
+                   item.second.size));
+    tensor->ResetBuffer(buffer,
+                        std::min(tensor->memory_size(), item.second.size));
+  }
+  // Release the previous arena after all the tensors leave it.
+  arena_ = arena;
+#endif  // LITE_WITH_FPGA
+}
+
+void MemoryPlanner::Exclude(const std::vector<std::string>& names) {
+  for (auto& name : names) {
+    lifecycles_.erase(name);
+    auto it = slots_.find(name);
+    if (it == slots_.end()) continue;
+#ifndef LITE_WITH_FPGA
+    if (arena_) {
+      auto* tensor =
+          exec_scope_->FindLocalVar(name)->GetMutable<lite::Tensor>();
+      auto* slot_data = static_cast<char*>(arena_->data()) + it->second.offset;
+      if (tensor->raw_data() == slot_data && tensor->memory_size() > 0) {
+        std::shared_ptr<Buffer> buffer(new Buffer);
+        buffer->CopyDataFrom(*tensor->buffer(), tensor->memory_size());
+        tensor->ResetBuffer(buffer, tensor->memory_size());
+      }
+    }
+#endif  // LITE_WITH_FPGA
+    VLOG(3) << "tensor " << name << " excluded from memory plan";
+    slots_.erase(it);
+  }
+}
+
+bool MemoryPlanner::IsValid() const {
+  if (!planned_) return false;
+  if (!arena_) return slots_.empty();
+  for (auto& item : slots_) {
+    auto* tensor =
+        exec_scope_->FindLocalVar(item.first)->GetMutable<lite::Tensor>();
+    auto* slot_data = static_cast<char*>(arena_->data()) + item.second.offset;
+    if (tensor->raw_data() != slot_data) return false;
+  }
+  return true;
+}
+
+}  // namespace lite
+}  // namespace paddle
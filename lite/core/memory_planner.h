@@ -0,0 +1,121 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/memory.h"
+#include "lite/core/op_lite.h"
+#include "lite/core/scope.h"
+
+namespace paddle {
+namespace lite {
+
+// The attributes to persist the memory plan in the optimized model. Each op
+// records the variables whose lifetime begins at it, and the (offset, size)
+// pairs of them in the arena.
+static const char kMemoryPlanVarsAttr[] = "__@memory_plan_vars@__";
+static const char kMemoryPlanSlotsAttr[] = "__@memory_plan_slots@__";
+
+// Whether the arguments of an op can be placed in a shared memory. The
+// feed/fetch ops share the buffers with the feed/fetch lists, the control flow
+// ops access the variables inside their sub-blocks, the outputs of the
+// run-once ops should be kept across the runs, and the in-place kernels such
+// as reshape share the input buffer with the output.
+bool IsOpMemoryReusable(const OpLite& op);
+
+/*
+ * MemoryPlanner packs all the temporary host tensors of a program into a
+ * single arena. The lifetime of each tensor is its first and last access in
+ * the execution order, the offsets are assigned by the greedy-by-size
+ * strategy, that is, the larger tensors are placed first at the lowest offset
+ * that does not conflict with the placed tensors alive at the same time.
+ *
+ * The inputs of a concat and the outputs of a split that are contiguous parts
+ * of the whole tensor (the dims before the axis are all 1) are placed inside
+ * the slot of the whole tensor, so the producers of a concat write into its
+ * output and the consumers of a split read from its input, and the kernels
+ * skip the copies of the parts already in place.
+ *
+ * Each planned tensor refers to its slot in the arena by a non-owning Buffer,
+ * so the tensor that outgrows its slot (the input shapes changed) allocates a
+ * memory of its own, and the plan becomes invalid and should be re-planned
+ * with the latest sizes.
+ */
+class MemoryPlanner {
+ public:
+  // The alignment of the slots in the arena.
+  static constexpr size_t kAlignment = 64;
+
+  struct Slot {
+    size_t offset;
+    size_t size;
+  };
+
+  // Collect the temporary tensors and their lifetimes from the ops, in the
+  // execution order.
+  void Init(const std::vector<const OpLite*>& ops, Scope* exec_scope);
+
+  // Plan with the current memory sizes of the tensors.
+  void Plan();
+  // Restore the plan persisted in the op attributes, return false if no valid
+  // plan found.
+  bool LoadPlan();
+  // Persist the plan into the op descs, the i-th desc corresponds to the i-th
+  // op passed to `Init`.
+  void SavePlan(std::vector<cpp::OpDesc*>* op_descs) const;
+
+  // Allocate the arena and point the tensors into it.
+  void Apply();
+  // Whether all the planned tensors still live in the arena.
+  bool IsValid() const;
+  // Take the variables out of the plan, the tensors in the arena are moved
+  // into their own memory with the data kept. The plan stays valid.
+  void Exclude(const std::vector<std::string>& names);
+
+  bool planned() const { return planned_; }
+  size_t planned_peak_bytes() const { return arena_size_; }
+  const std::map<std::string, Slot>& slots() const { return slots_; }
+
+ private:
+  // [first, last] index of the ops that access a variable.
+  using lifecycle_t = std::pair<int, int>;
+
+  // A part placed at `offset` bytes in the slot of the whole tensor.
+  struct View {
+    std::string whole;
+    size_t offset;
+  };
+  // Find the parts of the concat and split ops that can be placed inside the
+  // whole tensor with the current shapes.
+  std::map<std::string, View> CollectViews() const;
+
+  std::vector<const OpLite*> ops_;
+  Scope* exec_scope_{};
+  std::map<std::string, lifecycle_t> lifecycles_;
+  // The index of the ops that write a variable.
+  std::map<std::string, std::vector<int>> writers_;
+  std::map<std::string, Slot> slots_;
+  // The times a tensor leaves its slot without outgrowing it.
+  std::map<std::string, int> misses_;
+  size_t arena_size_{0};
+  std::shared_ptr<Buffer> arena_;
+  bool planned_{false};
+};
+
+}  // namespace lite
+}  // namespace paddle
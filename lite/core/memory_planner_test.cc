@@ -0,0 +1,232 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/memory_planner.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+// An op that just creates its arguments in the scope.
+class FakeOp : public OpLite {
+ public:
+  FakeOp() : OpLite("fake") {}
+
+  bool AttachImpl(const cpp::OpDesc& opdesc, lite::Scope* scope) override {
+    for (auto& name : op_info()->input_names()) {
+      scope->Var(name)->GetMutable<Tensor>();
+    }
+    for (auto& name : op_info()->output_names()) {
+      scope->Var(name)->GetMutable<Tensor>();
+    }
+    return true;
+  }
+  void AttachKernel(KernelBase* kernel) override {}
+  std::string DebugString() const override { return "fake"; }
+};
+
+// The scope and the ops of a fake program.
+class MemoryPlannerTestBase : public ::testing::Test {
+ protected:
+  void AddOp(const std::string& type,
+             const std::vector<std::string>& inputs,
+             const std::vector<std::string>& outputs) {
+    cpp::OpDesc desc;
+    desc.SetType(type);
+    desc.SetInput("X", inputs);
+    desc.SetOutput("Out", outputs);
+    desc.SetAttr<int>("axis", 1);
+    std::shared_ptr<OpLite> op(new FakeOp);
+    op->Attach(desc, &scope_);
+    ops_.push_back(op);
+  }
+
+  std::vector<const OpLite*> ops() const {
+    std::vector<const OpLite*> res;
+    for (auto& op : ops_) res.push_back(op.get());
+    return res;
+  }
+
+  Scope scope_;
+  std::vector<std::shared_ptr<OpLite>> ops_;
+};
+
+// x -> op0 -> a -> op1 -> b -> op2 -> c -> op3 -> d
+class MemoryPlannerTest : public MemoryPlannerTestBase {
+ protected:
+  void SetUp() override {
+    std::vector<std::string> vars({"x", "a", "b", "c", "d"});
+    for (size_t i = 0; i + 1 < vars.size(); ++i) {
+      AddOp("fake", {vars[i]}, {vars[i + 1]});
+    }
+  }
+
+  // Run the fake program, every tensor has `numel` floats.
+  void Run(int64_t numel) {
+    for (auto& name : {"a", "b", "c", "d"}) {
+      auto* tensor = scope_.FindMutableTensor(name);
+      tensor->Resize({numel});
+      tensor->mutable_data<float>();
+    }
+  }
+};
+
+TEST_F(MemoryPlannerTest, plan) {
+  MemoryPlanner planner;
+  planner.Init(ops(), &scope_);
+  Run(1024);
+  ASSERT_FALSE(planner.IsValid());
+  planner.Plan();
+  planner.Apply();
+  ASSERT_TRUE(planner.IsValid());
+
+  // x comes from outside, so it is not planned.
+  auto& slots = planner.slots();
+  ASSERT_EQ(slots.size(), 4UL);
+  ASSERT_FALSE(slots.count("x"));
+  // Two tensors at most alive at the same time.
+  ASSERT_EQ(planner.planned_peak_bytes(), 2 * 1024 * sizeof(float));
+  for (auto& pair : std::vector<std::pair<std::string, std::string>>(
+           {{"a", "b"}, {"b", "c"}, {"c", "d"}})) {
+    auto& x = slots.at(pair.first);
+    auto& y = slots.at(pair.second);
+    ASSERT_TRUE(x.offset + x.size <= y.offset || y.offset + y.size <= x.offset);
+  }
+
+  // No more allocation with the same shapes.
+  Run(1024);
+  ASSERT_TRUE(planner.IsValid());
+
+  // A tensor outgrows its slot, re-plan it.
+  Run(2048);
+  ASSERT_FALSE(planner.IsValid());
+  planner.Plan();
+  planner.Apply();
+  ASSERT_TRUE(planner.IsValid());
+  ASSERT_EQ(planner.planned_peak_bytes(), 2 * 2048 * sizeof(float));
+}
+
+TEST_F(MemoryPlannerTest, exclude) {
+  MemoryPlanner planner;
+  planner.Init(ops(), &scope_);
+  Run(1024);
+  planner.Plan();
+  planner.Apply();
+  auto* b = scope_.FindMutableTensor("b");
+  auto* b_data = b->mutable_data<float>();
+  for (int i = 0; i < 1024; ++i) b_data[i] = i;
+
+  // b leaves the arena with its data.
+  planner.Exclude({"b"});
+  ASSERT_EQ(planner.slots().size(), 3UL);
+  ASSERT_FALSE(planner.slots().count("b"));
+  ASSERT_NE(b->data<float>(), b_data);
+  for (int i = 0; i < 1024; ++i) ASSERT_EQ(b->data<float>()[i], i);
+  Run(1024);
+  ASSERT_TRUE(planner.IsValid());
+
+  // b is not planned any more.
+  planner.Plan();
+  ASSERT_FALSE(planner.slots().count("b"));
+}
+
+TEST_F(MemoryPlannerTest, save_and_load) {
+  MemoryPlanner planner;
+  planner.Init(ops(), &scope_);
+  Run(1024);
+  planner.Plan();
+
+  std::vector<cpp::OpDesc> descs;
+  for (auto& op : ops_) descs.push_back(*op->op_info());
+  std::vector<cpp::OpDesc*> desc_ptrs;
+  for (auto& desc : descs) desc_ptrs.push_back(&desc);
+  planner.SavePlan(&desc_ptrs);
+
+  Scope scope;
+  std::vector<std::shared_ptr<OpLite>> ops;
+  std::vector<const OpLite*> op_ptrs;
+  for (auto& desc : descs) {
+    std::shared_ptr<OpLite> op(new FakeOp);
+    op->Attach(desc, &scope);
+    ops.push_back(op);
+    op_ptrs.push_back(op.get());
+  }
+  MemoryPlanner loaded;
+  loaded.Init(op_ptrs, &scope);
+  ASSERT_TRUE(loaded.LoadPlan());
+  ASSERT_EQ(loaded.planned_peak_bytes(), planner.planned_peak_bytes());
+  for (auto& item : planner.slots()) {
+    ASSERT_EQ(loaded.slots().at(item.first).offset, item.second.offset);
+    ASSERT_EQ(loaded.slots().at(item.first).size, item.second.size);
+  }
+}
+
+// x -> op0 -> a, x -> op1 -> b, concat(a, b) -> c -> split -> (d, e)
+class MemoryPlannerConcatTest : public MemoryPlannerTestBase {
+ protected:
+  void SetUp() override {
+    AddOp("fake", {"x"}, {"a"});
+    AddOp("fake", {"x"}, {"b"});
+    AddOp("concat", {"a", "b"}, {"c"});
+    AddOp("split", {"c"}, {"d", "e"});
+  }
+
+  // Run the fake program, a and d have 3 channels, b and e have 5 channels.
+  void Run(int64_t batch) {
+    std::vector<std::pair<std::string, int64_t>> channels(
+        {{"a", 3}, {"b", 5}, {"c", 8}, {"d", 3}, {"e", 5}});
+    for (auto& item : channels) {
+      auto* tensor = scope_.FindMutableTensor(item.first);
+      tensor->Resize({batch, item.second, 16});
+      tensor->mutable_data<float>();
+    }
+  }
+};
+
+TEST_F(MemoryPlannerConcatTest, parts_in_place) {
+  MemoryPlanner planner;
+  planner.Init(ops(), &scope_);
+  Run(1);
+  planner.Plan();
+  planner.Apply();
+  ASSERT_TRUE(planner.IsValid());
+
+  // The parts are placed inside the whole tensors.
+  auto* c = scope_.FindMutableTensor("c")->data<float>();
+  ASSERT_EQ(scope_.FindMutableTensor("a")->data<float>(), c);
+  ASSERT_EQ(scope_.FindMutableTensor("b")->data<float>(), c + 3 * 16);
+  ASSERT_EQ(scope_.FindMutableTensor("d")->data<float>(), c);
+  ASSERT_EQ(scope_.FindMutableTensor("e")->data<float>(), c + 3 * 16);
+  ASSERT_EQ(planner.planned_peak_bytes(), 8 * 16 * sizeof(float));
+
+  // The parts of a batch are not contiguous, so they have slots of their own.
+  Run(2);
+  ASSERT_FALSE(planner.IsValid());
+  planner.Plan();
+  planner.Apply();
+  ASSERT_TRUE(planner.IsValid());
+  auto& slots = planner.slots();
+  auto& whole = slots.at("c");
+  for (auto& name : {"a", "b", "d", "e"}) {
+    auto& part = slots.at(name);
+    ASSERT_TRUE(part.offset + part.size <= whole.offset ||
+                whole.offset + whole.size <= part.offset);
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
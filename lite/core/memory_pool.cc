@@ -0,0 +1,261 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/memory_pool.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "lite/core/target_wrapper.h"
+#include "lite/utils/string.h"
+
+namespace paddle {
+namespace lite {
+
+constexpr size_t HostMemoryPool::kAlignment;
+constexpr size_t HostMemoryPool::kMinBlockSize;
+constexpr size_t HostMemoryPool::kMaxBlockSize;
+constexpr size_t HostMemoryPool::kThreadCacheBlocks;
+constexpr int HostMemoryPool::kNumSizeClasses;
+
+namespace {
+
+// The address tags the blocks of the pool, it differs from the pointers
+// returned by malloc, which the plain host blocks keep in front of the data.
+const int kBlockTag = 0;
+
+// The header right in front of each block of the pool, the block takes
+// kAlignment extra bytes for it to stay aligned. The blocks allocated while
+// the pool is disabled come from the system as they are, without a header.
+struct BlockHeader {
+  int32_t size_class;
+  size_t size;
+  // At the same place as the malloc pointer of a plain host block.
+  const void* tag;
+};
+static_assert(sizeof(BlockHeader) <= HostMemoryPool::kAlignment,
+              "the block header is too large");
+static_assert(offsetof(BlockHeader, tag) + sizeof(void*) ==
+                  sizeof(BlockHeader),
+              "the tag should be the last field of the block header");
+
+BlockHeader* HeaderOf(void* ptr) {
+  return reinterpret_cast<BlockHeader*>(static_cast<char*>(ptr) -
+                                        sizeof(BlockHeader));
+}
+
+bool IsPoolBlock(void* ptr) { return HeaderOf(ptr)->tag == &kBlockTag; }
+
+void* SystemMalloc(size_t size, int size_class) {
+  auto* data = static_cast<char*>(TargetWrapper<TARGET(kHost)>::Malloc(
+      size + HostMemoryPool::kAlignment));
+  if (!data) return nullptr;
+  void* ptr = data + HostMemoryPool::kAlignment;
+  auto* header = HeaderOf(ptr);
+  header->size_class = size_class;
+  header->size = size;
+  header->tag = &kBlockTag;
+  return ptr;
+}
+
+void SystemFree(void* ptr) {
+  TargetWrapper<TARGET(kHost)>::Free(static_cast<char*>(ptr) -
+                                     HostMemoryPool::kAlignment);
+}
+
+}  // namespace
+
+struct HostMemoryPool::ThreadCache {
+  ThreadCache() : free_blocks(kNumSizeClasses) {}
+  // Hand over the cached blocks to the shared cache when the thread exits.
+  ~ThreadCache() {
+    auto& pool = HostMemoryPool::Global();
+    std::lock_guard<std::mutex> lock(pool.mutex_);
+    for (size_t i = 0; i < free_blocks.size(); ++i) {
+      pool.free_blocks_[i].insert(pool.free_blocks_[i].end(),
+                                  free_blocks[i].begin(),
+                                  free_blocks[i].end());
+    }
+  }
+
+  std::vector<std::vector<void*>> free_blocks;
+};
+
+HostMemoryPool::HostMemoryPool() : free_blocks_(kNumSizeClasses) {
+  CHECK_EQ(SizeClass(kMaxBlockSize, nullptr) + 1, kNumSizeClasses);
+}
+
+HostMemoryPool& HostMemoryPool::Global() {
+  static HostMemoryPool* x = new HostMemoryPool;
+  return *x;
+}
+
+// The thread-local states are trivially destructible, so they are still
+// accessible when the other thread-local and static objects holding host
+// memory are destroyed.
+static thread_local bool tls_pool_enabled = false;
+
+HostMemoryPool::ThreadCache* HostMemoryPool::thread_cache() {
+  static thread_local ThreadCache* cache = nullptr;
+  static thread_local bool exited = false;
+  struct Holder {
+    ~Holder() {
+      delete cache;
+      cache = nullptr;
+      exited = true;
+    }
+  };
+  if (!cache && !exited) {
+    static thread_local Holder holder;
+    cache = new ThreadCache;
+  }
+  return cache;
+}
+
+bool HostMemoryPool::enabled() { return tls_pool_enabled; }
+
+HostMemoryPool::ScopedEnable::ScopedEnable(bool enabled) {
+  prev_enabled_ = tls_pool_enabled;
+  tls_pool_enabled = enabled;
+}
+
+HostMemoryPool::ScopedEnable::~ScopedEnable() {
+  tls_pool_enabled = prev_enabled_;
+}
+
+int HostMemoryPool::SizeClass(size_t size, size_t* class_size) {
+  if (size > kMaxBlockSize) {
+    if (class_size) *class_size = size;
+    return -1;
+  }
+  if (size <= kMinBlockSize) {
+    if (class_size) *class_size = kMinBlockSize;
+    return 0;
+  }
+  // size is in (2^n, 2^(n+1)], which is split into 4 classes.
+  int n = 0;
+  while ((size - 1) >> (n + 1)) ++n;
+  int shift = n - 2;
+  size_t steps = (size + (1UL << shift) - 1) >> shift;
+  int min_n = 0;
+  while (kMinBlockSize >> (min_n + 1)) ++min_n;
+  if (class_size) *class_size = steps << shift;
+  return (n - min_n) * 4 + static_cast<int>(steps) - 4;
+}
+
+void HostMemoryPool::AddBytesInUse(size_t size) {
+  size_t in_use = bytes_in_use_ += size;
+  size_t peak = peak_bytes_in_use_;
+  while (in_use > peak &&
+         !peak_bytes_in_use_.compare_exchange_weak(peak, in_use)) {
+  }
+}
+
+void* HostMemoryPool::Malloc(size_t size) {
+  size_t class_size;
+  int size_class = SizeClass(size, &class_size);
+  if (!enabled() || size_class < 0) {
+    return TargetWrapper<TARGET(kHost)>::Malloc(size);
+  }
+
+  void* ptr = nullptr;
+  auto* cache = thread_cache();
+  if (cache && !cache->free_blocks[size_class].empty()) {
+    ptr = cache->free_blocks[size_class].back();
+    cache->free_blocks[size_class].pop_back();
+  } else {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_blocks_[size_class].empty()) {
+      ptr = free_blocks_[size_class].back();
+      free_blocks_[size_class].pop_back();
+    }
+  }
+  if (ptr) {
+    ++hits_;
+    bytes_cached_ -= class_size;
+    // Zeroed as the blocks from the system, some kernels rely on it.
+    std::memset(ptr, 0, size);
+  } else {
+    ++misses_;
+    ptr = SystemMalloc(class_size, size_class);
+    if (!ptr) return nullptr;
+  }
+  AddBytesInUse(class_size);
+  return ptr;
+}
+
+void HostMemoryPool::Cache(void* ptr, int size_class, size_t size) {
+  bytes_cached_ += size;
+  auto* cache = thread_cache();
+  if (cache && cache->free_blocks[size_class].size() < kThreadCacheBlocks) {
+    cache->free_blocks[size_class].push_back(ptr);
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  free_blocks_[size_class].push_back(ptr);
+}
+
+void HostMemoryPool::Free(void* ptr) {
+  if (!ptr) return;
+  if (!IsPoolBlock(ptr)) {
+    TargetWrapper<TARGET(kHost)>::Free(ptr);
+    return;
+  }
+  auto* header = HeaderOf(ptr);
+  bytes_in_use_ -= header->size;
+  // The blocks freed without the pool enabled, such as the ones released by a
+  // destroyed predictor, go back to the system.
+  if (enabled()) {
+    Cache(ptr, header->size_class, header->size);
+  } else {
+    SystemFree(ptr);
+  }
+}
+
+void HostMemoryPool::Trim() {
+  auto release = [&](std::vector<std::vector<void*>>* free_blocks) {
+    for (auto& blocks : *free_blocks) {
+      for (auto* ptr : blocks) {
+        bytes_cached_ -= HeaderOf(ptr)->size;
+        SystemFree(ptr);
+      }
+      blocks.clear();
+    }
+  };
+  auto* cache = thread_cache();
+  if (cache) release(&cache->free_blocks);
+  std::lock_guard<std::mutex> lock(mutex_);
+  release(&free_blocks_);
+}
+
+HostMemoryPool::Stats HostMemoryPool::stats() const {
+  Stats x;
+  x.bytes_in_use = bytes_in_use_;
+  x.peak_bytes_in_use = peak_bytes_in_use_;
+  x.bytes_cached = bytes_cached_;
+  x.hits = hits_;
+  x.misses = misses_;
+  return x;
+}
+
+std::string HostMemoryPool::Stats::repr() const {
+  return string_format(
+      "in use: %zu bytes, peak: %zu bytes, cached: %zu bytes, hit rate: %.3f",
+      bytes_in_use,
+      peak_bytes_in_use,
+      bytes_cached,
+      hit_rate());
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,117 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+/*
+ * HostMemoryPool is a caching allocator for the host memory (Host/X86/ARM
+ * targets), it is used by `TargetMalloc` and `TargetFree`.
+ *
+ * The sizes are rounded up to the size classes, four classes between two
+ * adjacent powers of two, from kMinBlockSize to kMaxBlockSize. A freed block
+ * is kept in the cache of the current thread first, and in a shared cache
+ * when the thread cache is full, the later allocations of the same class take
+ * it from the caches instead of the system. The blocks larger than
+ * kMaxBlockSize are not cached.
+ *
+ * The pool is enabled for the allocations in the current thread by
+ * `ScopedEnable`, so it can be selected per predictor. The blocks of the pool
+ * carry a small header, and the ones allocated while the pool is disabled
+ * come from the system as they are, a block can be freed whether the pool is
+ * enabled or not. A reused block is zeroed as the one from the system.
+ */
+class HostMemoryPool {
+ public:
+  static constexpr size_t kAlignment = 64;
+  static constexpr size_t kMinBlockSize = 64;
+  static constexpr size_t kMaxBlockSize = 1UL << 28;
+  // The max number of blocks per class in a thread cache.
+  static constexpr size_t kThreadCacheBlocks = 2;
+  // The classes from kMinBlockSize (2^6) to kMaxBlockSize (2^28).
+  static constexpr int kNumSizeClasses = (28 - 6) * 4 + 1;
+
+  struct Stats {
+    // The bytes of the blocks allocated and not freed yet.
+    size_t bytes_in_use;
+    size_t peak_bytes_in_use;
+    // The bytes of the blocks in the caches.
+    size_t bytes_cached;
+    // The allocations served by the caches and by the system.
+    size_t hits;
+    size_t misses;
+
+    float hit_rate() const {
+      return hits + misses ? static_cast<float>(hits) / (hits + misses) : 0.f;
+    }
+    std::string repr() const;
+  };
+
+  // Enable or disable the pool for the allocations in the current thread
+  // during the lifetime of this object.
+  class ScopedEnable {
+   public:
+    explicit ScopedEnable(bool enabled);
+    ~ScopedEnable();
+
+   private:
+    bool prev_enabled_;
+  };
+
+  static HostMemoryPool& Global();
+  // Whether the pool is enabled in the current thread.
+  static bool enabled();
+
+  void* Malloc(size_t size);
+  void Free(void* ptr);
+
+  // Release the cached blocks of the shared cache and the current thread.
+  void Trim();
+
+  Stats stats() const;
+
+  // The size class of a size, the class size is returned by `class_size`,
+  // -1 is returned if the size is too large to cache.
+  static int SizeClass(size_t size, size_t* class_size);
+
+ private:
+  HostMemoryPool();
+
+  struct ThreadCache;
+  // The cache of the current thread, nullptr if the thread is exiting.
+  static ThreadCache* thread_cache();
+
+  void AddBytesInUse(size_t size);
+  // Put a freed block into the caches.
+  void Cache(void* ptr, int size_class, size_t size);
+
+  // The blocks shared by all the threads, indexed by the size class.
+  std::vector<std::vector<void*>> free_blocks_;
+  std::mutex mutex_;
+
+  std::atomic<size_t> bytes_in_use_{0};
+  std::atomic<size_t> peak_bytes_in_use_{0};
+  std::atomic<size_t> bytes_cached_{0};
+  std::atomic<size_t> hits_{0};
+  std::atomic<size_t> misses_{0};
+};
+
+}  // namespace lite
+}  // namespace paddle
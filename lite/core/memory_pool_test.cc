@@ -0,0 +1,123 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/memory_pool.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <thread>  // NOLINT
+#include "lite/core/memory.h"
+
+namespace paddle {
+namespace lite {
+
+TEST(memory_pool, size_class) {
+  size_t class_size;
+  ASSERT_EQ(HostMemoryPool::SizeClass(1, &class_size), 0);
+  ASSERT_EQ(class_size, 64UL);
+  ASSERT_EQ(HostMemoryPool::SizeClass(65, &class_size), 1);
+  ASSERT_EQ(class_size, 80UL);
+  ASSERT_EQ(HostMemoryPool::SizeClass(128, &class_size), 4);
+  ASSERT_EQ(class_size, 128UL);
+  ASSERT_EQ(HostMemoryPool::SizeClass(129, &class_size), 5);
+  ASSERT_EQ(class_size, 160UL);
+  ASSERT_EQ(HostMemoryPool::SizeClass(HostMemoryPool::kMaxBlockSize, nullptr),
+            HostMemoryPool::kNumSizeClasses - 1);
+  ASSERT_EQ(
+      HostMemoryPool::SizeClass(HostMemoryPool::kMaxBlockSize + 1, nullptr),
+      -1);
+  for (size_t size = 1; size < (1 << 20); size = size * 3 / 2 + 1) {
+    ASSERT_GE(HostMemoryPool::SizeClass(size, &class_size), 0);
+    ASSERT_GE(class_size, size);
+    ASSERT_LE(class_size, size * 5 / 4 + 64);
+  }
+}
+
+TEST(memory_pool, reuse) {
+  auto& pool = HostMemoryPool::Global();
+  // Not enabled, from the system.
+  auto stats = pool.stats();
+  void* x = TargetMalloc(TARGET(kX86), 1000);
+  TargetFree(TARGET(kX86), x);
+  ASSERT_EQ(pool.stats().misses, stats.misses);
+
+  HostMemoryPool::ScopedEnable guard(true);
+  x = TargetMalloc(TARGET(kHost), 1000);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(x) % HostMemoryPool::kAlignment, 0UL);
+  ASSERT_EQ(pool.stats().misses, stats.misses + 1);
+  ASSERT_GE(pool.stats().bytes_in_use, 1000UL);
+  TargetFree(TARGET(kHost), x);
+
+  // The same size class is served by the cache.
+  void* y = TargetMalloc(TARGET(kARM), 900);
+  ASSERT_EQ(x, y);
+  ASSERT_EQ(pool.stats().hits, stats.hits + 1);
+  TargetFree(TARGET(kARM), y);
+
+  pool.Trim();
+  ASSERT_EQ(pool.stats().bytes_cached, 0UL);
+  LOG(INFO) << pool.stats().repr();
+}
+
+TEST(memory_pool, zeroed) {
+  auto& pool = HostMemoryPool::Global();
+  auto stats = pool.stats();
+  HostMemoryPool::ScopedEnable guard(true);
+  auto* x = static_cast<char*>(TargetMalloc(TARGET(kHost), 256));
+  for (int i = 0; i < 256; ++i) x[i] = 1;
+  TargetFree(TARGET(kHost), x);
+  auto* y = static_cast<char*>(TargetMalloc(TARGET(kHost), 256));
+  ASSERT_EQ(x, y);
+  ASSERT_EQ(pool.stats().hits, stats.hits + 1);
+  for (int i = 0; i < 256; ++i) ASSERT_EQ(y[i], 0);
+  TargetFree(TARGET(kHost), y);
+  pool.Trim();
+}
+
+TEST(memory_pool, mixed) {
+  auto& pool = HostMemoryPool::Global();
+  // The blocks allocated with and without the pool are freed either way.
+  void* x = TargetMalloc(TARGET(kHost), 1000);
+  void* y = nullptr;
+  {
+    HostMemoryPool::ScopedEnable guard(true);
+    y = TargetMalloc(TARGET(kHost), 1000);
+    TargetFree(TARGET(kHost), x);
+  }
+  TargetFree(TARGET(kHost), y);
+  ASSERT_EQ(pool.stats().bytes_cached, 0UL);
+}
+
+TEST(memory_pool, threads) {
+  auto& pool = HostMemoryPool::Global();
+  auto stats = pool.stats();
+  std::thread t([] {
+    HostMemoryPool::ScopedEnable guard(true);
+    for (int i = 0; i < 4; ++i) {
+      TargetFree(TARGET(kHost), TargetMalloc(TARGET(kHost), 4096));
+    }
+  });
+  t.join();
+  ASSERT_EQ(pool.stats().misses, stats.misses + 1);
+  ASSERT_EQ(pool.stats().hits, stats.hits + 3);
+
+  // The blocks cached by the exited thread are shared.
+  HostMemoryPool::ScopedEnable guard(true);
+  void* x = TargetMalloc(TARGET(kHost), 4096);
+  ASSERT_EQ(pool.stats().hits, stats.hits + 4);
+  TargetFree(TARGET(kHost), x);
+  pool.Trim();
+}
+
+}  // namespace lite
+}  // namespace paddle
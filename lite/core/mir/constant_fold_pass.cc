@@ -0,0 +1,181 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/constant_fold_pass.h"
+#include <memory>
+#include <set>
+#include <vector>
+#include "lite/core/mir/pass_registry.h"
+#include "lite/core/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void ConstantFoldPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+#ifndef LITE_WITH_FPGA
+  static const std::set<std::string> kSubBlockOpTypes(
+      {"while", "conditional_block"});
+  num_writes_.clear();
+  folded_args_.clear();
+  for (auto& node : graph->mutable_nodes()) {
+    if (!node.IsStmt()) continue;
+    if (kSubBlockOpTypes.count(node.AsStmt().op_type())) return;
+    for (auto* out : node.outlinks) {
+      num_writes_[out->AsArg().name]++;
+    }
+  }
+
+  // The topological order folds the chains of constant statements.
+  std::vector<Node*> folded_stmts;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    std::map<std::string, PrecisionType> precisions;
+    if (!IsFoldable(node, &precisions)) continue;
+    Fold(node, precisions);
+    folded_stmts.push_back(node);
+  }
+  if (folded_stmts.empty()) return;
+
+  // The constants read by the folded statements only are removed with them.
+  std::unordered_set<const Node*> dead(folded_stmts.begin(),
+                                       folded_stmts.end());
+  std::set<std::string> dead_tensors;
+  for (auto* node : folded_stmts) {
+    for (auto* in : node->inlinks) {
+      bool used = false;
+      for (auto* out : in->outlinks) {
+        if (!dead.count(out)) used = true;
+      }
+      if (used) continue;
+      dead.insert(in);
+      dead_tensors.insert(in->AsArg().name);
+    }
+  }
+  auto* scope = folded_stmts.front()->AsStmt().op()->scope();
+  GraphSafeRemoveNodes(graph.get(), dead);
+  for (auto& name : dead_tensors) {
+    for (auto* s : {static_cast<const Scope*>(scope), scope->parent()}) {
+      auto* var = s ? s->FindLocalVar(name) : nullptr;
+      if (var && var->IsType<Tensor>()) {
+        var->GetMutable<Tensor>()->ResetBuffer(std::make_shared<Buffer>(), 0);
+      }
+    }
+  }
+  LOG(INFO) << "constant folding: " << folded_stmts.size()
+            << " ops folded, " << dead_tensors.size() << " tensors released";
+#endif  // LITE_WITH_FPGA
+}
+
+bool ConstantFoldPass::IsConstant(const Node* arg) const {
+  if (folded_args_.count(arg)) return true;
+  // The weights written by any statement are not constant.
+  return arg->arg()->is_weight && arg->inlinks.empty() &&
+         !num_writes_.count(arg->arg()->name);
+}
+
+bool ConstantFoldPass::IsFoldable(
+    Node* stmt, std::map<std::string, PrecisionType>* precisions) const {
+  static const std::set<std::string> kUnfoldableOpTypes({"feed",
+                                                         "fetch",
+                                                         "io_copy",
+                                                         "io_copy_once",
+                                                         "uniform_random",
+                                                         "gaussian_random",
+                                                         "sampling_id"});
+  auto& inst = stmt->AsStmt();
+  if (kUnfoldableOpTypes.count(inst.op_type()) || stmt->outlinks.empty()) {
+    return false;
+  }
+  auto& kernel = inst.picked_kernel();
+  auto target = kernel.target();
+  if (target != TARGET(kHost) && target != TARGET(kARM) &&
+      target != TARGET(kX86)) {
+    return false;
+  }
+
+  auto* op_info = inst.op_info();
+  auto* scope = inst.op()->scope();
+  PrecisionType input_precision = PRECISION(kUnk);
+  for (auto* in : stmt->inlinks) {
+    if (!IsConstant(in)) return false;
+    auto& name = in->AsArg().name;
+    std::string arg_name;
+    if (!op_info->GetInputArgname(name, &arg_name) ||
+        !kernel.GetInputDeclType(arg_name)->IsTensor()) {
+      return false;
+    }
+    auto* var = scope->FindVar(name);
+    if (!var || !var->IsType<Tensor>()) return false;
+    auto& tensor = var->Get<Tensor>();
+    if (!tensor.IsInitialized()) return false;
+    if (input_precision == PRECISION(kUnk)) {
+      input_precision = tensor.precision();
+    }
+  }
+
+  for (auto* out : stmt->outlinks) {
+    auto& name = out->AsArg().name;
+    std::string arg_name;
+    if (num_writes_.at(name) != 1 ||
+        !op_info->GetOutputArgname(name, &arg_name)) {
+      return false;
+    }
+    auto* type = kernel.GetOutputDeclType(arg_name);
+    if (!type->IsTensor()) return false;
+    // The kernels of any precision write the precision of their inputs.
+    auto precision = type->precision();
+    if (precision == PRECISION(kAny)) precision = kernel.precision();
+    if (precision == PRECISION(kAny)) precision = input_precision;
+    if (precision == PRECISION(kAny) || precision == PRECISION(kUnk)) {
+      return false;
+    }
+    (*precisions)[name] = precision;
+  }
+  return true;
+}
+
+void ConstantFoldPass::Fold(
+    Node* stmt, const std::map<std::string, PrecisionType>& precisions) {
+  auto& inst = stmt->AsStmt();
+  auto op = inst.op();
+  VLOG(4) << "fold " << inst.op_type();
+  CHECK(op->CheckShape()) << "failed to check the shapes of " << inst.op_type();
+  CHECK(op->InferShape()) << "failed to infer the shapes of " << inst.op_type();
+  inst.picked_kernel().Launch();
+
+  // The programs created from the optimized program desc find the folded
+  // tensors in the root scope, where the persistable variables are.
+  auto* scope = op->scope();
+  auto* root = const_cast<Scope*>(scope->parent());
+  for (auto* out : stmt->outlinks) {
+    auto& arg = out->AsArg();
+    auto* tensor = scope->FindVar(arg.name)->GetMutable<Tensor>();
+    tensor->set_precision(precisions.at(arg.name));
+    tensor->set_persistable(true);
+    if (root && scope->FindLocalVar(arg.name)) {
+      auto* weight = root->Var(arg.name)->GetMutable<Tensor>();
+      weight->ShareDataWith(*tensor);
+      weight->set_precision(tensor->precision());
+      weight->set_persistable(true);
+    }
+    arg.is_weight = true;
+    folded_args_.insert(out);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(constant_fold_pass, paddle::lite::mir::ConstantFoldPass);
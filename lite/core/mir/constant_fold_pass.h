@@ -0,0 +1,58 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include "lite/core/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * ConstantFoldPass evaluates the statements whose inputs are all constant
+ * once at optimize time, such as `fill_constant` and the ops computed from the
+ * weights only, and replaces their outputs with persistable tensors. The
+ * outputs of a folded statement are constant too, so the whole chain is
+ * folded, and the results are saved with the optimized model.
+ *
+ * Only the statements with the host, ARM or x86 kernels picked are evaluated.
+ * The ops with random or side-effected outputs, and the graphs with sub-blocks,
+ * which may access the variables without links, are left untouched.
+ */
+class ConstantFoldPass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  bool IsConstant(const Node* arg) const;
+  // Whether `stmt` can be folded. The precision of each output is set in
+  // `precisions`, for the folded tensors are saved with their precisions.
+  bool IsFoldable(Node* stmt,
+                  std::map<std::string, PrecisionType>* precisions) const;
+  void Fold(Node* stmt, const std::map<std::string, PrecisionType>& precisions);
+
+  // The number of the statements writing each variable.
+  std::map<std::string, int> num_writes_;
+  // The outputs of the folded statements.
+  std::unordered_set<const Node*> folded_args_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,166 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/constant_fold_pass.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/mir/pass_registry.h"
+#include "lite/core/mir/pass_test_helper.h"
+#include "lite/core/mir/ssa_graph.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp/program_desc.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// The host kernels evaluated by the pass.
+class FillConstantCompute
+    : public KernelLite<TARGET(kHost), PRECISION(kFloat)> {
+ public:
+  void Run() override {
+    auto& param = Param<operators::FillConstantParam>();
+    auto* out = param.Out->mutable_data<float>();
+    for (int64_t i = 0; i < param.Out->numel(); i++) {
+      out[i] = param.value;
+    }
+  }
+};
+
+class ElementwiseAddCompute
+    : public KernelLite<TARGET(kHost), PRECISION(kFloat)> {
+ public:
+  void Run() override {
+    auto& param = Param<operators::ElementwiseParam>();
+    auto* x = param.X->data<float>();
+    auto* y = param.Y->data<float>();
+    auto* out = param.Out->mutable_data<float>();
+    for (int64_t i = 0; i < param.Out->numel(); i++) {
+      out[i] = x[i] + y[i];
+    }
+  }
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fill_constant,
+                     kHost,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::mir::FillConstantCompute,
+                     def)
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kHost))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_add,
+                     kHost,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::mir::ElementwiseAddCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kHost))})
+    .Finalize();
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+TEST(constant_fold_pass, test) {
+  // Op list:
+  // fill_constant -> (c0)
+  // (c0, w) -> elementwise_add -> (c1)
+  // feed -> (x)
+  // (c1, x) -> elementwise_add -> (y) -> fetch
+  // The weight w is 2, so c1 is folded into a weight of 3.
+  cpp::ProgramDesc program_desc;
+  auto* block = program_desc.AddBlock<cpp::BlockDesc>();
+  AddVars(block, {"w", "c0", "c1", "x", "y"}, {"w"});
+  auto* fill = block->AddOp<cpp::OpDesc>();
+  fill->SetType("fill_constant");
+  fill->SetOutput("Out", {"c0"});
+  fill->SetAttr<int>("dtype", 5);
+  fill->SetAttr<std::vector<int64_t>>("shape", {2, 3});
+  fill->SetAttr<float>("value", 1.f);
+  fill->SetAttr<bool>("force_cpu", false);
+  AddElementwiseAddOp(block, "c0", "w", "c1");
+  AddFeedOp(block, "x");
+  AddElementwiseAddOp(block, "c1", "x", "y");
+  AddFetchOp(block, "y");
+
+  auto scope = std::make_shared<Scope>();
+  auto* w = scope->Var("w")->GetMutable<Tensor>();
+  w->Resize({2, 3});
+  for (int i = 0; i < 6; i++) {
+    w->mutable_data<float>()[i] = 2.f;
+  }
+  w->set_persistable(true);
+
+  std::vector<Place> places{{TARGET(kHost), PRECISION(kFloat)}};
+  lite::Program program(program_desc, scope, places);
+  auto graph = std::unique_ptr<SSAGraph>(new SSAGraph());
+  graph->Build(program, places);
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    auto& kernels = node->AsStmt().kernels();
+    if (kernels.empty()) continue;
+    auto& kernel = node->AsStmt().picked_kernel();
+    kernel.SetContext(ContextScheduler::Global().NewContext(kernel.target()));
+  }
+
+  auto pass = PassManager::Global().LookUp("constant_fold_pass");
+  ASSERT_TRUE(pass);
+  pass->Apply(graph);
+
+  // Only the elementwise_add reading the feed is left besides feed and fetch.
+  std::vector<std::string> op_types;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    op_types.push_back(node->AsStmt().op_type());
+  }
+  ASSERT_EQ(op_types,
+            std::vector<std::string>({"feed", "elementwise_add", "fetch"}));
+  for (auto& node : graph->mutable_nodes()) {
+    if (node.IsArg()) {
+      ASSERT_NE(node.AsArg().name, "c0");
+    }
+  }
+
+  // The folded chain is a single weight in the root scope.
+  auto* c1 = scope->FindLocalVar("c1");
+  ASSERT_TRUE(c1);
+  auto& folded = c1->Get<Tensor>();
+  ASSERT_TRUE(folded.persistable());
+  ASSERT_EQ(folded.dims(), DDim(std::vector<int64_t>({2, 3})));
+  for (int i = 0; i < 6; i++) {
+    ASSERT_EQ(folded.data<float>()[i], 3.f);
+  }
+  // The weight read by the folded ops only is released.
+  ASSERT_FALSE(w->IsInitialized());
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_OP(feed)
+USE_LITE_OP(fetch)
+USE_LITE_OP(fill_constant)
+USE_LITE_OP(elementwise_add)
+USE_MIR_PASS(constant_fold_pass)
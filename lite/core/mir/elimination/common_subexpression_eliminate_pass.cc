@@ -0,0 +1,222 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/elimination/common_subexpression_eliminate_pass.h"
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include "lite/core/mir/pass_registry.h"
+#include "lite/core/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+// The attributes telling where an op comes from, not what it computes.
+const std::set<std::string>& IgnoredAttrs() {
+  static const std::set<std::string> attrs(
+      {"op_callstack", "op_namescope", "op_role", "op_role_var", "op_device"});
+  return attrs;
+}
+
+Node* FindArg(const std::list<Node*>& links, const std::string& name) {
+  for (auto* link : links) {
+    if (link->AsArg().name == name) return link;
+  }
+  return nullptr;
+}
+
+bool IsSameAttr(const OpInfo& a, const OpInfo& b, const std::string& name) {
+  using AttrType = OpDescAPI::AttrType;
+  auto type = a.GetAttrType(name);
+  if (!b.HasAttr(name) || b.GetAttrType(name) != type) return false;
+  switch (type) {
+#define COMPARE_ATTR(type__, T) \
+  case AttrType::type__:        \
+    return a.GetAttr<T>(name) == b.GetAttr<T>(name);
+    COMPARE_ATTR(INT, int32_t);
+    COMPARE_ATTR(FLOAT, float);
+    COMPARE_ATTR(STRING, std::string);
+    COMPARE_ATTR(INTS, std::vector<int>);
+    COMPARE_ATTR(FLOATS, std::vector<float>);
+    COMPARE_ATTR(STRINGS, std::vector<std::string>);
+    COMPARE_ATTR(BOOLEAN, bool);
+    COMPARE_ATTR(LONG, int64_t);
+    COMPARE_ATTR(LONGS, std::vector<int64_t>);
+#undef COMPARE_ATTR
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+CommonSubexpressionEliminatePass::signature_t
+CommonSubexpressionEliminatePass::Signature(const Node& stmt) const {
+  // The arguments are keyed on the nodes, the names may be written more than
+  // once in the program.
+  signature_t key;
+  auto* op_info = stmt.stmt()->op_info();
+  key.first = op_info->Type();
+  for (auto& item : op_info->inputs()) {
+    key.first += "|" + item.first + ":" + std::to_string(item.second.size());
+    for (auto& name : item.second) {
+      key.second.push_back(FindArg(stmt.inlinks, name));
+    }
+  }
+  return key;
+}
+
+bool CommonSubexpressionEliminatePass::IsMergeable(const Node& stmt) const {
+  // The ops with side effects, random outputs or sub-blocks.
+  static const std::set<std::string> kNotMergeableOpTypes(
+      {"feed",
+       "fetch",
+       "io_copy",
+       "io_copy_once",
+       "while",
+       "conditional_block",
+       "uniform_random",
+       "gaussian_random",
+       "sampling_id",
+       "write_to_array",
+       "increment"});
+  auto* op_info = stmt.stmt()->op_info();
+  if (kNotMergeableOpTypes.count(op_info->Type()) ||
+      op_info->HasAttr("sub_block") || stmt.outlinks.empty()) {
+    return false;
+  }
+  // The variables of a single version have the same value wherever they are
+  // read, and the readers of the outputs can be redirected by the names.
+  for (auto* in : stmt.inlinks) {
+    if (num_versions_.at(in->arg()->name) != 1) return false;
+  }
+  for (auto* out : stmt.outlinks) {
+    auto& arg = *out->arg();
+    if (num_versions_.at(arg.name) != 1 || arg.is_weight || arg.is_persist) {
+      return false;
+    }
+    for (auto* reader : out->outlinks) {
+      if (reader->stmt()->op_type() == "fetch") return false;
+    }
+  }
+  return true;
+}
+
+bool CommonSubexpressionEliminatePass::IsSame(const Node& a,
+                                              const Node& b) const {
+  auto& x = *a.stmt()->op_info();
+  auto& y = *b.stmt()->op_info();
+  if (x.outputs().size() != y.outputs().size()) {
+    return false;
+  }
+  for (auto it = x.outputs().begin(), jt = y.outputs().begin();
+       it != x.outputs().end();
+       ++it, ++jt) {
+    if (it->first != jt->first || it->second.size() != jt->second.size()) {
+      return false;
+    }
+  }
+  size_t num_attrs = 0;
+  for (auto& name : x.AttrNames()) {
+    if (IgnoredAttrs().count(name)) continue;
+    if (!IsSameAttr(x, y, name)) return false;
+    num_attrs++;
+  }
+  for (auto& name : y.AttrNames()) {
+    if (!IgnoredAttrs().count(name)) num_attrs--;
+  }
+  return num_attrs == 0;
+}
+
+void CommonSubexpressionEliminatePass::Merge(
+    SSAGraph* graph,
+    Node* origin,
+    Node* dup,
+    std::unordered_set<const Node*>* removed) {
+  auto& origin_outputs = origin->AsStmt().op_info()->outputs();
+  auto& dup_outputs = dup->AsStmt().op_info()->outputs();
+  for (auto it = dup_outputs.begin(), jt = origin_outputs.begin();
+       it != dup_outputs.end();
+       ++it, ++jt) {
+    for (size_t i = 0; i < it->second.size(); ++i) {
+      auto& from = it->second[i];
+      auto& to = jt->second[i];
+      // The outputs are of a single version, so the names identify the nodes
+      // in the readers too.
+      auto* from_node = FindArg(dup->outlinks, from);
+      auto* to_node = FindArg(origin->outlinks, to);
+      CHECK(from_node && to_node);
+      auto readers = from_node->outlinks;
+      for (auto* reader : readers) {
+        auto& stmt = reader->AsStmt();
+        auto op_info = *stmt.op_info();
+        op_info.UpdateAllInputs(from, to);
+        stmt.ResetOp(op_info, graph->valid_places());
+        RemoveDirectedLink(from_node, reader);
+        DirectedLink(to_node, reader);
+      }
+      removed->insert(from_node);
+    }
+  }
+  removed->insert(dup);
+}
+
+void CommonSubexpressionEliminatePass::Apply(
+    const std::unique_ptr<SSAGraph>& graph) {
+  num_versions_.clear();
+  for (auto& node : graph->mutable_nodes()) {
+    if (node.IsArg()) num_versions_[node.arg()->name]++;
+  }
+
+  // In the topological order the inputs of an op are merged before it, so
+  // the duplicates of it read the same nodes.
+  std::map<signature_t, std::vector<Node*>> origins;
+  std::unordered_set<const Node*> removed;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!IsMergeable(*node)) continue;
+    auto& candidates = origins[Signature(*node)];
+    Node* origin = nullptr;
+    for (auto* candidate : candidates) {
+      if (IsSame(*candidate, *node)) {
+        origin = candidate;
+        break;
+      }
+    }
+    if (origin) {
+      Merge(graph.get(), origin, node, &removed);
+    } else {
+      candidates.push_back(node);
+    }
+  }
+  if (removed.empty()) return;
+
+  int num_removed_ops = 0;
+  for (auto* node : removed) {
+    if (node->IsStmt()) num_removed_ops++;
+  }
+  GraphSafeRemoveNodes(graph.get(), removed);
+  LOG(INFO) << "common subexpression elimination: " << num_removed_ops
+            << " ops removed";
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(common_subexpression_eliminate_pass,
+                  paddle::lite::mir::CommonSubexpressionEliminatePass);
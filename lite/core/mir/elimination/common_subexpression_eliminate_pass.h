@@ -0,0 +1,70 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "lite/core/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * CommonSubexpressionEliminatePass merges the ops that compute the same thing,
+ * that is, the ops of the same type and attributes reading the same
+ * variables, such as the transpose or reshape repeated for several heads, or
+ * the identical prior_box ops. The readers of a merged op read the outputs of
+ * the first one instead, and the merged op and its outputs are removed. It
+ * runs before the kernels are picked, in the topological order, so the chains
+ * of the duplicated ops are merged as a whole.
+ *
+ * The ops with side effects or random outputs, the ops with sub-blocks, the
+ * ops reading or writing a variable of several versions, that is written more
+ * than once or read before it is written, and the ops whose outputs are
+ * fetched or persistable are never merged.
+ */
+class CommonSubexpressionEliminatePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  // The type and the input parameters of an op, with its input nodes.
+  using signature_t = std::pair<std::string, std::vector<const Node*>>;
+
+  // The ops of the same signature are compared by the attributes.
+  signature_t Signature(const Node& stmt) const;
+  // Whether the op can be merged into another one or be merged into.
+  bool IsMergeable(const Node& stmt) const;
+  // Whether two ops compute the same outputs, given the same type and inputs.
+  bool IsSame(const Node& a, const Node& b) const;
+  // Make the readers of the outputs of `dup` read the outputs of `origin`.
+  void Merge(SSAGraph* graph,
+             Node* origin,
+             Node* dup,
+             std::unordered_set<const Node*>* removed);
+
+  // The number of the arg nodes of each variable.
+  std::unordered_map<std::string, int> num_versions_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
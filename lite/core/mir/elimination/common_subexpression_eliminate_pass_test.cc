@@ -0,0 +1,146 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/elimination/common_subexpression_eliminate_pass.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/mir/graph_visualize_pass.h"
+#include "lite/core/mir/pass_registry.h"
+#include "lite/core/mir/pass_test_helper.h"
+#include "lite/core/mir/ssa_graph.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp/program_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+std::unique_ptr<SSAGraph> BuildGraph(cpp::ProgramDesc* program_desc,
+                                     const std::shared_ptr<Scope>& scope,
+                                     const std::vector<Place>& valid_places) {
+  // Op list:
+  // feed -> (x)
+  // (x) -> scale(2) -> (a0) -> scale(0.5) -> (b0)
+  // (x) -> scale(2) -> (a1) -> scale(0.5) -> (b1)
+  // (x) -> scale(3) -> (c)
+  // (b0, b1) -> elementwise_add -> (d)
+  // (d, c) -> elementwise_add -> (e) -> fetch
+  // After pass, the two chains of the scale(2) and scale(0.5) are merged.
+  auto* block = program_desc->AddBlock<cpp::BlockDesc>();
+  AddVars(block, {"x", "a0", "a1", "b0", "b1", "c", "d", "e"});
+  AddFeedOp(block, "x");
+  AddScaleOp(block, "x", "a0", 2.f);
+  // The op_callstack differs, but the computation is the same.
+  AddScaleOp(block, "x", "a1", 2.f)
+      ->SetAttr<std::vector<std::string>>("op_callstack", {"a1"});
+  AddScaleOp(block, "a0", "b0", .5f);
+  AddScaleOp(block, "a1", "b1", .5f);
+  AddScaleOp(block, "x", "c", 3.f);
+  AddElementwiseAddOp(block, "b0", "b1", "d");
+  AddElementwiseAddOp(block, "d", "c", "e");
+  AddFetchOp(block, "e");
+
+  lite::Program program(*program_desc, scope, valid_places);
+  auto graph = std::unique_ptr<SSAGraph>(new SSAGraph());
+  graph->Build(program, valid_places);
+
+  VLOG(5) << Visualize(graph.get());
+
+  return graph;
+}
+
+TEST(common_subexpression_eliminate_pass, test) {
+  cpp::ProgramDesc program_desc;
+  std::vector<Place> places{{TARGET(kHost), PRECISION(kFloat)}};
+  auto scope = std::make_shared<Scope>();
+  auto graph = BuildGraph(&program_desc, scope, places);
+  const int num_nodes = graph->nodes().size();
+  auto pass =
+      PassManager::Global().LookUp("common_subexpression_eliminate_pass");
+  ASSERT_TRUE(pass);
+  pass->Apply(graph);
+
+  // The two scale ops and their outputs are removed.
+  ASSERT_EQ(graph->nodes().size(), num_nodes - 4UL);
+  std::set<std::string> arg_names;
+  for (auto& node : graph->nodes()) {
+    if (node.IsArg()) arg_names.insert(node.arg()->name);
+  }
+  ASSERT_EQ(arg_names.count("a0") + arg_names.count("a1"), 1UL);
+  ASSERT_EQ(arg_names.count("b0") + arg_names.count("b1"), 1UL);
+  // The scale op with another factor is kept.
+  ASSERT_TRUE(arg_names.count("c"));
+  int num_scale_ops = 0;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    auto* op_info = node->AsStmt().op_info();
+    if (op_info->Type() == "scale") num_scale_ops++;
+    if (op_info->Type() == "elementwise_add" &&
+        op_info->Output("Out").front() == "d") {
+      ASSERT_EQ(op_info->Input("X").front(), op_info->Input("Y").front());
+      ASSERT_EQ(node->inlinks.size(), 1UL);
+    }
+  }
+  ASSERT_EQ(num_scale_ops, 3);
+}
+
+TEST(common_subexpression_eliminate_pass, rewritten_var) {
+  // Op list:
+  // feed -> (x)
+  // (x) -> scale(2) -> (y) -> relu -> (x)
+  // (x) -> scale(2) -> (z) -> relu -> (w) -> fetch
+  // The scale ops read different versions of x, so they are not merged.
+  cpp::ProgramDesc program_desc;
+  auto* block = program_desc.AddBlock<cpp::BlockDesc>();
+  AddVars(block, {"x", "y", "z", "w"});
+  AddFeedOp(block, "x");
+  AddScaleOp(block, "x", "y", 2.f);
+  AddOp(block, "relu", {"y"}, "x");
+  AddScaleOp(block, "x", "z", 2.f);
+  AddOp(block, "relu", {"z"}, "w");
+  AddFetchOp(block, "w");
+
+  std::vector<Place> places{{TARGET(kHost), PRECISION(kFloat)}};
+  auto scope = std::make_shared<Scope>();
+  lite::Program program(program_desc, scope, places);
+  auto graph = std::unique_ptr<SSAGraph>(new SSAGraph());
+  graph->Build(program, places);
+  const int num_nodes = graph->nodes().size();
+  auto pass =
+      PassManager::Global().LookUp("common_subexpression_eliminate_pass");
+  ASSERT_TRUE(pass);
+  pass->Apply(graph);
+
+  ASSERT_EQ(graph->nodes().size(), num_nodes);
+  std::vector<std::string> outputs;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    outputs.push_back(node->AsStmt().op_info()->Output("Out").front());
+  }
+  ASSERT_EQ(outputs,
+            std::vector<std::string>({"x", "y", "x", "z", "w", "fetch"}));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_OP(feed)
+USE_LITE_OP(fetch)
+USE_LITE_OP(scale)
+USE_LITE_OP(relu)
+USE_LITE_OP(elementwise_add)
+USE_MIR_PASS(common_subexpression_eliminate_pass)
@@ -0,0 +1,113 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/elimination/dead_code_eliminate_pass.h"
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "lite/core/mir/pass_registry.h"
+#include "lite/core/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void DeadCodeEliminatePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  static const std::set<std::string> kSubBlockOpTypes(
+      {"while", "conditional_block"});
+  // Walk backward from the roots, all the nodes reached are alive.
+  std::vector<Node*> stack;
+  for (auto& node : graph->mutable_nodes()) {
+    if (!node.IsStmt()) continue;
+    auto op_type = node.AsStmt().op_type();
+    if (op_type == "fetch" || kSubBlockOpTypes.count(op_type) ||
+        node.outlinks.empty()) {
+      stack.push_back(&node);
+    }
+  }
+  // All the versions of a kept variable are kept, for it may be rewritten.
+  auto& kept_vars = graph->kept_vars();
+  std::set<std::string> kept_names(kept_vars.begin(), kept_vars.end());
+  std::set<std::string> found_names;
+  for (auto& node : graph->mutable_nodes()) {
+    if (node.IsArg() && kept_names.count(node.AsArg().name)) {
+      found_names.insert(node.AsArg().name);
+      stack.push_back(&node);
+    }
+  }
+  for (auto& name : kept_names) {
+    CHECK(found_names.count(name)) << "no variable " << name << " to keep";
+  }
+  std::unordered_set<const Node*> alive;
+  while (!stack.empty()) {
+    auto* node = stack.back();
+    stack.pop_back();
+    if (!alive.insert(node).second) continue;
+    for (auto* in : node->inlinks) {
+      if (!alive.count(in)) stack.push_back(in);
+    }
+  }
+  // The alive ops write all their outputs.
+  std::vector<const Node*> alive_outputs;
+  for (auto* node : alive) {
+    if (!node->IsStmt()) continue;
+    alive_outputs.insert(
+        alive_outputs.end(), node->outlinks.begin(), node->outlinks.end());
+  }
+  alive.insert(alive_outputs.begin(), alive_outputs.end());
+
+  std::unordered_set<const Node*> dead;
+  bool has_sub_block = false;
+  for (auto& node : graph->mutable_nodes()) {
+    if (!alive.count(&node)) {
+      dead.insert(&node);
+    } else if (node.IsStmt() &&
+               kSubBlockOpTypes.count(node.AsStmt().op_type())) {
+      has_sub_block = true;
+    }
+  }
+  if (dead.empty()) return;
+
+  // The weights of the dead ops are not linked to any alive op. They are
+  // released unless an alive sub-block may read them without a link.
+  std::set<Tensor*> dead_weights;
+  int num_dead_ops = 0;
+  for (auto& node : graph->mutable_nodes()) {
+    if (!node.IsStmt() || !dead.count(&node)) continue;
+    num_dead_ops++;
+    for (auto* in : node.inlinks) {
+      if (has_sub_block || !in->AsArg().is_weight || alive.count(in)) continue;
+      auto* var = node.AsStmt().op()->scope()->FindVar(in->AsArg().name);
+      if (var) dead_weights.insert(var->GetMutable<Tensor>());
+    }
+  }
+  GraphSafeRemoveNodes(graph.get(), dead);
+#ifndef LITE_WITH_FPGA
+  // The FPGA tensor manages its memory by itself.
+  for (auto* tensor : dead_weights) {
+    tensor->ResetBuffer(std::make_shared<Buffer>(), 0);
+  }
+#endif  // LITE_WITH_FPGA
+  LOG(INFO) << "dead code elimination: " << num_dead_ops
+            << " ops removed, " << dead_weights.size() << " weights released";
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(dead_code_eliminate_pass,
+                  paddle::lite::mir::DeadCodeEliminatePass);
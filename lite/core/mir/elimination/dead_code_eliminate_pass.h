@@ -0,0 +1,41 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include "lite/core/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * DeadCodeEliminatePass removes the ops whose outputs reach neither a fetch op
+ * nor one of the kept variables, such as the auxiliary heads and the debug
+ * outputs left in the exported models. The weights used by the removed ops
+ * only are released, and are not saved with the optimized model.
+ *
+ * The kept variables are the ones of SSAGraph::kept_vars. The ops without
+ * outputs, and the ops with sub-blocks, are always kept for their side
+ * effects.
+ */
+class DeadCodeEliminatePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,108 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/elimination/dead_code_eliminate_pass.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/mir/graph_visualize_pass.h"
+#include "lite/core/mir/pass_registry.h"
+#include "lite/core/mir/pass_test_helper.h"
+#include "lite/core/mir/ssa_graph.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp/program_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+std::unique_ptr<SSAGraph> BuildGraph(cpp::ProgramDesc* program_desc,
+                                     const std::shared_ptr<Scope>& scope,
+                                     const std::vector<Place>& valid_places) {
+  // Op list:
+  // feed -> (x)
+  // (x) -> scale -> (a) -> fetch
+  // (x) -> scale -> (b)
+  // (x) -> scale -> (k) -> scale -> (k)
+  // The branches of b and k reach no fetch op.
+  auto* block = program_desc->AddBlock<cpp::BlockDesc>();
+  AddVars(block, {"x", "a", "b", "k"});
+  AddFeedOp(block, "x");
+  AddScaleOp(block, "x", "a");
+  AddScaleOp(block, "x", "b");
+  AddScaleOp(block, "x", "k");
+  AddScaleOp(block, "k", "k");
+  AddFetchOp(block, "a");
+
+  lite::Program program(*program_desc, scope, valid_places);
+  auto graph = std::unique_ptr<SSAGraph>(new SSAGraph());
+  graph->Build(program, valid_places);
+
+  VLOG(5) << Visualize(graph.get());
+
+  return graph;
+}
+
+// The number of the scale ops writing `name`.
+int NumWriters(SSAGraph* graph, const std::string& name) {
+  int res = 0;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    auto* op_info = node->AsStmt().op_info();
+    if (op_info->Type() == "scale" && op_info->Output("Out").front() == name) {
+      res++;
+    }
+  }
+  return res;
+}
+
+TEST(dead_code_eliminate_pass, test) {
+  cpp::ProgramDesc program_desc;
+  std::vector<Place> places{{TARGET(kHost), PRECISION(kFloat)}};
+  auto scope = std::make_shared<Scope>();
+  auto graph = BuildGraph(&program_desc, scope, places);
+  auto pass = PassManager::Global().LookUp("dead_code_eliminate_pass");
+  ASSERT_TRUE(pass);
+  pass->Apply(graph);
+
+  ASSERT_EQ(NumWriters(graph.get(), "a"), 1);
+  ASSERT_EQ(NumWriters(graph.get(), "b"), 0);
+  ASSERT_EQ(NumWriters(graph.get(), "k"), 0);
+}
+
+TEST(dead_code_eliminate_pass, kept_vars) {
+  cpp::ProgramDesc program_desc;
+  std::vector<Place> places{{TARGET(kHost), PRECISION(kFloat)}};
+  auto scope = std::make_shared<Scope>();
+  auto graph = BuildGraph(&program_desc, scope, places);
+  graph->SetKeptVars({"k"});
+  auto pass = PassManager::Global().LookUp("dead_code_eliminate_pass");
+  ASSERT_TRUE(pass);
+  pass->Apply(graph);
+
+  ASSERT_EQ(NumWriters(graph.get(), "a"), 1);
+  ASSERT_EQ(NumWriters(graph.get(), "b"), 0);
+  // Both the versions of k are kept.
+  ASSERT_EQ(NumWriters(graph.get(), "k"), 2);
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_OP(feed)
+USE_LITE_OP(fetch)
+USE_LITE_OP(scale)
+USE_MIR_PASS(dead_code_eliminate_pass)
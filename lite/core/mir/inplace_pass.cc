@@ -0,0 +1,155 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/inplace_pass.h"
+#include <algorithm>
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "lite/core/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+Node* FindArg(const std::list<Node*>& links, const std::string& name) {
+  for (auto* link : links) {
+    if (link->AsArg().name == name) return link;
+  }
+  return nullptr;
+}
+
+// Re-attach the op and the picked kernel with the updated `op_info`, the
+// kernel and its context are kept.
+void Reattach(Node* node, const cpp::OpDesc& op_info) {
+  auto& stmt = node->AsStmt();
+  auto op = stmt.op();
+  op->Attach(op_info, op->scope());
+  op->AttachKernel(&stmt.picked_kernel());
+}
+
+bool IsTemporary(Node* arg) {
+  return !arg->AsArg().is_weight && !arg->AsArg().is_persist;
+}
+
+bool SamePlace(Node* a, Node* b, bool check_precision) {
+  auto* a_type = a->AsArg().type;
+  auto* b_type = b->AsArg().type;
+  if (!a_type || !b_type || !a_type->IsTensor() || !b_type->IsTensor() ||
+      a_type->target() != b_type->target()) {
+    return false;
+  }
+  return !check_precision || a_type->precision() == b_type->precision();
+}
+
+}  // namespace
+
+void InplacePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  static const std::set<std::string> kSubBlockOpTypes(
+      {"while", "conditional_block"});
+  static const std::set<std::string> kViewOpTypes(
+      {"reshape", "reshape2", "flatten", "flatten2", "squeeze", "squeeze2"});
+  std::map<std::string, int> num_writes;
+  for (auto& node : graph->mutable_nodes()) {
+    if (!node.IsStmt()) continue;
+    if (kSubBlockOpTypes.count(node.AsStmt().op_type())) return;
+    for (auto* out : node.outlinks) {
+      num_writes[out->AsArg().name]++;
+    }
+  }
+
+  // The kept variables are got or set by name, such as the targets of
+  // RunPartial, so they are neither renamed nor overwritten.
+  const auto& kept = graph->kept_vars();
+  std::set<std::string> kept_vars(kept.begin(), kept.end());
+  // The outputs of the views made in place, which alias their inputs.
+  std::unordered_set<const Node*> views;
+  int num_inplace = 0;
+  int num_views = 0;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    auto& stmt = node->AsStmt();
+    auto* op_info = stmt.op_info();
+    if (!op_info->HasInput("X") || !op_info->HasOutput("Out") ||
+        op_info->Input("X").size() != 1 || op_info->Output("Out").size() != 1) {
+      continue;
+    }
+    auto x_name = op_info->Input("X").front();
+    auto out_name = op_info->Output("Out").front();
+    auto* x = FindArg(node->inlinks, x_name);
+    auto* out = FindArg(node->outlinks, out_name);
+    if (!x || !out || x_name == out_name || !IsTemporary(x) ||
+        !IsTemporary(out) || kept_vars.count(x_name) ||
+        kept_vars.count(out_name)) {
+      continue;
+    }
+    // The input is written by a statement and read by this one only, and the
+    // output is written once and read by the statements other than fetch,
+    // for the outputs fetched or left unread may be got by name.
+    if (x->inlinks.size() != 1 || x->outlinks.size() != 1 ||
+        num_writes[out_name] != 1) {
+      continue;
+    }
+    bool fetched = std::any_of(
+        out->outlinks.begin(), out->outlinks.end(), [](Node* reader) {
+          return reader->AsStmt().op_type() == "fetch";
+        });
+    if (fetched || out->outlinks.empty()) continue;
+
+    if (kViewOpTypes.count(stmt.op_type())) {
+      if (!SamePlace(x, out, false)) continue;
+      auto new_op_info = *op_info;
+      new_op_info.SetAttr<bool>("inplace", true);
+      Reattach(node, new_op_info);
+      views.insert(out);
+      num_views++;
+      continue;
+    }
+
+    // The feeds share the buffers of the user, and the views share the
+    // buffers of their inputs, so they are not written in place.
+    auto input_names = op_info->input_names();
+    if (!stmt.picked_kernel().SupportsInplace() || views.count(x) ||
+        !SamePlace(x, out, true) ||
+        x->inlinks.front()->AsStmt().op_type() == "feed" ||
+        std::count(input_names.begin(), input_names.end(), x_name) != 1) {
+      continue;
+    }
+    VLOG(4) << stmt.op_type() << " writes " << out_name << " in place of "
+            << x_name;
+    auto new_op_info = *op_info;
+    new_op_info.UpdateAllOutputs(out_name, x_name);
+    Reattach(node, new_op_info);
+    for (auto* reader : out->outlinks) {
+      auto reader_op_info = *reader->AsStmt().op_info();
+      reader_op_info.UpdateAllInputs(out_name, x_name);
+      Reattach(reader, reader_op_info);
+    }
+    out->AsArg().name = x_name;
+    num_writes[x_name]++;
+    num_inplace++;
+  }
+  LOG(INFO) << "inplace: " << num_inplace << " ops computed in place, "
+            << num_views << " views sharing the input buffers";
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(inplace_pass, paddle::lite::mir::InplacePass);
@@ -0,0 +1,47 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include "lite/core/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * InplacePass lets the statements write their outputs into the buffers of
+ * their inputs, when the input is read by no other statement.
+ *
+ * - The kernels supporting it (KernelBase::SupportsInplace), such as the
+ *   activations, scale, dropout and the elementwise ops, get their output
+ *   "Out" renamed to the input "X", so they compute in place.
+ * - The view ops, reshape, flatten and squeeze, get the "inplace" attribute,
+ *   their outputs then share the buffers of the inputs without copying. The
+ *   views are not written in place by the following statements, for they
+ *   alias their inputs.
+ *
+ * The inputs fed by the user, the weights, the outputs fetched and the
+ * variables kept (SSAGraph::kept_vars) are kept, so are the graphs with
+ * sub-blocks.
+ */
+class InplacePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,229 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/inplace_pass.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/mir/generate_program_pass.h"
+#include "lite/core/mir/pass_registry.h"
+#include "lite/core/mir/pass_test_helper.h"
+#include "lite/core/mir/ssa_graph.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp/program_desc.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// The host kernels computing in place, they are not run by the pass.
+class InplaceCompute : public KernelLite<TARGET(kHost), PRECISION(kFloat)> {
+ public:
+  void Run() override {}
+  bool SupportsInplace() const override { return true; }
+};
+
+// The host scale computing in place, run by the partial runs.
+class ScaleCompute : public KernelLite<TARGET(kHost), PRECISION(kFloat)> {
+ public:
+  void Run() override {
+    auto& param = Param<operators::ScaleParam>();
+    const float* x = param.x->data<float>();
+    float* out = param.output->mutable_data<float>();
+    for (int64_t i = 0; i < param.x->numel(); i++) {
+      out[i] = x[i] * param.scale + param.bias;
+    }
+  }
+  bool SupportsInplace() const override { return true; }
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(
+    scale, kHost, kFloat, kNCHW, paddle::lite::mir::ScaleCompute, def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kHost))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    relu, kHost, kFloat, kNCHW, paddle::lite::mir::InplaceCompute, def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kHost))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_add,
+                     kHost,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::mir::InplaceCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kHost))})
+    .Finalize();
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+TEST(inplace_pass, test) {
+  // Op list:
+  // feed -> (x)
+  // (x) -> scale -> (a)
+  // (a) -> relu -> (b)
+  // (b) -> relu -> (c)
+  // (w) -> relu -> (d)
+  // (b, c) -> elementwise_add -> (e)
+  // (e, d) -> elementwise_add -> (f)
+  // (f) -> scale -> (y) -> fetch
+  cpp::ProgramDesc program_desc;
+  auto* block = program_desc.AddBlock<cpp::BlockDesc>();
+  AddVars(block, {"x", "a", "b", "c", "d", "e", "f", "y", "w"}, {"w"});
+  AddFeedOp(block, "x");
+  AddScaleOp(block, "x", "a");
+  AddOp(block, "relu", {"a"}, "b");
+  AddOp(block, "relu", {"b"}, "c");
+  AddOp(block, "relu", {"w"}, "d");
+  AddElementwiseAddOp(block, "b", "c", "e");
+  AddElementwiseAddOp(block, "e", "d", "f");
+  AddScaleOp(block, "f", "y");
+  AddFetchOp(block, "y");
+
+  auto scope = std::make_shared<Scope>();
+  scope->Var("w")->GetMutable<Tensor>()->set_persistable(true);
+  std::vector<Place> places{{TARGET(kHost), PRECISION(kFloat)}};
+  lite::Program program(program_desc, scope, places);
+  auto graph = std::unique_ptr<SSAGraph>(new SSAGraph());
+  graph->Build(program, places);
+  for (auto& node : graph->mutable_nodes()) {
+    if (node.IsArg()) {
+      node.AsArg().type = LiteType::GetTensorTy(TARGET(kHost));
+    }
+  }
+
+  auto pass = PassManager::Global().LookUp("inplace_pass");
+  ASSERT_TRUE(pass);
+  pass->Apply(graph);
+
+  // The inputs and the output of each op after the pass.
+  std::vector<std::string> ops;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    auto* op_info = node->AsStmt().op_info();
+    if (op_info->Type() == "feed" || op_info->Type() == "fetch") continue;
+    std::string op = op_info->Input("X").front();
+    if (op_info->HasInput("Y")) op += "," + op_info->Input("Y").front();
+    ops.push_back(op + "->" + op_info->Output("Out").front());
+  }
+  std::sort(ops.begin(), ops.end());
+  ASSERT_EQ(ops,
+            std::vector<std::string>({
+                // b, renamed to a, is read twice and written by neither.
+                "a,c->e",
+                // The only reader of a writes b in place of it.
+                "a->a",
+                "a->c",
+                // The only reader of e writes f in place of it.
+                "e,d->e",
+                // The output fetched is kept.
+                "e->y",
+                // The weight is not written.
+                "w->d",
+                // The feed is not written.
+                "x->a",
+            }));
+}
+
+// The variables named by RunPartial are the ones of the original model, the
+// pass renames them unless they are kept.
+TEST(inplace_pass, run_partial) {
+  // Op list:
+  // (x) -> scale -> (a)
+  // (a) -> scale -> (b)
+  // (b) -> scale -> (y)
+  cpp::ProgramDesc program_desc;
+  auto* block = program_desc.AddBlock<cpp::BlockDesc>();
+  AddVars(block, {"x", "a", "b", "y"});
+  AddScaleOp(block, "x", "a");
+  AddScaleOp(block, "a", "b");
+  AddScaleOp(block, "b", "y");
+
+  auto scope = std::make_shared<Scope>();
+  std::vector<Place> places{{TARGET(kHost), PRECISION(kFloat)}};
+  auto build = [&](const std::vector<std::string>& kept_vars) {
+    lite::Program program(program_desc, scope, places);
+    auto graph = std::unique_ptr<SSAGraph>(new SSAGraph());
+    graph->Build(program, places);
+    for (auto& node : graph->mutable_nodes()) {
+      if (node.IsArg()) {
+        node.AsArg().type = LiteType::GetTensorTy(TARGET(kHost));
+      }
+    }
+    graph->SetKeptVars(kept_vars);
+    PassManager::Global().LookUp("inplace_pass")->Apply(graph);
+    auto* pass = PassManager::Global().LookUp<GenerateProgramPass>(
+        "generate_program_pass");
+    pass->Apply(graph);
+    auto runtime_program = pass->GenProgram();
+    runtime_program->set_exec_scope(program.exec_scope());
+    runtime_program->set_memory_plan_enabled(false);
+    return runtime_program;
+  };
+  auto set_tensor = [](RuntimeProgram* program,
+                       const std::string& name,
+                       float value) {
+    auto* tensor = program->exec_scope()->FindMutableTensor(name);
+    tensor->Resize({3});
+    auto* data = tensor->mutable_data<float>();
+    std::fill(data, data + 3, value);
+  };
+  auto get_tensor = [](RuntimeProgram* program, const std::string& name) {
+    auto* tensor = program->exec_scope()->FindVar(name)->GetMutable<Tensor>();
+    return std::vector<float>(tensor->data<float>(),
+                              tensor->data<float>() + tensor->numel());
+  };
+
+  // b is written in place of a, so no instruction computes or reads it.
+  auto renamed = build({});
+  set_tensor(renamed.get(), "x", 1.f);
+  ASSERT_DEATH(renamed->RunPartial({"b"}, {"x"}), "no instruction computes b");
+  set_tensor(renamed.get(), "b", 1.f);
+  ASSERT_DEATH(renamed->RunPartial({"y"}, {"x", "b"}),
+               "no instruction reads the provided variable b");
+
+  auto kept = build({"b"});
+  set_tensor(kept.get(), "x", 1.f);
+  kept->RunPartial({"b"}, {"x"});
+  ASSERT_EQ(get_tensor(kept.get(), "b"), std::vector<float>(3, 4.f));
+  set_tensor(kept.get(), "b", 1.f);
+  kept->RunPartial({"y"}, {"b"});
+  ASSERT_EQ(get_tensor(kept.get(), "y"), std::vector<float>(3, 2.f));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_OP(feed)
+USE_LITE_OP(fetch)
+USE_LITE_OP(scale)
+USE_LITE_OP(relu)
+USE_LITE_OP(elementwise_add)
+USE_MIR_PASS(inplace_pass)
@@ -0,0 +1,173 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/memory_optimize_pass.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "lite/core/memory_planner.h"
+#include "lite/core/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void MemoryOptimizePass::CollectLifeCycles(
+    SSAGraph* graph,
+    std::map<place_key_t, std::map<std::string, lifecycle_t>>* lifecycles) {
+  // The kept variables are got or set by name, such as the targets of
+  // RunPartial, so their buffers are not shared.
+  const auto& kept = graph->kept_vars();
+  std::set<std::string> invalid_var_names(kept.begin(), kept.end());
+  std::map<std::string, place_key_t> var_places;
+
+  int idx = 0;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    auto& stmt = node->AsStmt();
+    auto* exec_scope = stmt.op()->scope();
+    bool invalid_stmt = !IsOpMemoryReusable(*stmt.op());
+
+    auto collect = [&](Node* var_node, bool is_output) {
+      CHECK(var_node->IsArg());
+      auto& arg = var_node->AsArg();
+      if (arg.is_weight || arg.is_persist) return;
+      const auto& name = arg.name;
+      if (invalid_stmt || !arg.type || !arg.type->IsTensor() ||
+          !exec_scope->FindLocalVar(name)) {
+        invalid_var_names.insert(name);
+        return;
+      }
+      place_key_t key(arg.type->target(), arg.type->precision());
+      auto it = var_places.find(name);
+      if (it == var_places.end()) {
+        // A temporary variable read before written comes from outside.
+        if (!is_output) invalid_var_names.insert(name);
+        var_places.emplace(name, key);
+        (*lifecycles)[key][name] = lifecycle_t(idx, idx);
+        return;
+      }
+      if (it->second != key) {
+        invalid_var_names.insert(name);
+        return;
+      }
+      (*lifecycles)[key][name].second = idx;
+    };
+
+    for (auto* in : node->inlinks) collect(in, false);
+    for (auto* out : node->outlinks) collect(out, true);
+    ++idx;
+  }
+
+  for (auto& item : *lifecycles) {
+    for (auto& name : invalid_var_names) {
+      item.second.erase(name);
+    }
+  }
+}
+
+void MemoryOptimizePass::MakeReusePlan(
+    const std::map<std::string, lifecycle_t>& lifecycles,
+    std::unordered_map<std::string, std::string>* reuse_table) {
+  std::vector<std::pair<std::string, lifecycle_t>> vars(lifecycles.begin(),
+                                                         lifecycles.end());
+  std::stable_sort(vars.begin(),
+                   vars.end(),
+                   [](const std::pair<std::string, lifecycle_t>& a,
+                      const std::pair<std::string, lifecycle_t>& b) {
+                     return a.second.first < b.second.first;
+                   });
+
+  // Each slot is a variable whose buffer is reused, it records the name of
+  // the owner and the last statement that accesses it.
+  std::vector<std::pair<std::string, int>> slots;
+  for (auto& var : vars) {
+    bool reused = false;
+    for (auto& slot : slots) {
+      if (slot.second < var.second.first) {
+        (*reuse_table)[var.first] = slot.first;
+        slot.second = var.second.second;
+        reused = true;
+        break;
+      }
+    }
+    if (!reused) {
+      (*reuse_table)[var.first] = var.first;
+      slots.emplace_back(var.first, var.second.second);
+    }
+  }
+  VLOG(3) << "memory optimize: " << vars.size() << " vars reuse "
+          << slots.size() << " buffers";
+}
+
+void MemoryOptimizePass::PerformReusePlan(
+    SSAGraph* graph,
+    const std::unordered_map<std::string, std::string>& reuse_table) {
+  auto reused_name = [&](const std::string& name) -> const std::string& {
+    auto it = reuse_table.find(name);
+    return it == reuse_table.end() ? name : it->second;
+  };
+
+  for (auto& node : graph->mutable_nodes()) {
+    if (node.IsArg()) {
+      node.AsArg().name = reused_name(node.AsArg().name);
+      continue;
+    }
+    auto& stmt = node.AsStmt();
+    auto op_info = *stmt.op_info();
+    bool updated = false;
+    for (auto& name : op_info.input_names()) {
+      if (reused_name(name) == name) continue;
+      VLOG(4) << stmt.op_type() << " input " << name << " -> "
+              << reused_name(name);
+      op_info.UpdateAllInputs(name, reused_name(name));
+      updated = true;
+    }
+    for (auto& name : op_info.output_names()) {
+      if (reused_name(name) == name) continue;
+      VLOG(4) << stmt.op_type() << " output " << name << " -> "
+              << reused_name(name);
+      op_info.UpdateAllOutputs(name, reused_name(name));
+      updated = true;
+    }
+    if (!updated) continue;
+    // Re-attach the op and the picked kernel with the renamed arguments, the
+    // kernel and its context are kept.
+    auto op = stmt.op();
+    op->Attach(op_info, op->scope());
+    op->AttachKernel(&stmt.picked_kernel());
+  }
+}
+
+void MemoryOptimizePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  std::map<place_key_t, std::map<std::string, lifecycle_t>> lifecycles;
+  CollectLifeCycles(graph.get(), &lifecycles);
+
+  std::unordered_map<std::string, std::string> reuse_table;
+  for (auto& item : lifecycles) {
+    MakeReusePlan(item.second, &reuse_table);
+  }
+  PerformReusePlan(graph.get(), reuse_table);
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(memory_optimize_pass, paddle::lite::mir::MemoryOptimizePass);
@@ -0,0 +1,66 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "lite/core/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * MemoryOptimizePass analyzes the lifetime of the temporary variables over
+ * the execution order of the statements, and lets the variables whose
+ * lifetimes do not overlap share one variable (thus one Buffer).
+ *
+ * The reuse is performed by renaming the arguments of the statements, so the
+ * optimized program can be saved and reused by the LightPredictor directly.
+ *
+ * Only the tensors with the same target and precision can be reused, and the
+ * arguments of feed/fetch, the control flow ops and the kernels sharing the
+ * input buffer with the output are excluded.
+ */
+class MemoryOptimizePass : public ProgramPass {
+ public:
+  // [first, last] index of the statements that access a variable.
+  using lifecycle_t = std::pair<int, int>;
+  // The reuse key, the variables can only be reused in the same Place.
+  using place_key_t = std::pair<TargetType, PrecisionType>;
+
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  void CollectLifeCycles(
+      SSAGraph* graph,
+      std::map<place_key_t, std::map<std::string, lifecycle_t>>* lifecycles);
+
+  void MakeReusePlan(const std::map<std::string, lifecycle_t>& lifecycles,
+                     std::unordered_map<std::string, std::string>* reuse_table);
+
+  void PerformReusePlan(
+      SSAGraph* graph,
+      const std::unordered_map<std::string, std::string>& reuse_table);
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
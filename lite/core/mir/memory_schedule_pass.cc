@@ -0,0 +1,215 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/memory_schedule_pass.h"
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "lite/core/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+struct StmtInfo {
+  // The activations read and written.
+  std::vector<const Node*> inputs;
+  std::vector<const Node*> outputs;
+  // The indices of the statements to run before.
+  std::set<int> deps;
+};
+
+using size_map_t = std::unordered_map<const Node*, size_t>;
+
+// The number of the statements reading each activation.
+std::unordered_map<const Node*, int> CountReaders(
+    const std::vector<StmtInfo>& stmts) {
+  std::unordered_map<const Node*, int> readers;
+  for (auto& stmt : stmts) {
+    for (auto* in : stmt.inputs) readers[in]++;
+  }
+  return readers;
+}
+
+// An activation is alive from its writer to its last reader.
+size_t EstimatePeak(const std::vector<StmtInfo>& stmts,
+                    const std::vector<int>& order,
+                    const size_map_t& sizes) {
+  auto readers = CountReaders(stmts);
+  size_t live = 0;
+  size_t peak = 0;
+  for (int i : order) {
+    auto& stmt = stmts[i];
+    for (auto* out : stmt.outputs) live += sizes.at(out);
+    peak = std::max(peak, live);
+    for (auto* in : stmt.inputs) {
+      if (--readers.at(in) == 0) live -= sizes.at(in);
+    }
+    for (auto* out : stmt.outputs) {
+      if (!readers.count(out)) live -= sizes.at(out);
+    }
+  }
+  return peak;
+}
+
+// Return the greedy order, or an empty one if the dependencies have a cycle.
+std::vector<int> Schedule(const std::vector<StmtInfo>& stmts,
+                          const size_map_t& sizes) {
+  auto readers = CountReaders(stmts);
+  std::vector<int> num_deps(stmts.size());
+  std::vector<std::vector<int>> users(stmts.size());
+  std::set<int> ready;
+  for (size_t i = 0; i < stmts.size(); i++) {
+    num_deps[i] = stmts[i].deps.size();
+    for (int dep : stmts[i].deps) users[dep].push_back(i);
+    if (num_deps[i] == 0) ready.insert(i);
+  }
+
+  std::vector<int> order;
+  while (!ready.empty()) {
+    // The set is iterated in the original order, which wins the ties.
+    int best = -1;
+    int64_t best_growth = 0;
+    for (int i : ready) {
+      int64_t growth = 0;
+      for (auto* out : stmts[i].outputs) {
+        if (readers.count(out)) growth += sizes.at(out);
+      }
+      for (auto* in : stmts[i].inputs) {
+        if (readers.at(in) == 1) growth -= sizes.at(in);
+      }
+      if (best < 0 || growth < best_growth) {
+        best = i;
+        best_growth = growth;
+      }
+    }
+    ready.erase(best);
+    order.push_back(best);
+    for (auto* in : stmts[best].inputs) readers.at(in)--;
+    for (int user : users[best]) {
+      if (--num_deps[user] == 0) ready.insert(user);
+    }
+  }
+  if (order.size() != stmts.size()) order.clear();
+  return order;
+}
+
+}  // namespace
+
+void MemorySchedulePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  static const std::set<std::string> kSubBlockOpTypes(
+      {"while", "conditional_block"});
+  auto origin = graph->StmtTopologicalOrder();
+  if (origin.size() < 3) return;
+  std::unordered_map<const Node*, int> index;
+  for (size_t i = 0; i < origin.size(); i++) {
+    // The sub-blocks access the variables without links.
+    if (kSubBlockOpTypes.count(origin[i]->AsStmt().op_type())) return;
+    index[origin[i]] = i;
+  }
+
+  std::vector<StmtInfo> stmts(origin.size());
+  size_map_t sizes;
+  bool sizes_known = true;
+  // The versions of each variable with the indices of their writers, -1 for
+  // the ones from outside.
+  std::map<std::string, std::vector<std::pair<int, const Node*>>> versions;
+  for (auto& node : graph->mutable_nodes()) {
+    if (!node.IsArg()) continue;
+    auto& arg = node.AsArg();
+    int writer = node.inlinks.empty() ? -1 : index.at(node.inlinks.front());
+    versions[arg.name].emplace_back(writer, &node);
+    if (writer < 0) continue;
+    for (auto* reader : node.outlinks) {
+      stmts[index.at(reader)].deps.insert(writer);
+    }
+    if (arg.is_weight || arg.is_persist) continue;
+    // The variables other than the tensors, such as the fetch list, are not
+    // activations.
+    auto* scope = node.inlinks.front()->AsStmt().op()->scope();
+    auto* var = scope->FindVar(arg.name);
+    if (var && !var->IsType<Tensor>()) continue;
+
+    stmts[writer].outputs.push_back(&node);
+    for (auto* reader : node.outlinks) {
+      stmts[index.at(reader)].inputs.push_back(&node);
+    }
+    size_t size = 0;
+    if (var && arg.type) {
+      auto& dims = var->Get<Tensor>().dims();
+      if (dims.size()) {
+        size = dims.production() * PrecisionTypeLength(arg.type->precision());
+      }
+    }
+    if (size == 0) sizes_known = false;
+    sizes[&node] = size;
+  }
+  if (!sizes_known) {
+    for (auto& item : sizes) item.second = 1;
+  }
+
+  // A variable written more than once keeps the order of its versions, each
+  // writer runs after the writer and the readers of the version before.
+  for (auto& item : versions) {
+    auto& vars = item.second;
+    if (vars.size() < 2) continue;
+    std::stable_sort(vars.begin(),
+                     vars.end(),
+                     [](const std::pair<int, const Node*>& a,
+                        const std::pair<int, const Node*>& b) {
+                       return a.first < b.first;
+                     });
+    for (size_t k = 1; k < vars.size(); k++) {
+      int writer = vars[k].first;
+      if (writer < 0) continue;
+      if (vars[k - 1].first >= 0) stmts[writer].deps.insert(vars[k - 1].first);
+      for (auto* reader : vars[k - 1].second->outlinks) {
+        int i = index.at(reader);
+        if (i != writer) stmts[writer].deps.insert(i);
+      }
+    }
+  }
+
+  auto scheduled = Schedule(stmts, sizes);
+  if (scheduled.empty()) {
+    VLOG(3) << "memory schedule: the variable versions are out of order";
+    return;
+  }
+  std::vector<int> origin_order(origin.size());
+  for (size_t i = 0; i < origin.size(); i++) {
+    origin_order[i] = i;
+  }
+  size_t before = EstimatePeak(stmts, origin_order, sizes);
+  size_t after = EstimatePeak(stmts, scheduled, sizes);
+  LOG(INFO) << "memory schedule: estimated peak of the activations " << before
+            << " -> " << after << (sizes_known ? " bytes" : " tensors");
+  if (after >= before) return;
+
+  std::vector<Node*> order;
+  for (int i : scheduled) {
+    order.push_back(origin[i]);
+  }
+  graph->SetStmtOrder(order);
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(memory_schedule_pass, paddle::lite::mir::MemorySchedulePass);
@@ -0,0 +1,46 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "lite/core/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * MemorySchedulePass reorders the statements to lower the peak size of the
+ * live activations, that is the temporary tensors written by the statements.
+ * In the graphs with parallel branches, such as Inception and SSD, the order
+ * decides how many branch outputs are alive at once.
+ *
+ * The statements are scheduled greedily: the ready statement that grows the
+ * live size the least runs first, preferring the original order on ties. The
+ * order is taken only if its estimated peak is lower, and is then used by the
+ * following passes, the memory optimization and the program generation.
+ *
+ * The activation sizes are the bytes of the tensors shaped at optimize time.
+ * When any of them is unknown, every activation counts as one tensor.
+ */
+class MemorySchedulePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
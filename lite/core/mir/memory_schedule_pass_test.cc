@@ -0,0 +1,135 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/mir/memory_schedule_pass.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/mir/pass_registry.h"
+#include "lite/core/mir/pass_test_helper.h"
+#include "lite/core/mir/ssa_graph.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/program.h"
+#include "lite/model_parser/cpp/program_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// The peak bytes of the tensors alive at once in `order`, each from its writer
+// to its last reader.
+size_t PeakBytes(const std::vector<Node*>& order, Scope* scope) {
+  std::map<const Node*, int> readers;
+  for (auto* stmt : order) {
+    for (auto* in : stmt->inlinks) {
+      if (!in->inlinks.empty()) readers[in]++;
+    }
+  }
+  auto bytes = [&](const Node* arg) -> size_t {
+    auto* var = scope->FindVar(arg->arg()->name);
+    if (!var->IsType<Tensor>()) return 0;
+    return var->Get<Tensor>().numel() * sizeof(float);
+  };
+  size_t live = 0;
+  size_t peak = 0;
+  for (auto* stmt : order) {
+    for (auto* out : stmt->outlinks) live += bytes(out);
+    peak = std::max(peak, live);
+    for (auto* in : stmt->inlinks) {
+      if (readers.count(in) && --readers[in] == 0) live -= bytes(in);
+    }
+    for (auto* out : stmt->outlinks) {
+      if (!readers.count(out)) live -= bytes(out);
+    }
+  }
+  return peak;
+}
+
+TEST(memory_schedule_pass, diamond) {
+  // Op list:
+  // feed -> (x)
+  // (x) -> scale -> (a1) -> scale -> (a2)
+  // (x) -> scale -> (b1) -> scale -> (b2)
+  // (a2, b2) -> elementwise_add -> (y) -> fetch
+  // a1 and b1 are large, running the branches one after another keeps only
+  // one of them alive.
+  cpp::ProgramDesc program_desc;
+  auto* block = program_desc.AddBlock<cpp::BlockDesc>();
+  AddVars(block, {"x", "a1", "b1", "a2", "b2", "y"});
+  AddFeedOp(block, "x");
+  AddScaleOp(block, "x", "a1");
+  AddScaleOp(block, "x", "b1");
+  AddScaleOp(block, "a1", "a2");
+  AddScaleOp(block, "b1", "b2");
+  AddElementwiseAddOp(block, "a2", "b2", "y");
+  AddFetchOp(block, "y");
+
+  auto scope = std::make_shared<Scope>();
+  std::vector<Place> places{{TARGET(kHost), PRECISION(kFloat)}};
+  lite::Program program(program_desc, scope, places);
+  auto* exec_scope = program.exec_scope();
+  for (auto& name : {"x", "a2", "b2", "y"}) {
+    exec_scope->FindVar(name)->GetMutable<Tensor>()->Resize({1});
+  }
+  for (auto& name : {"a1", "b1"}) {
+    exec_scope->FindVar(name)->GetMutable<Tensor>()->Resize({100});
+  }
+
+  auto graph = std::unique_ptr<SSAGraph>(new SSAGraph());
+  graph->Build(program, places);
+  // The activations are float tensors, and the statements run in the order of
+  // the ops.
+  std::vector<Node*> origin;
+  for (auto& node : graph->mutable_nodes()) {
+    if (node.IsArg()) {
+      node.AsArg().type = LiteType::GetTensorTy(TARGET(kHost));
+    } else {
+      origin.push_back(&node);
+    }
+  }
+  ASSERT_TRUE(graph->IsValidStmtOrder(origin));
+  graph->SetStmtOrder(origin);
+
+  auto pass = PassManager::Global().LookUp("memory_schedule_pass");
+  ASSERT_TRUE(pass);
+  pass->Apply(graph);
+
+  auto order = graph->StmtTopologicalOrder();
+  ASSERT_TRUE(graph->IsValidStmtOrder(order));
+  std::vector<std::string> outputs;
+  for (auto* stmt : order) {
+    outputs.push_back(stmt->outlinks.front()->AsArg().name);
+  }
+  ASSERT_EQ(outputs,
+            std::vector<std::string>(
+                {"x", "a1", "a2", "b1", "b2", "y", "fetch"}));
+  ASSERT_LT(PeakBytes(order, exec_scope), PeakBytes(origin, exec_scope));
+
+  // The order taken is not rescheduled.
+  pass->Apply(graph);
+  ASSERT_EQ(graph->StmtTopologicalOrder(), order);
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_OP(feed)
+USE_LITE_OP(fetch)
+USE_LITE_OP(scale)
+USE_LITE_OP(elementwise_add)
+USE_MIR_PASS(memory_schedule_pass)
@@ -0,0 +1,93 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/model_parser/cpp/block_desc.h"
+#include "lite/model_parser/cpp/op_desc.h"
+#include "lite/model_parser/cpp/var_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// The helpers building the programs of the pass tests.
+
+// Add the tensor variables, the ones in `persistables` are persistable.
+inline void AddVars(cpp::BlockDesc* block,
+                    const std::vector<std::string>& names,
+                    const std::set<std::string>& persistables = {}) {
+  for (auto& name : names) {
+    auto* var = block->AddVar<cpp::VarDesc>();
+    var->SetName(name);
+    var->SetType(cpp::VarDesc::Type::LOD_TENSOR);
+    var->SetPersistable(persistables.count(name) > 0);
+  }
+}
+
+// Add an op reading `inputs` as X and Y, and writing `output` as Out.
+inline cpp::OpDesc* AddOp(cpp::BlockDesc* block,
+                          const std::string& type,
+                          const std::vector<std::string>& inputs,
+                          const std::string& output) {
+  auto* op = block->AddOp<cpp::OpDesc>();
+  op->SetType(type);
+  op->SetInput("X", {inputs[0]});
+  if (inputs.size() > 1) op->SetInput("Y", {inputs[1]});
+  op->SetOutput("Out", {output});
+  return op;
+}
+
+inline cpp::OpDesc* AddScaleOp(cpp::BlockDesc* block,
+                               const std::string& input,
+                               const std::string& output,
+                               float scale = 2.f) {
+  auto* op = AddOp(block, "scale", {input}, output);
+  op->SetAttr<float>("scale", scale);
+  op->SetAttr<float>("bias", 0.f);
+  op->SetAttr<bool>("bias_after_scale", true);
+  return op;
+}
+
+inline cpp::OpDesc* AddElementwiseAddOp(cpp::BlockDesc* block,
+                                        const std::string& x,
+                                        const std::string& y,
+                                        const std::string& output) {
+  auto* op = AddOp(block, "elementwise_add", {x, y}, output);
+  op->SetAttr<int>("axis", -1);
+  return op;
+}
+
+inline cpp::OpDesc* AddFeedOp(cpp::BlockDesc* block,
+                              const std::string& output,
+                              int col = 0) {
+  auto* op = AddOp(block, "feed", {"feed"}, output);
+  op->SetAttr<int>("col", col);
+  return op;
+}
+
+inline cpp::OpDesc* AddFetchOp(cpp::BlockDesc* block,
+                               const std::string& input,
+                               int col = 0) {
+  auto* op = AddOp(block, "fetch", {input}, "fetch");
+  op->SetAttr<int>("col", col);
+  return op;
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -80,9 +80,38 @@ void SSAGraph::SortHelper(
   ret->push_back(node);
 }
 
+bool SSAGraph::IsValidStmtOrder(const std::vector<mir::Node *> &order) {
+  std::map<const mir::Node *, size_t> pos;
+  for (size_t i = 0; i < order.size(); i++) {
+    pos[order[i]] = i;
+  }
+  size_t num_stmts = 0;
+  for (auto &node : node_storage_) {
+    if (!node.IsStmt()) continue;
+    num_stmts++;
+    auto it = pos.find(&node);
+    if (it == pos.end()) return false;
+    for (auto *var : node.inlinks) {
+      for (auto *producer : var->inlinks) {
+        auto producer_it = pos.find(producer);
+        if (producer_it == pos.end() || producer_it->second >= it->second) {
+          return false;
+        }
+      }
+    }
+  }
+  return num_stmts == order.size() && pos.size() == order.size();
+}
+
 std::vector<mir::Node *> SSAGraph::StmtTopologicalOrder() {
   CheckBidirectionalConnection();
 
+  if (!stmt_order_.empty()) {
+    if (IsValidStmtOrder(stmt_order_)) return stmt_order_;
+    VLOG(3) << "the statement order set is dropped for the graph changed";
+    stmt_order_.clear();
+  }
+
   std::stack<mir::Node *> stack;
   std::set<mir::Node *> visited;
   std::vector<mir::Node *> res;
@@ -42,6 +42,17 @@ class SSAGraph : GraphBase {
 
   std::vector<mir::Node *> StmtTopologicalOrder();
 
+  // Set the statement order returned by StmtTopologicalOrder, such as the one
+  // scheduled for the memory. It is dropped once the graph is changed and it
+  // is no more a topological order of all the statements.
+  void SetStmtOrder(const std::vector<mir::Node *> &order) {
+    stmt_order_ = order;
+  }
+
+  // Whether `order` holds all the statements, each after the writers of its
+  // inputs.
+  bool IsValidStmtOrder(const std::vector<mir::Node *> &order);
+
   // The inputs of the graph.
   std::vector<mir::Node *> inputs();
 
@@ -65,6 +76,11 @@ class SSAGraph : GraphBase {
   Node *GraphCreateInstructNode(const std::shared_ptr<OpLite> &op,
                                 const std::vector<Place> &valid_places);
 
+  // The variables to keep computed besides the fetched ones, such as the ones
+  // read by GetTensor, see Optimizer::KeepVars.
+  void SetKeptVars(const std::vector<std::string> &x) { kept_vars_ = x; }
+  const std::vector<std::string> &kept_vars() const { return kept_vars_; }
+
   // Device related attributes
   const std::vector<Place> &valid_places() const { return valid_places_; }
   void SetValidPlaces(const std::vector<Place> &x) { valid_places_ = x; }
@@ -95,6 +111,8 @@ class SSAGraph : GraphBase {
   std::list<mir::Node> node_storage_;
   std::map<std::string, mir::Node *> arguments_;
   std::vector<Place> valid_places_;
+  std::vector<mir::Node *> stmt_order_;
+  std::vector<std::string> kept_vars_;
 };
 
 // Remove the link between a -> b.
@@ -48,13 +48,15 @@ class Optimizer {
     graph_.reset(new mir::SSAGraph);
     graph_->Build(program, valid_places);
     graph_->SetValidPlaces(valid_places);
+    graph_->SetKeptVars(kept_vars_);
 
     SpecifyKernelPickTactic(kernel_pick_factor);
     InitTargetTypeTransformPass();
 
     if (passes.empty()) {
       RunPasses(std::vector<std::string>{
-          {"lite_quant_dequant_fuse_pass",     //
+          {"dead_code_eliminate_pass",         //
+           "lite_quant_dequant_fuse_pass",     //
            "lite_conv_elementwise_fuse_pass",  // conv-elemwise-bn
            "lite_conv_bn_fuse_pass",           //
            "lite_conv_elementwise_fuse_pass",  // conv-bn-elemwise
@@ -71,9 +73,10 @@ class Optimizer {
 #ifdef LITE_WITH_LIGHT_WEIGHT_FRAMEWORK
            "lite_elementwise_add_activation_fuse_pass",  //
 #endif
-           "static_kernel_pick_pass",        //
-           "variable_place_inference_pass",  //
-           "argument_type_display_pass",     //
+           "common_subexpression_eliminate_pass",  //
+           "static_kernel_pick_pass",              //
+           "variable_place_inference_pass",        //
+           "argument_type_display_pass",           //
 
            "type_target_cast_pass",          //
            "variable_place_inference_pass",  //
@@ -92,6 +95,10 @@ class Optimizer {
            "argument_type_display_pass",     //
 
            "runtime_context_assign_pass",
+           "constant_fold_pass",
+           "memory_schedule_pass",
+           "inplace_pass",
+           "memory_optimize_pass",
            "graph_visualze"}});
     } else {
       RunPasses(passes);
@@ -106,6 +113,11 @@ class Optimizer {
     pass->SetPreferPlace(place);
   }
 
+  // The variables to keep computed besides the fetched ones, the ops reaching
+  // neither of them are removed by the dead_code_eliminate_pass. They are set
+  // on the graph built by Run.
+  void KeepVars(const std::vector<std::string>& names) { kept_vars_ = names; }
+
   const lite::Scope* exec_scope() const { return exec_scope_; }
 
   // Generate a new program based on the mir graph.
@@ -195,6 +207,7 @@ class Optimizer {
   std::vector<Place> valid_places_;
   lite::Scope* exec_scope_{};
   Program* program_{};
+  std::vector<std::string> kept_vars_;
 };
 
 }  // namespace lite
@@ -0,0 +1,56 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/packed_weights.h"
+
+namespace paddle {
+namespace lite {
+
+std::shared_ptr<const Tensor> PackedWeights::Get(const std::string& name,
+                                                 const std::string& kind,
+                                                 const pack_t& pack) {
+  // The packing is done once, the other programs wait for it.
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& tensor = tensors_[std::make_pair(name, kind)];
+  auto res = tensor.lock();
+  if (!res) {
+    std::shared_ptr<Tensor> packed(new Tensor);
+    pack(packed.get());
+    tensor = packed;
+    res = packed;
+  }
+  return res;
+}
+
+size_t PackedWeights::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t res = 0;
+  for (auto& item : tensors_) {
+    if (!item.second.expired()) res++;
+  }
+  return res;
+}
+
+std::shared_ptr<const Tensor> PackWeight(PackedWeights* cache,
+                                         const std::string& name,
+                                         const std::string& kind,
+                                         const PackedWeights::pack_t& pack) {
+  if (cache) return cache->Get(name, kind, pack);
+  std::shared_ptr<Tensor> packed(new Tensor);
+  pack(packed.get());
+  return packed;
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,62 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <utility>
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+
+/*
+ * PackedWeights caches the weights packed by the kernels, such as the
+ * winograd transformed filters of the ARM convs, by the name of the weight
+ * and the kind of the packing. It is owned by the root scope, so that the
+ * predictors sharing the weights, and the programs of their caches, share
+ * the packed ones too, see Scope::FindPackedWeights. The packed weights are
+ * held by the kernels using them, and released with the last one.
+ */
+class PackedWeights {
+ public:
+  using pack_t = std::function<void(Tensor*)>;
+
+  // Get the weight `name` packed as `kind`, it is packed by `pack` at the
+  // first call.
+  std::shared_ptr<const Tensor> Get(const std::string& name,
+                                    const std::string& kind,
+                                    const pack_t& pack);
+
+  // The number of the packed weights in use.
+  size_t size() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<std::pair<std::string, std::string>, std::weak_ptr<const Tensor>>
+      tensors_;
+};
+
+// Pack the weight `name` by `pack`, shared through the `cache` if it is not
+// null, such as the one of a persistable weight.
+std::shared_ptr<const Tensor> PackWeight(PackedWeights* cache,
+                                         const std::string& name,
+                                         const std::string& kind,
+                                         const PackedWeights::pack_t& pack);
+
+}  // namespace lite
+}  // namespace paddle
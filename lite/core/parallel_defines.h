@@ -0,0 +1,99 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// The parallel loops of the CPU kernels, run by the WorkStealingPool with
+// LITE_WITH_THREAD_POOL, by OpenMP with ARM_WITH_OMP, and sequentially
+// otherwise. `tid` is the index of the thread running the iteration, in
+// [0, the threads of the context), like omp_get_thread_num().
+//
+//   LITE_PARALLEL_BEGIN(c, tid, chout) {
+//     ...
+//   }
+//   LITE_PARALLEL_END();
+//
+// The body is a lambda with the thread pool, it should not break or return.
+// LITE_PARALLEL_COMMON_BEGIN_THREADS runs the loop on at most `threads`
+// threads, like num_threads(threads) of OpenMP.
+//
+// The loops still written with the OpenMP pragmas keep running with OpenMP,
+// which is enabled together with the thread pool.
+
+#ifdef LITE_WITH_THREAD_POOL
+
+#include "lite/core/work_stealing_pool.h"
+
+#define LITE_PARALLEL_COMMON_BEGIN_THREADS(                              \
+    index, tid, end, begin, step, threads)                              \
+  {                                                                     \
+    const int64_t begin__ = (begin);                                    \
+    const int64_t step__ = (step);                                      \
+    const int64_t count__ = ((end)-begin__ + step__ - 1) / step__;      \
+    const int threads__ = (threads);                                    \
+    ::paddle::lite::ParallelFor(                                        \
+        count__,                                                        \
+        [&](int64_t first__, int64_t last__, int tid) {                 \
+          for (int64_t i__ = first__; i__ < last__; ++i__) {            \
+            const int index = static_cast<int>(begin__ + i__ * step__); \
+            (void)tid;
+
+#define LITE_PARALLEL_COMMON_BEGIN(index, tid, end, begin, step) \
+  LITE_PARALLEL_COMMON_BEGIN_THREADS(index, tid, end, begin, step, 0)
+
+#define LITE_PARALLEL_END() \
+  }                         \
+  },                        \
+  0,                        \
+  threads__);               \
+  }
+
+#elif defined(ARM_WITH_OMP)
+
+#include <omp.h>
+
+#define LITE_OMP_PRAGMA(x) _Pragma(#x)
+
+#define LITE_PARALLEL_COMMON_BEGIN(index, tid, end, begin, step)       \
+  _Pragma("omp parallel for") for (int index = (begin); index < (end); \
+                                   index += (step)) {                  \
+    const int tid = omp_get_thread_num();                              \
+    (void)tid;
+
+#define LITE_PARALLEL_COMMON_BEGIN_THREADS(                   \
+    index, tid, end, begin, step, threads)                    \
+  LITE_OMP_PRAGMA(omp parallel for num_threads(threads))      \
+  for (int index = (begin); index < (end); index += (step)) { \
+    const int tid = omp_get_thread_num();                     \
+    (void)tid;
+
+#define LITE_PARALLEL_END() }
+
+#else
+
+#define LITE_PARALLEL_COMMON_BEGIN(index, tid, end, begin, step) \
+  for (int index = (begin); index < (end); index += (step)) {    \
+    const int tid = 0;                                           \
+    (void)tid;
+
+#define LITE_PARALLEL_COMMON_BEGIN_THREADS( \
+    index, tid, end, begin, step, threads)  \
+  LITE_PARALLEL_COMMON_BEGIN(index, tid, end, begin, step)
+
+#define LITE_PARALLEL_END() }
+
+#endif  // LITE_WITH_THREAD_POOL
+
+#define LITE_PARALLEL_BEGIN(index, tid, num) \
+  LITE_PARALLEL_COMMON_BEGIN(index, tid, num, 0, 1)
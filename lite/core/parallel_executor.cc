@@ -0,0 +1,131 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/parallel_executor.h"
+#include <algorithm>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+namespace paddle {
+namespace lite {
+
+ParallelExecutor::ParallelExecutor(const std::vector<const OpLite*>& ops,
+                                   int num_threads)
+    : pool_(num_threads) {
+  BuildGraph(ops);
+}
+
+void ParallelExecutor::BuildGraph(const std::vector<const OpLite*>& ops) {
+  static const std::set<std::string> barrier_ops(
+      {"while", "conditional_block"});
+  int num_ops = static_cast<int>(ops.size());
+  successors_.assign(num_ops, {});
+  num_predecessors_.assign(num_ops, 0);
+  pending_.reset(new std::atomic<int>[num_ops]);
+
+  std::vector<std::set<int>> predecessors(num_ops);
+  // The last op writing a variable, and the ops reading it after that.
+  std::unordered_map<std::string, int> last_writer;
+  std::unordered_map<std::string, std::vector<int>> readers;
+  int last_barrier = -1;
+  for (int i = 0; i < num_ops; ++i) {
+    auto* op_info = ops[i]->op_info();
+    auto& deps = predecessors[i];
+    if (barrier_ops.count(op_info->Type())) {
+      for (int j = last_barrier + 1; j < i; ++j) {
+        deps.insert(j);
+      }
+      if (last_barrier >= 0) deps.insert(last_barrier);
+      last_barrier = i;
+      last_writer.clear();
+      readers.clear();
+      continue;
+    }
+    if (last_barrier >= 0) deps.insert(last_barrier);
+    for (auto& name : op_info->input_names()) {
+      auto it = last_writer.find(name);
+      if (it != last_writer.end()) deps.insert(it->second);
+    }
+    for (auto& name : op_info->output_names()) {
+      auto it = last_writer.find(name);
+      if (it != last_writer.end()) deps.insert(it->second);
+      for (int reader : readers[name]) {
+        deps.insert(reader);
+      }
+    }
+    // Record the accesses after the dependencies are found, for an op might
+    // read and write the same variable.
+    for (auto& name : op_info->input_names()) {
+      readers[name].push_back(i);
+    }
+    for (auto& name : op_info->output_names()) {
+      last_writer[name] = i;
+      readers[name].clear();
+    }
+  }
+
+  for (int i = 0; i < num_ops; ++i) {
+    predecessors[i].erase(i);
+    num_predecessors_[i] = static_cast<int>(predecessors[i].size());
+    for (int j : predecessors[i]) {
+      successors_[j].push_back(i);
+    }
+  }
+}
+
+void ParallelExecutor::Run(const std::function<void(int)>& run) {
+  int num_ops = static_cast<int>(successors_.size());
+  if (num_ops == 0) return;
+  for (int i = 0; i < num_ops; ++i) {
+    pending_[i].store(num_predecessors_[i]);
+  }
+  num_done_.store(0);
+  run_ = &run;
+  done_ = false;
+  for (int i = 0; i < num_ops; ++i) {
+    if (num_predecessors_[i] == 0) {
+      pool_.Submit([this, i] { RunFrom(i); });
+    }
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return done_; });
+  run_ = nullptr;
+}
+
+void ParallelExecutor::RunFrom(int idx) {
+  int num_ops = static_cast<int>(successors_.size());
+  while (idx >= 0) {
+    (*run_)(idx);
+    int next = -1;
+    for (int succ : successors_[idx]) {
+      if (pending_[succ].fetch_sub(1) == 1) {
+        if (next < 0) {
+          next = succ;
+        } else {
+          pool_.Submit([this, succ] { RunFrom(succ); });
+        }
+      }
+    }
+    if (num_done_.fetch_add(1) + 1 == num_ops) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_ = true;
+      done_cv_.notify_all();
+    }
+    idx = next;
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,75 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <vector>
+#include "lite/core/op_lite.h"
+#include "lite/core/thread_pool.h"
+
+namespace paddle {
+namespace lite {
+
+/*
+ * ParallelExecutor runs the ops of a program by the dependencies among them,
+ * so that the independent ones, such as the branches of an Inception block or
+ * the heads of a detection model, run concurrently on a thread pool.
+ *
+ * An op depends on the ops before it that write its inputs, and on the ones
+ * that read or write its outputs, by the variable names. The control flow ops
+ * access the variables inside their sub-blocks, so they are barriers: they
+ * run after all the ops before them, and before all the ops after them.
+ */
+class ParallelExecutor {
+ public:
+  // The ops are in the execution order of the program.
+  ParallelExecutor(const std::vector<const OpLite*>& ops, int num_threads);
+
+  // Run the i-th op by `run(i)` after the ops it depends on, and return when
+  // all the ops are done. The caller thread waits without running any op.
+  void Run(const std::function<void(int)>& run);
+
+  // The ops depending on the i-th op directly.
+  const std::vector<std::vector<int>>& successors() const {
+    return successors_;
+  }
+
+  int num_threads() const { return pool_.num_threads(); }
+
+ private:
+  void BuildGraph(const std::vector<const OpLite*>& ops);
+  // Run an op and the ops becoming ready after it, one of them is run in the
+  // current thread, and the others are submitted to the pool.
+  void RunFrom(int idx);
+
+  std::vector<std::vector<int>> successors_;
+  std::vector<int> num_predecessors_;
+  // The predecessors not done yet in the current run.
+  std::unique_ptr<std::atomic<int>[]> pending_;
+  std::atomic<int> num_done_{0};
+  const std::function<void(int)>* run_{};
+
+  std::mutex mutex_;
+  std::condition_variable done_cv_;
+  bool done_{false};
+
+  ThreadPool pool_;
+};
+
+}  // namespace lite
+}  // namespace paddle
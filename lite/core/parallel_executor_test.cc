@@ -0,0 +1,135 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/parallel_executor.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+class FakeOp : public OpLite {
+ public:
+  explicit FakeOp(const std::string& type) : OpLite(type) {}
+
+  bool AttachImpl(const cpp::OpDesc& opdesc, lite::Scope* scope) override {
+    return true;
+  }
+  void AttachKernel(KernelBase* kernel) override {}
+  std::string DebugString() const override { return "fake"; }
+};
+
+class ParallelExecutorTest : public ::testing::Test {
+ protected:
+  void AddOp(const std::vector<std::string>& inputs,
+             const std::vector<std::string>& outputs,
+             const std::string& type = "fake") {
+    cpp::OpDesc desc;
+    desc.SetType(type);
+    desc.SetInput("X", inputs);
+    desc.SetOutput("Out", outputs);
+    std::shared_ptr<OpLite> op(new FakeOp(type));
+    op->Attach(desc, &scope_);
+    ops_.push_back(op);
+  }
+
+  std::vector<const OpLite*> ops() const {
+    std::vector<const OpLite*> res;
+    for (auto& op : ops_) res.push_back(op.get());
+    return res;
+  }
+
+  Scope scope_;
+  std::vector<std::shared_ptr<OpLite>> ops_;
+};
+
+// x -> op0 -> a, a -> op1 -> b, a -> op2 -> c, (b, c) -> op3 -> d
+TEST_F(ParallelExecutorTest, diamond) {
+  AddOp({"x"}, {"a"});
+  AddOp({"a"}, {"b"});
+  AddOp({"a"}, {"c"});
+  AddOp({"b", "c"}, {"d"});
+  ParallelExecutor executor(ops(), 2);
+  auto& succ = executor.successors();
+  ASSERT_EQ(succ.size(), 4UL);
+  EXPECT_EQ(succ[0], std::vector<int>({1, 2}));
+  EXPECT_EQ(succ[1], std::vector<int>({3}));
+  EXPECT_EQ(succ[2], std::vector<int>({3}));
+  EXPECT_TRUE(succ[3].empty());
+
+  for (int repeat = 0; repeat < 3; ++repeat) {
+    std::mutex mutex;
+    std::vector<int> order;
+    // op1 and op2 wait for each other, it hangs unless they run concurrently.
+    std::atomic<int> arrived{0};
+    executor.Run([&](int idx) {
+      if (idx == 1 || idx == 2) {
+        arrived++;
+        while (arrived.load() < 2) {
+          std::this_thread::sleep_for(std::chrono::microseconds(10));
+        }
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(idx);
+    });
+    ASSERT_EQ(order.size(), 4UL);
+    EXPECT_EQ(order.front(), 0);
+    EXPECT_EQ(order.back(), 3);
+  }
+}
+
+// The ops writing a variable run after the ones reading the previous value.
+TEST_F(ParallelExecutorTest, write_after_read) {
+  AddOp({"x"}, {"a"});
+  AddOp({"a"}, {"b"});
+  AddOp({"x"}, {"a"});
+  AddOp({"a", "b"}, {"a"});
+  ParallelExecutor executor(ops(), 2);
+  auto& succ = executor.successors();
+  EXPECT_EQ(succ[0], std::vector<int>({1, 2}));
+  EXPECT_EQ(succ[1], std::vector<int>({2, 3}));
+  EXPECT_EQ(succ[2], std::vector<int>({3}));
+}
+
+// The control flow ops run after and before all the other ops.
+TEST_F(ParallelExecutorTest, barrier) {
+  AddOp({"x"}, {"a"});
+  AddOp({"y"}, {"b"});
+  AddOp({"c"}, {"d"}, "while");
+  AddOp({"x"}, {"e"});
+  ParallelExecutor executor(ops(), 2);
+  auto& succ = executor.successors();
+  EXPECT_EQ(succ[0], std::vector<int>({2}));
+  EXPECT_EQ(succ[1], std::vector<int>({2}));
+  EXPECT_EQ(succ[2], std::vector<int>({3}));
+
+  std::vector<int> order;
+  std::mutex mutex;
+  executor.Run([&](int idx) {
+    std::lock_guard<std::mutex> lock(mutex);
+    order.push_back(idx);
+  });
+  ASSERT_EQ(order.size(), 4UL);
+  EXPECT_EQ(order[2], 2);
+  EXPECT_EQ(order[3], 3);
+}
+
+}  // namespace lite
+}  // namespace paddle
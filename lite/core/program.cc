@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #include "lite/core/program.h"
+#include <algorithm>
+#include <set>
 #include <unordered_map>
+#include "lite/core/memory_pool.h"
 #include "lite/model_parser/cpp/block_desc.h"
 #include "lite/model_parser/cpp/op_desc.h"
 #include "lite/model_parser/cpp/var_desc.h"
@@ -25,6 +28,77 @@
 namespace paddle {
 namespace lite {
 
+RuntimeProgram::RuntimeProgram(const cpp::ProgramDesc& desc,
+                               const std::shared_ptr<Scope>& scope) {
+  Program program(desc, scope, {});
+  // Create the kernels of the target places, and filter out the specific
+  // kernel with the target alias.
+  for (auto& op : program.ops()) {
+    auto kernel_type = op->op_info()->GetAttr<std::string>(kKernelTypeAttr);
+    std::string op_type, alias;
+    Place place;
+    KernelBase::ParseKernelType(kernel_type, &op_type, &alias, &place);
+    auto kernels = op->CreateKernels({place});
+    // filter out a kernel
+    auto it = std::find_if(
+        kernels.begin(), kernels.end(), [&](std::unique_ptr<KernelBase>& it) {
+          return it->alias() == alias;
+        });
+    CHECK(it != kernels.end());
+    (*it)->SetContext(ContextScheduler::Global().NewContext((*it)->target()));
+    instructions_.emplace_back(op, std::move(*it));
+  }
+  if (instructions_.empty()) {
+    LOG(FATAL) << "no instructions";
+  }
+  CHECK(program.exec_scope());
+  exec_scope_ = program.exec_scope();
+  scope_ = scope;
+}
+
+RuntimeProgram::~RuntimeProgram() {
+  if (scope_) {
+    // The ops refer to the variables of the exec scope, release them first.
+    parallel_executor_.reset();
+    instructions_.clear();
+    scope_->DeleteScope(exec_scope_);
+  }
+}
+
+void RuntimeProgram::set_inter_op_threads(int x) {
+  CHECK(!has_run_) << "The inter-op threads should be set before the first run";
+  inter_op_threads_ = x;
+}
+
+void RuntimeProgram::SetRunMode(lite_api::PowerMode mode, int threads) {
+  run_mode_set_ = true;
+  power_mode_ = mode;
+  threads_ = threads;
+#ifdef LITE_WITH_ARM
+  arm_contexts_set_ = false;
+#endif
+}
+
+void RuntimeProgram::SetX86RunMode(int threads,
+                                   const std::vector<int>& cpu_ids) {
+  x86_threads_ = threads;
+  x86_cpu_ids_ = cpu_ids;
+#ifdef LITE_WITH_X86
+  x86_contexts_set_ = false;
+#endif
+}
+
+void RuntimeProgram::CopySettingsFrom(const RuntimeProgram& other) {
+  set_memory_plan_enabled(other.memory_plan_enabled());
+  set_static_shape(other.static_shape());
+  set_memory_pool_enabled(other.memory_pool_enabled());
+  if (other.run_mode_set()) {
+    SetRunMode(other.power_mode(), other.threads());
+  }
+  set_inter_op_threads(other.inter_op_threads());
+  SetX86RunMode(other.x86_threads(), other.x86_cpu_ids());
+}
+
 void RuntimeProgram::SaveOpInfosToProgram(cpp::ProgramDesc* desc) {
   CHECK(desc);
   // NOTE: RuntimeProgram do not has all meta info, so save model just update
@@ -32,13 +106,30 @@ void RuntimeProgram::SaveOpInfosToProgram(cpp::ProgramDesc* desc) {
   CHECK(desc->BlocksSize());
   auto& main_block = *desc->GetBlock<cpp::BlockDesc>(0);
   main_block.ClearOps();
+  std::vector<cpp::OpDesc*> op_descs;
   for (auto& node : instructions_) {
     auto* op = main_block.AddOp<cpp::OpDesc>();
     *op = *node.op()->op_info();
     op->SetAttr(kKernelTypeAttr, node.kernel()->SerializedKernelType());
+    op_descs.push_back(op);
+  }
+  // Persist the memory plan, so that the LightPredictor needs not re-plan.
+  if (memory_planner_inited_) {
+    memory_planner_.SavePlan(&op_descs);
   }
 }
 
+namespace {
+
+// The tensors computed at optimize time, such as the folded constants, are
+// persistable though their vars are not in the origin program.
+bool IsPersistableTensor(Scope* scope, const std::string& name) {
+  auto* var = scope->FindVar(name);
+  return var && var->IsType<Tensor>() && var->Get<Tensor>().persistable();
+}
+
+}  // namespace
+
 // `UpdateVarsOfProgram` will remove unused var_descs and add new created
 // vars' descs in the block 0. Now, the type of a new created var can only
 // be LOD_TENSOR.
@@ -67,7 +158,8 @@ void RuntimeProgram::UpdateVarsOfProgram(cpp::ProgramDesc* desc) {
         auto* v = main_block.AddVar<cpp::VarDesc>();
         v->SetName((it->second).Name());
         v->SetType((it->second).GetType());
-        v->SetPersistable((it->second).Persistable());
+        v->SetPersistable((it->second).Persistable() ||
+                          IsPersistableTensor(scope, in_name));
       } else {
         // New created vars must be LOD_TENSOR
         auto* v = main_block.AddVar<cpp::VarDesc>();
@@ -91,7 +183,8 @@ void RuntimeProgram::UpdateVarsOfProgram(cpp::ProgramDesc* desc) {
         auto* v = main_block.AddVar<cpp::VarDesc>();
         v->SetName((it->second).Name());
         v->SetType((it->second).GetType());
-        v->SetPersistable((it->second).Persistable());
+        v->SetPersistable((it->second).Persistable() ||
+                          IsPersistableTensor(scope, out_name));
       } else {
         // New created vars must be LOD_TENSOR
         auto* v = main_block.AddVar<cpp::VarDesc>();
@@ -111,12 +204,290 @@ void RuntimeProgram::UpdateVarsOfProgram(cpp::ProgramDesc* desc) {
   }
 }
 
-void RuntimeProgram::Run() {
+void RuntimeProgram::InitMemoryPlanner() {
+  std::vector<const OpLite*> ops;
+  for (auto& inst : instructions_) {
+    ops.push_back(inst.op());
+  }
+  memory_planner_.Init(ops, exec_scope_);
+  if (memory_planner_.LoadPlan()) {
+    memory_planner_.Apply();
+  }
+  memory_planner_inited_ = true;
+}
+
+void RuntimeProgram::UpdateMemoryPlan() {
+  if (memory_planner_.IsValid()) return;
+  memory_planner_.Plan();
+  memory_planner_.Apply();
+  VLOG(3) << "planned peak bytes " << memory_planner_.planned_peak_bytes();
+}
+
+bool RuntimeProgram::CheckInputShapesUnchanged() {
+  auto* feed_var = exec_scope_ ? exec_scope_->FindVar("feed") : nullptr;
+  if (!feed_var) return false;
+  auto& feed_list = *feed_var->GetMutable<std::vector<lite::Tensor>>();
+  bool unchanged = feed_list.size() == input_dims_.size();
+  for (size_t i = 0; unchanged && i < feed_list.size(); ++i) {
+    unchanged = feed_list[i].dims() == input_dims_[i] &&
+                feed_list[i].lod() == input_lods_[i];
+  }
+  if (!unchanged) {
+    input_dims_.clear();
+    input_lods_.clear();
+    for (auto& tensor : feed_list) {
+      input_dims_.push_back(tensor.dims());
+      input_lods_.push_back(tensor.lod());
+    }
+  }
+  return unchanged;
+}
+
+#ifdef LITE_WITH_ARM
+namespace {
+
+// Bind the current thread to the ARM run mode, it is skipped if the same one
+// is bound again.
+void ApplyARMRunMode(lite_api::PowerMode mode,
+                     const std::vector<int>& active_ids) {
+  static thread_local lite_api::PowerMode applied_mode =
+      lite_api::LITE_POWER_NO_BIND;
+  static thread_local std::vector<int> applied_active_ids;
+  if (mode == applied_mode && active_ids == applied_active_ids) {
+    return;
+  }
+  DeviceInfo::Global().BindRunMode(mode, active_ids);
+  applied_mode = mode;
+  applied_active_ids = active_ids;
+}
+
+}  // namespace
+
+void RuntimeProgram::SetupARMContexts(bool parallel_program) {
+  DeviceInfo::Init();
+  if (run_mode_set_) {
+    int threads = threads_;
+    if (parallel_program) {
+      threads = std::max(threads / inter_op_threads_, 1);
+    }
+    DeviceInfo::Global().GetRunMode(
+        power_mode_, threads, &arm_mode_, &arm_active_ids_);
+  }
+  if (!parallel_program && !arm_workspace_) {
+    arm_workspace_ = std::make_shared<TensorLite>();
+  }
+  for (auto& inst : instructions_) {
+    auto* kernel = inst.mutable_kernel();
+    if (kernel->target() == TARGET(kARM) && kernel->mutable_context()) {
+      auto& ctx = kernel->mutable_context()->As<ARMContext>();
+      if (run_mode_set_) {
+        ctx.SetRunMode(arm_mode_, arm_active_ids_);
+      }
+      // The concurrent kernels use the workspaces of their threads.
+      if (!parallel_program) {
+        ctx.set_workspace(arm_workspace_);
+      }
+    }
+  }
+  arm_contexts_set_ = true;
+}
+#endif  // LITE_WITH_ARM
+
+#ifdef LITE_WITH_X86
+namespace {
+
+// Apply the X86 run mode to the current thread, it is skipped if the same
+// one is applied again.
+void ApplyX86RunMode(int threads, const std::vector<int>& cpu_ids) {
+  static thread_local int applied_threads = 0;
+  static thread_local std::vector<int> applied_cpu_ids;
+  if (threads != applied_threads) {
+    x86::SetNumThreads(threads);
+    applied_threads = threads;
+  }
+  if (!cpu_ids.empty() && cpu_ids != applied_cpu_ids) {
+    if (!x86::BindCurrentThread(cpu_ids)) {
+      LOG(WARNING) << "failed to bind the thread to the cores";
+    }
+    applied_cpu_ids = cpu_ids;
+  }
+}
+
+}  // namespace
+
+void RuntimeProgram::SetupX86Contexts(bool parallel_program) {
+  int threads = std::max(x86_threads_, 1);
+  if (parallel_program) {
+    threads = std::max(threads / inter_op_threads_, 1);
+  } else if (!x86_workspace_) {
+    x86_workspace_ = std::make_shared<TensorLite>();
+  }
   for (auto& inst : instructions_) {
+    auto* kernel = inst.mutable_kernel();
+    if (kernel->target() == TARGET(kX86) && kernel->mutable_context()) {
+      auto& ctx = kernel->mutable_context()->As<X86Context>();
+      ctx.SetRunMode(threads, x86_cpu_ids_);
+      // The concurrent kernels allocate their own workspaces.
+      if (!parallel_program) {
+        ctx.set_workspace(x86_workspace_);
+      }
+    }
+  }
+  x86_contexts_set_ = true;
+}
+#endif  // LITE_WITH_X86
+
+void RuntimeProgram::Run() { RunImpl(nullptr); }
+
+void RuntimeProgram::RunPartial(const std::vector<std::string>& targets,
+                                const std::vector<std::string>& provided) {
+  auto key = std::make_pair(targets, provided);
+  auto it = partial_runs_.find(key);
+  if (it == partial_runs_.end()) {
+    it = partial_runs_.emplace(key, SelectInstructions(targets, provided))
+             .first;
+    VLOG(4) << "partial run of " << it->second.size() << " instructions in "
+            << instructions_.size();
+  }
+  if (memory_plan_enabled_ && inter_op_threads_ <= 1 && exec_scope_ &&
+      !memory_planner_inited_) {
+    InitMemoryPlanner();
+  }
+  if (memory_planner_inited_) {
+    memory_planner_.Exclude(targets);
+    memory_planner_.Exclude(provided);
+  }
+  RunImpl(&it->second);
+}
+
+std::vector<size_t> RuntimeProgram::SelectInstructions(
+    const std::vector<std::string>& targets,
+    const std::vector<std::string>& provided) const {
+  std::set<std::string> provided_vars(provided.begin(), provided.end());
+  // The variables needed but not computed by the instructions after.
+  std::set<std::string> needed;
+  for (auto& name : targets) {
+    CHECK(exec_scope_->FindVar(name)) << "no variable " << name;
+    if (!provided_vars.count(name)) needed.insert(name);
+  }
+  std::vector<size_t> res;
+  for (size_t i = instructions_.size(); i-- > 0;) {
+    auto* op_info = instructions_[i].op()->op_info();
+    auto outputs = op_info->output_names();
+    bool is_needed = std::any_of(
+        outputs.begin(), outputs.end(), [&](const std::string& name) {
+          return needed.count(name) > 0;
+        });
+    if (!is_needed) continue;
+    res.push_back(i);
+    for (auto& name : outputs) {
+      needed.erase(name);
+    }
+    for (auto& name : op_info->input_names()) {
+      if (!provided_vars.count(name)) needed.insert(name);
+    }
+  }
+  std::reverse(res.begin(), res.end());
+  // The variables left needed are the feed list and the weights. A temporary
+  // one left is computed by no instruction, such as a variable renamed by the
+  // inplace_pass or the memory_optimize_pass, which should be kept by
+  // CxxConfig::set_kept_vars, so is a provided one read by no instruction.
+  for (auto& name : needed) {
+    CHECK(name == "feed" || !exec_scope_->FindLocalVar(name))
+        << "no instruction computes " << name
+        << ", it may be renamed by the optimization, keep it by set_kept_vars";
+  }
+  std::set<std::string> read_vars(targets.begin(), targets.end());
+  for (auto i : res) {
+    for (auto& name : instructions_[i].op()->op_info()->input_names()) {
+      read_vars.insert(name);
+    }
+  }
+  for (auto& name : provided) {
+    CHECK(read_vars.count(name))
+        << "no instruction reads the provided variable " << name
+        << ", it may be renamed by the optimization, keep it by set_kept_vars";
+  }
+  return res;
+}
+
+void RuntimeProgram::RunImpl(const std::vector<size_t>* selected) {
+  HostMemoryPool::ScopedEnable memory_pool_guard(memory_pool_enabled_);
+  // The partial runs of a parallel program run in sequence, but leave the
+  // workspaces and the memory unshared for the concurrent kernels.
+  bool parallel_program = inter_op_threads_ > 1;
+  bool parallel = parallel_program && !selected;
+#ifdef LITE_WITH_ARM
+  if (!arm_contexts_set_) {
+    SetupARMContexts(parallel_program);
+  }
+  if (!parallel) {
+    if (run_mode_set_) {
+      ApplyARMRunMode(arm_mode_, arm_active_ids_);
+    } else {
+      ApplyARMRunMode(DeviceInfo::Global().mode(),
+                      DeviceInfo::Global().active_ids());
+    }
+  }
+#endif
+#ifdef LITE_WITH_X86
+  if (!x86_contexts_set_) {
+    SetupX86Contexts(parallel_program);
+  }
+  if (x86_threads_ > 0 && !parallel) {
+    ApplyX86RunMode(x86_threads_, x86_cpu_ids_);
+  }
+#endif
+  if (memory_plan_enabled_ && !parallel_program && exec_scope_ &&
+      !memory_planner_inited_) {
+    InitMemoryPlanner();
+  }
+  has_run_ = true;
+  if (selected) {
+    // The partial run infers the shapes from the provided variables, the
+    // next full run infers them again.
+    RunSequential(selected, false);
+    shape_reusable_ = false;
+    launch_thunks_valid_ = false;
+    return;
+  }
+  bool input_shapes_unchanged = CheckInputShapesUnchanged();
+  bool reuse_shapes =
+      shape_reusable_ && (static_shape_ || input_shapes_unchanged);
+  if (parallel) {
+    RunParallel(reuse_shapes);
+  } else if (reuse_shapes && launch_thunks_valid_) {
+    RunLaunchThunks();
+  } else {
+    RunSequential(nullptr, reuse_shapes);
+  }
+  if (!reuse_shapes) {
+    shape_reusable_ = std::none_of(
+        instructions_.begin(), instructions_.end(), [](const Instruction& x) {
+          return x.shape_dynamic();
+        });
+    launch_thunks_valid_ = false;
+  }
+#ifndef LITE_WITH_PROFILE
+  // The profiled runs keep the records of every instruction.
+  if (shape_reusable_ && !parallel_program && !launch_thunks_valid_) {
+    BuildLaunchThunks();
+  }
+#endif  // LITE_WITH_PROFILE
+  if (memory_plan_enabled_ && memory_planner_inited_) {
+    UpdateMemoryPlan();
+  }
+}
+
+void RuntimeProgram::RunSequential(const std::vector<size_t>* selected,
+                                   bool reuse_shapes) {
+  size_t num = selected ? selected->size() : instructions_.size();
+  for (size_t i = 0; i < num; ++i) {
+    auto& inst = instructions_[selected ? selected->at(i) : i];
     VLOG(4) << ">> Running kernel: " << inst.op()->op_info()->Repr()
             << " on Target " << TargetToStr(inst.kernel()->target());
 
-    inst.Run();
+    inst.Run(reuse_shapes);
 #ifdef LITE_WITH_PROFILE
 #ifdef LITE_WITH_PRECISION_PROFILE
     LITE_PRECISION_PROFILE(inst)
@@ -125,6 +496,81 @@ void RuntimeProgram::Run() {
   }
 }
 
+void RuntimeProgram::BuildLaunchThunks() {
+  launch_thunks_.clear();
+  thunk_outputs_.clear();
+  for (auto& inst : instructions_) {
+    // The ops run once are done.
+    if (inst.op()->run_once()) continue;
+    LaunchThunk thunk;
+    thunk.kernel = inst.mutable_kernel();
+    thunk.outputs_begin = thunk_outputs_.size();
+    for (size_t i = 0; i < inst.output_tensors().size(); ++i) {
+      thunk_outputs_.push_back(RecordedOutput{inst.output_tensors()[i],
+                                              inst.output_dims()[i],
+                                              inst.output_lods()[i]});
+    }
+    thunk.outputs_end = thunk_outputs_.size();
+    launch_thunks_.push_back(thunk);
+  }
+  launch_thunks_valid_ = true;
+}
+
+void RuntimeProgram::RunLaunchThunks() {
+  for (auto& thunk : launch_thunks_) {
+    // The output variables might be shared with others, restore the shapes.
+    for (size_t i = thunk.outputs_begin; i < thunk.outputs_end; ++i) {
+      auto& output = thunk_outputs_[i];
+      output.tensor->Resize(output.dims);
+      output.tensor->set_lod(output.lod);
+    }
+    thunk.kernel->LaunchPrepared();
+  }
+}
+
+void RuntimeProgram::RunParallel(bool reuse_shapes) {
+  if (!parallel_executor_) {
+    std::vector<const OpLite*> ops;
+    for (auto& inst : instructions_) {
+      ops.push_back(inst.op());
+    }
+    parallel_executor_.reset(new ParallelExecutor(ops, inter_op_threads_));
+  }
+  bool memory_pool_enabled = memory_pool_enabled_;
+#ifdef LITE_WITH_X86
+  int x86_intra_op_threads = std::max(x86_threads_ / inter_op_threads_, 1);
+#endif
+  parallel_executor_->Run([&](int idx) {
+    // The settings of the thread running the program are per thread, apply
+    // them in the thread running the instruction.
+    HostMemoryPool::ScopedEnable memory_pool_guard(memory_pool_enabled);
+    auto& inst = instructions_[idx];
+#ifdef LITE_WITH_ARM
+    if (run_mode_set_) {
+      ApplyARMRunMode(arm_mode_, arm_active_ids_);
+    } else {
+      ApplyARMRunMode(DeviceInfo::Global().mode(),
+                      DeviceInfo::Global().active_ids());
+    }
+    // The concurrent kernels use the workspace of the thread running them.
+    auto* kernel = inst.mutable_kernel();
+    if (kernel->target() == TARGET(kARM) && kernel->mutable_context()) {
+      static thread_local std::shared_ptr<TensorLite> workspace =
+          std::make_shared<TensorLite>();
+      kernel->mutable_context()->As<ARMContext>().set_workspace(workspace);
+    }
+#endif
+#ifdef LITE_WITH_X86
+    if (x86_threads_ > 0) {
+      ApplyX86RunMode(x86_intra_op_threads, x86_cpu_ids_);
+    }
+#endif
+    VLOG(4) << ">> Running kernel: " << inst.op()->op_info()->Repr()
+            << " on Target " << TargetToStr(inst.kernel()->target());
+    inst.Run(reuse_shapes);
+  });
+}
+
 void Program::Build(const cpp::ProgramDesc& prog) {
   CHECK(ops_.empty()) << "Executor duplicate Build found";
 
@@ -154,9 +600,10 @@ void Program::Build(const cpp::ProgramDesc& prog) {
 void Program::PrepareWorkspace(const cpp::ProgramDesc& prog) {
   CHECK(!exec_scope_) << "Duplicate PrepareWorkspace found";
   exec_scope_ = &scope_->NewScope();
-  // Create Feed and Fetch var.
-  scope_->Var("feed")->GetMutable<std::vector<lite::Tensor>>();
-  scope_->Var("fetch")->GetMutable<std::vector<lite::Tensor>>();
+  // Create Feed and Fetch var, they are in the exec scope so that the programs
+  // sharing the weights can be fed separately.
+  exec_scope_->Var("feed")->GetMutable<std::vector<lite::Tensor>>();
+  exec_scope_->Var("fetch")->GetMutable<std::vector<lite::Tensor>>();
   tmp_vars_.push_back("feed");
   tmp_vars_.push_back("fetch");
 
@@ -181,12 +628,68 @@ void Program::PrepareWorkspace(const cpp::ProgramDesc& prog) {
   }
 }
 
-void Instruction::Run() {
+namespace {
+
+// Whether the op reads its output shapes from the data of an input tensor,
+// such as the OutSize of interpolate or the Shape of reshape. The shapes of
+// such ops change with the data even if the input shapes are unchanged.
+bool HasShapeTensorInputs(const OpInfo& op_info) {
+  static const std::set<std::string> kShapeTensorArgs(
+      {"OutSize", "SizeTensor", "Shape", "ShapeTensor", "ShapeTensorList",
+       "StartsTensor", "EndsTensor", "StartsTensorList", "EndsTensorList",
+       "AxisTensor", "SectionsTensorList", "ExpandTimes",
+       "expand_times_tensor"});
+  for (auto& arg : op_info.InputArgumentNames()) {
+    if (kShapeTensorArgs.count(arg) && !op_info.Input(arg).empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+void Instruction::RecordShapes() {
+  if (!shape_recorded_) {
+    if (HasShapeTensorInputs(*op_->op_info())) {
+      VLOG(4) << op_->op_info()->Type() << " infers the shapes from data";
+      shape_dynamic_ = true;
+    }
+    for (auto& name : op_->op_info()->output_names()) {
+      auto* var = op_->scope()->FindVar(name);
+      CHECK(var) << "no variable called " << name << " found";
+      if (!var->IsType<lite::Tensor>()) {
+        // The shapes of the non-tensor outputs can not be recorded.
+        shape_dynamic_ = true;
+        continue;
+      }
+      output_tensors_.push_back(var->GetMutable<lite::Tensor>());
+    }
+    output_dims_.resize(output_tensors_.size());
+    output_lods_.resize(output_tensors_.size());
+    shape_recorded_ = true;
+  }
+  for (size_t i = 0; i < output_tensors_.size(); ++i) {
+    output_dims_[i] = output_tensors_[i]->dims();
+    output_lods_[i] = output_tensors_[i]->lod();
+  }
+}
+
+void Instruction::CheckRecordedShapes() {
+  for (size_t i = 0; i < output_tensors_.size(); ++i) {
+    if (output_tensors_[i]->dims() != output_dims_[i] ||
+        output_tensors_[i]->lod() != output_lods_[i]) {
+      VLOG(4) << op_->op_info()->Type() << " changes the inferred shapes";
+      shape_dynamic_ = true;
+      return;
+    }
+  }
+}
+
+void Instruction::Run(bool reuse_shapes) {
 #ifdef LITE_WITH_PROFILE
   profile::ProfileBlock x(profile_id_);
 #endif  // LITE_WITH_PROFILE
-  CHECK(op_) << "op null";
-  CHECK(kernel_) << "kernel null";
   if (first_epoch_) {
     first_epoch_ = false;
     CHECK(op_->CheckShape());
@@ -194,8 +697,19 @@ void Instruction::Run() {
 
   if (op_->run_once() && has_run_) return;
   VLOG(4) << "kernel launch";
-  op_->InferShape();
-  kernel_->Launch();
+  if (reuse_shapes && shape_recorded_ && !shape_dynamic_) {
+    // The output variables might be shared with others, restore the shapes.
+    for (size_t i = 0; i < output_tensors_.size(); ++i) {
+      output_tensors_[i]->Resize(output_dims_[i]);
+      output_tensors_[i]->set_lod(output_lods_[i]);
+    }
+    kernel_->Launch();
+  } else {
+    op_->InferShape();
+    RecordShapes();
+    kernel_->Launch();
+    CheckRecordedShapes();
+  }
   has_run_ = true;
 }
 
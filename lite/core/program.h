@@ -14,13 +14,16 @@
 
 #pragma once
 #include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 #include "lite/core/kernel.h"
+#include "lite/core/memory_planner.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
+#include "lite/core/parallel_executor.h"
 #include "lite/model_parser/cpp/program_desc.h"
 #ifdef LITE_WITH_PROFILE
 #include "lite/core/profile/basic_profiler.h"
@@ -88,6 +91,8 @@ struct Instruction {
   Instruction(const std::shared_ptr<OpLite>& op,
               std::unique_ptr<KernelBase>&& kernel)
       : op_(op), kernel_(std::move(kernel)) {
+    CHECK(op_) << "op null";
+    CHECK(kernel_) << "kernel null";
 #ifdef LITE_WITH_PROFILE
     profile_id_ = profile::BasicProfiler<profile::BasicTimer>::Global()
                       .NewRcd(kernel_->SerializedKernelType())
@@ -95,8 +100,21 @@ struct Instruction {
 #endif  // LITE_WITH_PROFILE
   }
 
-  // Run the instruction.
-  void Run();
+  // Run the instruction. If `reuse_shapes` is true, the InferShape is skipped
+  // and the output shapes recorded in the last InferShape are restored, it is
+  // only valid when the input shapes are unchanged.
+  void Run(bool reuse_shapes = false);
+
+  // Whether the output shapes can change with the input data, that is the op
+  // infers them from the data of an input tensor, or the kernel changes the
+  // shapes inferred by InferShape. The recorded shapes can not be reused for
+  // such instructions.
+  bool shape_dynamic() const { return shape_dynamic_; }
+
+  // The output tensors and their shapes recorded in the last InferShape.
+  const std::vector<Tensor*>& output_tensors() const { return output_tensors_; }
+  const std::vector<DDim>& output_dims() const { return output_dims_; }
+  const std::vector<LoD>& output_lods() const { return output_lods_; }
 
   friend STL::ostream& operator<<(STL::ostream& os, const Instruction& other);
 
@@ -110,6 +128,17 @@ struct Instruction {
   bool first_epoch_{true};
   bool has_run_{false};
 
+  // Record the output shapes after InferShape.
+  void RecordShapes();
+  // Check whether the kernel changed the recorded output shapes.
+  void CheckRecordedShapes();
+
+  std::vector<Tensor*> output_tensors_;
+  std::vector<DDim> output_dims_;
+  std::vector<LoD> output_lods_;
+  bool shape_recorded_{false};
+  bool shape_dynamic_{false};
+
 #ifdef LITE_WITH_PROFILE
   // for profiler
   int profile_id_{-1};
@@ -127,12 +156,76 @@ class LITE_API RuntimeProgram {
       LOG(FATAL) << "no instructions";
     }
   }
+  // Create from an optimized program, whose ops record the picked kernels in
+  // kKernelTypeAttr. The weights are shared from `scope`, and the temporary
+  // variables are created in a new exec scope, which is deleted with the
+  // program. The `desc` should outlive the program, for the sub-blocks are
+  // referred by the control flow ops.
+  RuntimeProgram(const cpp::ProgramDesc& desc,
+                 const std::shared_ptr<Scope>& scope);
+  ~RuntimeProgram();
 
   void Run();
 
+  // Run only the instructions needed to compute the `targets`, taking the
+  // `provided` variables as computed, whose tensors are set in the exec scope
+  // by the caller. The instructions after the targets, and the ones before
+  // the provided variables, are skipped. The targets and the provided
+  // variables are taken out of the memory plan, to keep their data across the
+  // partial runs. The instructions run in sequence.
+  void RunPartial(const std::vector<std::string>& targets,
+                  const std::vector<std::string>& provided = {});
+
   void set_exec_scope(lite::Scope* x) { exec_scope_ = x; }
   lite::Scope* exec_scope() { return exec_scope_; }
 
+  // Pack the temporary tensors into a single arena planned by
+  // `MemoryPlanner`, it is enabled by default.
+  void set_memory_plan_enabled(bool x) { memory_plan_enabled_ = x; }
+  bool memory_plan_enabled() const { return memory_plan_enabled_; }
+  // Infer the shapes in the first run only, and reuse them in the following
+  // runs, the input shapes should be fixed. It is disabled by default, and the
+  // InferShape is skipped only if the input shapes are unchanged.
+  void set_static_shape(bool x) { static_shape_ = x; }
+  bool static_shape() const { return static_shape_; }
+
+  // Serve the host memory allocated in `Run` by the HostMemoryPool.
+  void set_memory_pool_enabled(bool x) { memory_pool_enabled_ = x; }
+  bool memory_pool_enabled() const { return memory_pool_enabled_; }
+
+  // Run the ARM kernels with the power mode and threads, instead of the
+  // default run mode in DeviceInfo. The mode is kept in the contexts of the
+  // kernels, and bound to the threads running the program.
+  void SetRunMode(lite_api::PowerMode mode, int threads);
+  bool run_mode_set() const { return run_mode_set_; }
+  lite_api::PowerMode power_mode() const { return power_mode_; }
+  int threads() const { return threads_; }
+
+  // Run the independent instructions concurrently on `x` threads by the
+  // ParallelExecutor, 0 or 1 to run them in sequence (by default). The
+  // threads of the run mode are split among them, each kernel runs with
+  // threads / x threads. It should be set before the first run, and the
+  // memory plan is disabled, for the lifetimes of the temporary tensors are
+  // not sequential any more.
+  void set_inter_op_threads(int x);
+  int inter_op_threads() const { return inter_op_threads_; }
+
+  // Apply the threads of the math library and the cores to bind for the X86
+  // kernels in the thread running the program, the threads are split among
+  // the inter-op threads as above. `threads` 0 keeps the settings of the
+  // thread, and no core is bound if `cpu_ids` is empty.
+  void SetX86RunMode(int threads, const std::vector<int>& cpu_ids = {});
+  int x86_threads() const { return x86_threads_; }
+  const std::vector<int>& x86_cpu_ids() const { return x86_cpu_ids_; }
+
+  // Copy the settings above from another program.
+  void CopySettingsFrom(const RuntimeProgram& other);
+
+  // The arena size of the memory plan, 0 if not planned yet.
+  size_t planned_peak_bytes() const {
+    return memory_planner_.planned_peak_bytes();
+  }
+
   size_t num_instructions() const { return instructions_.size(); }
 
   const std::vector<Instruction>& instructions() const { return instructions_; }
@@ -148,8 +241,90 @@ class LITE_API RuntimeProgram {
 
  private:
   RuntimeProgram(const RuntimeProgram&) = delete;
+  // Initialize the memory planner and restore the persisted plan if any.
+  void InitMemoryPlanner();
+  // Re-plan the memory if the plan is out of date.
+  void UpdateMemoryPlan();
+  // Compare the dims and LoD of the feed tensors with the last run.
+  bool CheckInputShapesUnchanged();
+#ifdef LITE_WITH_ARM
+  // Set the run mode of the ARM kernels, and share a workspace among them if
+  // they run in sequence.
+  void SetupARMContexts(bool parallel_program);
+#endif
+#ifdef LITE_WITH_X86
+  // Set the run mode of the X86 kernels, and share a workspace among them if
+  // they run in sequence.
+  void SetupX86Contexts(bool parallel_program);
+#endif
+  // Run all the instructions, or the `selected` ones only.
+  void RunImpl(const std::vector<size_t>* selected);
+  // Select the instructions needed by RunPartial, in order.
+  std::vector<size_t> SelectInstructions(
+      const std::vector<std::string>& targets,
+      const std::vector<std::string>& provided) const;
+  // Run the instructions in order.
+  void RunSequential(const std::vector<size_t>* selected, bool reuse_shapes);
+  // Run the instructions by the ParallelExecutor.
+  void RunParallel(bool reuse_shapes);
+  // Flatten the kernels to launch and the output shapes to restore, for the
+  // runs reusing the shapes.
+  void BuildLaunchThunks();
+  // Run the launch thunks, without the per instruction checks and logs.
+  void RunLaunchThunks();
+
   std::vector<Instruction> instructions_;
   lite::Scope* exec_scope_{};
+  // The parent of the exec scope owned by the program, if any.
+  std::shared_ptr<Scope> scope_;
+  MemoryPlanner memory_planner_;
+  bool memory_plan_enabled_{true};
+  bool memory_planner_inited_{false};
+  // The dims and LoD of the feed tensors in the last run.
+  std::vector<DDim> input_dims_;
+  std::vector<LoD> input_lods_;
+  bool static_shape_{false};
+  bool memory_pool_enabled_{false};
+  // Whether the shapes recorded by the instructions can be reused.
+  bool shape_reusable_{false};
+  bool run_mode_set_{false};
+  lite_api::PowerMode power_mode_{lite_api::LITE_POWER_NO_BIND};
+  int threads_{1};
+  int inter_op_threads_{0};
+  int x86_threads_{0};
+  std::vector<int> x86_cpu_ids_;
+  bool has_run_{false};
+  std::unique_ptr<ParallelExecutor> parallel_executor_;
+
+  struct LaunchThunk {
+    KernelBase* kernel;
+    // [begin, end) of the outputs in `thunk_outputs_`.
+    size_t outputs_begin;
+    size_t outputs_end;
+  };
+  struct RecordedOutput {
+    Tensor* tensor;
+    DDim dims;
+    LoD lod;
+  };
+  std::vector<LaunchThunk> launch_thunks_;
+  std::vector<RecordedOutput> thunk_outputs_;
+  bool launch_thunks_valid_{false};
+  // The instructions selected for the (targets, provided) of RunPartial.
+  std::map<std::pair<std::vector<std::string>, std::vector<std::string>>,
+           std::vector<size_t>>
+      partial_runs_;
+#ifdef LITE_WITH_ARM
+  bool arm_contexts_set_{false};
+  // The run mode resolved for the kernels.
+  lite_api::PowerMode arm_mode_{lite_api::LITE_POWER_NO_BIND};
+  std::vector<int> arm_active_ids_;
+  std::shared_ptr<TensorLite> arm_workspace_;
+#endif
+#ifdef LITE_WITH_X86
+  bool x86_contexts_set_{false};
+  std::shared_ptr<TensorLite> x86_workspace_;
+#endif
 };
 
 }  // namespace lite
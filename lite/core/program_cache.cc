@@ -0,0 +1,104 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/program_cache.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+
+std::vector<Tensor>* GetTensorList(Scope* exec_scope, const char* name) {
+  auto* var = exec_scope->FindVar(name);
+  CHECK(var) << "no " << name << " variable in exec_scope";
+  return var->GetMutable<std::vector<Tensor>>();
+}
+
+}  // namespace
+
+RuntimeProgramCache::RuntimeProgramCache(RuntimeProgram* primary,
+                                         const creator_t& create,
+                                         size_t capacity)
+    : primary_(primary), create_(create), capacity_(capacity) {
+  CHECK(primary_);
+  feed_list_ = GetTensorList(primary_->exec_scope(), "feed");
+  fetch_list_ = GetTensorList(primary_->exec_scope(), "fetch");
+}
+
+RuntimeProgramCache::key_t RuntimeProgramCache::InputSignature() const {
+  key_t key;
+  for (auto& tensor : *feed_list_) {
+    auto& dims = tensor.dims();
+    key.push_back(static_cast<int64_t>(dims.size()));
+    for (size_t i = 0; i < dims.size(); i++) {
+      key.push_back(dims[i]);
+    }
+    key.push_back(static_cast<int64_t>(tensor.lod().size()));
+  }
+  return key;
+}
+
+RuntimeProgram* RuntimeProgramCache::Lookup(const key_t& key) {
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    programs_.splice(programs_.begin(), programs_, it->second);
+    return programs_.front().second.get();
+  }
+  if (capacity_ == 0) return primary_;
+  if (programs_.size() >= capacity_) {
+    VLOG(4) << "evict the program of the least recently used shape";
+    index_.erase(programs_.back().first);
+    programs_.pop_back();
+  }
+  programs_.emplace_front(key, create_());
+  index_[key] = programs_.begin();
+  num_created_++;
+  return programs_.front().second.get();
+}
+
+void RuntimeProgramCache::Run() {
+  auto key = InputSignature();
+  if (!primary_key_set_) {
+    primary_key_ = key;
+    primary_key_set_ = true;
+  }
+  auto* program = key == primary_key_ ? primary_ : Lookup(key);
+  if (program == primary_) {
+    primary_->Run();
+    return;
+  }
+
+  auto* feed_list = GetTensorList(program->exec_scope(), "feed");
+  feed_list->resize(feed_list_->size());
+  for (size_t i = 0; i < feed_list_->size(); i++) {
+    (*feed_list)[i].ShareDataWith((*feed_list_)[i]);
+  }
+  program->Run();
+  auto* fetch_list = GetTensorList(program->exec_scope(), "fetch");
+  fetch_list_->resize(fetch_list->size());
+  for (size_t i = 0; i < fetch_list->size(); i++) {
+    auto& dst = (*fetch_list_)[i];
+#ifndef LITE_WITH_FPGA
+    // The output bound to an external memory is copied into it.
+    if (!dst.buffer()->own_data()) {
+      dst.CopyDataFrom((*fetch_list)[i]);
+      continue;
+    }
+#endif  // LITE_WITH_FPGA
+    dst.ShareDataWith((*fetch_list)[i]);
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,82 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "lite/core/program.h"
+
+namespace paddle {
+namespace lite {
+
+/*
+ * RuntimeProgramCache keeps a RuntimeProgram for each of the recent input
+ * shapes, so that a model fed with a few distinct resolutions runs every one
+ * of them with the kernels prepared and the memory planned for it, instead of
+ * re-planning whenever the shape changes.
+ *
+ * The primary program holds the feeds and fetches used by the predictor, and
+ * runs the shapes of its first run. The programs of the other shapes are
+ * created by `create` on the first miss, they share the weights in the root
+ * scope, and the feeds and fetches are shared with the primary program without
+ * copying. At most `capacity` of them are kept, the least recently used one is
+ * destroyed first.
+ *
+ * The shape signature is the dims of the feeds and the number of their LoD
+ * levels, the LoD offsets are not in it, for they change with the data.
+ */
+class RuntimeProgramCache {
+ public:
+  using creator_t = std::function<std::unique_ptr<RuntimeProgram>()>;
+
+  RuntimeProgramCache(RuntimeProgram* primary,
+                      const creator_t& create,
+                      size_t capacity);
+
+  // Run the program of the current feed shapes of the primary program.
+  void Run();
+
+  // The programs kept besides the primary one.
+  size_t size() const { return programs_.size(); }
+  size_t capacity() const { return capacity_; }
+  // The number of the programs created.
+  int64_t num_created() const { return num_created_; }
+
+ private:
+  using key_t = std::vector<int64_t>;
+  using entry_t = std::pair<key_t, std::unique_ptr<RuntimeProgram>>;
+
+  key_t InputSignature() const;
+  RuntimeProgram* Lookup(const key_t& key);
+
+  RuntimeProgram* primary_{};
+  std::vector<Tensor>* feed_list_{};
+  std::vector<Tensor>* fetch_list_{};
+  creator_t create_;
+  size_t capacity_{};
+
+  bool primary_key_set_{false};
+  key_t primary_key_;
+  // The most recently used first.
+  std::list<entry_t> programs_;
+  std::map<key_t, std::list<entry_t>::iterator> index_;
+  int64_t num_created_{0};
+};
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,195 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/program.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/program_cache.h"
+
+namespace paddle {
+namespace lite {
+
+struct FakeReshapeParam {
+  const Tensor* x{};
+  const Tensor* shape{};
+  Tensor* out{};
+};
+
+// Reshape X to the dims in the data of Shape.
+class FakeReshapeOp : public OpLite {
+ public:
+  FakeReshapeOp() : OpLite("fake_reshape") {}
+  explicit FakeReshapeOp(const std::string& type) : OpLite(type) {}
+
+  bool CheckShape() const override { return true; }
+  bool InferShape() const override {
+    auto* shape = param_.shape->data<int>();
+    param_.out->Resize(
+        std::vector<int64_t>(shape, shape + param_.shape->numel()));
+    return true;
+  }
+  bool AttachImpl(const cpp::OpDesc& opdesc, lite::Scope* scope) override {
+    param_.x = scope->FindVar(opdesc.Input("X").front())->GetMutable<Tensor>();
+    param_.shape =
+        scope->FindVar(opdesc.Input("Shape").front())->GetMutable<Tensor>();
+    param_.out =
+        scope->FindVar(opdesc.Output("Out").front())->GetMutable<Tensor>();
+    return true;
+  }
+  void AttachKernel(KernelBase* kernel) override { kernel->SetParam(param_); }
+  std::string DebugString() const override { return "fake_reshape"; }
+
+ private:
+  mutable FakeReshapeParam param_;
+};
+
+class FakeReshapeCompute
+    : public KernelLite<TARGET(kHost), PRECISION(kFloat)> {
+ public:
+  void Run() override {
+    auto& param = Param<FakeReshapeParam>();
+    param.out->mutable_data<float>();
+  }
+};
+
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fake_reshape, paddle::lite::FakeReshapeOp);
+REGISTER_LITE_KERNEL(fake_reshape,
+                     kHost,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::FakeReshapeCompute,
+                     def)
+    .Finalize();
+
+namespace paddle {
+namespace lite {
+
+TEST(RuntimeProgram, infer_shape_from_data) {
+  Scope scope;
+  auto* x = scope.Var("x")->GetMutable<Tensor>();
+  x->Resize({2, 3});
+  x->mutable_data<float>();
+  auto* shape = scope.Var("shape")->GetMutable<Tensor>();
+  shape->Resize({2});
+  auto* shape_data = shape->mutable_data<int>();
+  shape_data[0] = 2;
+  shape_data[1] = 3;
+  auto* out = scope.Var("out")->GetMutable<Tensor>();
+
+  cpp::OpDesc desc;
+  desc.SetType("fake_reshape");
+  desc.SetInput("X", {"x"});
+  desc.SetInput("Shape", {"shape"});
+  desc.SetOutput("Out", {"out"});
+  std::shared_ptr<OpLite> op(new FakeReshapeOp);
+  op->Attach(desc, &scope);
+  std::unique_ptr<KernelBase> kernel(new FakeReshapeCompute);
+  op->AttachKernel(kernel.get());
+  std::vector<Instruction> insts;
+  insts.emplace_back(op, std::move(kernel));
+  RuntimeProgram program(std::move(insts));
+  program.set_exec_scope(&scope);
+  program.set_memory_plan_enabled(false);
+  // The input shapes are fixed, but the output shape is read from the data.
+  program.set_static_shape(true);
+
+  program.Run();
+  ASSERT_TRUE(program.instructions().front().shape_dynamic());
+  ASSERT_EQ(out->dims(), DDim(std::vector<int64_t>({2, 3})));
+  shape_data[0] = 3;
+  shape_data[1] = 2;
+  program.Run();
+  ASSERT_EQ(out->dims(), DDim(std::vector<int64_t>({3, 2})));
+}
+
+// The exec scope created for a program is deleted with the program.
+TEST(RuntimeProgram, exec_scope) {
+  cpp::ProgramDesc desc;
+  auto* block = desc.AddBlock<cpp::BlockDesc>();
+  for (auto& name : {"x", "shape", "out"}) {
+    auto* var = block->AddVar<cpp::VarDesc>();
+    var->SetName(name);
+  }
+  auto* op = block->AddOp<cpp::OpDesc>();
+  op->SetType("fake_reshape");
+  op->SetInput("X", {"x"});
+  op->SetInput("Shape", {"shape"});
+  op->SetOutput("Out", {"out"});
+  op->SetAttr<std::string>(
+      kKernelTypeAttr,
+      KernelBase::SerializeKernelType(
+          "fake_reshape", "def", Place{TARGET(kHost), PRECISION(kFloat)}));
+
+  std::shared_ptr<Scope> scope(new Scope);
+  {
+    RuntimeProgram program0(desc, scope);
+    RuntimeProgram program1(desc, scope);
+    ASSERT_EQ(scope->kids().size(), 2UL);
+    ASSERT_NE(program0.exec_scope(), program1.exec_scope());
+  }
+  ASSERT_TRUE(scope->kids().empty());
+}
+
+// The exec scopes of the programs evicted from the cache are deleted.
+TEST(RuntimeProgramCache, evict) {
+  cpp::ProgramDesc desc;
+  auto* block = desc.AddBlock<cpp::BlockDesc>();
+  for (auto& name : {"x", "shape", "out"}) {
+    auto* var = block->AddVar<cpp::VarDesc>();
+    var->SetName(name);
+    var->SetPersistable(std::string(name) == "shape");
+  }
+  auto* op = block->AddOp<cpp::OpDesc>();
+  op->SetType("fake_reshape");
+  op->SetInput("X", {"x"});
+  op->SetInput("Shape", {"shape"});
+  op->SetOutput("Out", {"out"});
+  op->SetAttr<std::string>(
+      kKernelTypeAttr,
+      KernelBase::SerializeKernelType(
+          "fake_reshape", "def", Place{TARGET(kHost), PRECISION(kFloat)}));
+
+  std::shared_ptr<Scope> scope(new Scope);
+  auto* shape = scope->Var("shape")->GetMutable<Tensor>();
+  shape->Resize({1});
+  shape->mutable_data<int>()[0] = 4;
+  RuntimeProgram primary(desc, scope);
+  RuntimeProgramCache cache(&primary,
+                            [&] {
+                              return std::unique_ptr<RuntimeProgram>(
+                                  new RuntimeProgram(desc, scope));
+                            },
+                            1);
+  auto* feed_list = primary.exec_scope()
+                        ->FindVar("feed")
+                        ->GetMutable<std::vector<Tensor>>();
+  feed_list->resize(1);
+  for (int64_t batch : {1, 2, 3, 4, 1}) {
+    (*feed_list)[0].Resize({batch, 4});
+    (*feed_list)[0].mutable_data<float>();
+    cache.Run();
+    // The primary program and the one cached.
+    ASSERT_LE(scope->kids().size(), 2UL);
+  }
+  ASSERT_EQ(cache.num_created(), 3);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/core/scope.h"
+#include <algorithm>
 
 namespace paddle {
 namespace lite {
@@ -26,11 +27,20 @@ Scope::~Scope() {
 }
 
 Scope &Scope::NewScope() const {
+  std::lock_guard<std::mutex> lock(kids_mutex_);
   kids_.push_back(new Scope);
   kids_.back()->parent_ = this;
   return *kids_.back();
 }
 
+void Scope::DeleteScope(Scope *scope) const {
+  std::lock_guard<std::mutex> lock(kids_mutex_);
+  auto it = std::find(kids_.begin(), kids_.end(), scope);
+  CHECK(it != kids_.end()) << "not a kid scope";
+  kids_.erase(it);
+  delete scope;
+}
+
 Variable *Scope::Var(const std::string &name) {
   auto *var = FindVar(name);
   if (var) return var;
@@ -60,6 +70,18 @@ Variable *Scope::FindLocalVar(const std::string &name) const {
   return nullptr;
 }
 
+PackedWeights *Scope::FindPackedWeights(const std::string &name) const {
+  const Scope *root = this;
+  while (root->parent()) {
+    root = root->parent();
+  }
+  auto *var = root->FindLocalVar(name);
+  if (!var || !var->IsType<Tensor>() || !var->Get<Tensor>().persistable()) {
+    return nullptr;
+  }
+  return &root->packed_weights_;
+}
+
 std::vector<std::string> Scope::LocalVarNames() const {
   std::vector<std::string> keys;
   for (const auto &item : vars_) {
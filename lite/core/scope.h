@@ -15,10 +15,12 @@
 #pragma once
 #include <list>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
+#include "lite/core/packed_weights.h"
 #include "lite/core/variable.h"
 
 namespace paddle {
@@ -36,6 +38,10 @@ class Scope final {
   ~Scope();
 
   Scope& NewScope() const;
+  // Delete a kid scope created by `NewScope`, with its variables.
+  void DeleteScope(Scope* scope) const;
+
+  const std::list<Scope*>& kids() const { return kids_; }
 
   Variable* Var(const std::string& name);
 
@@ -48,6 +54,11 @@ class Scope final {
   // Following the legacy scope interface.
   std::vector<std::string> LocalVarNames() const;
 
+  // The cache of the packed weights of the root scope if `name` is a
+  // persistable tensor of it, null otherwise, for the temporary variables
+  // change between the runs.
+  PackedWeights* FindPackedWeights(const std::string& name) const;
+
   /// ------------------------------------- helper functions for Tensor
   /// ----------------------------------
   // Create a Tensor variable. This will create a new Variable called `name`.
@@ -71,8 +82,12 @@ class Scope final {
  private:
   // Scope in `kids_` are owned by this class.
   mutable std::list<Scope*> kids_;
+  // The kids are created and deleted by the predictors sharing this scope.
+  mutable std::mutex kids_mutex_;
   const Scope* parent_{nullptr};
   std::unordered_map<std::string, std::unique_ptr<Variable>> vars_;
+  // The weights packed by the kernels of the programs sharing this scope.
+  mutable PackedWeights packed_weights_;
 };
 
 }  // namespace lite
@@ -33,5 +33,62 @@ TEST(Scope, FindVar) {
   ASSERT_TRUE(scope.FindVar("x"));
 }
 
+TEST(Scope, DeleteScope) {
+  Scope scope;
+  scope.Var("x");
+  auto& kid0 = scope.NewScope();
+  auto& kid1 = scope.NewScope();
+  kid1.Var("y");
+  ASSERT_TRUE(kid1.FindVar("x"));
+  ASSERT_EQ(scope.kids().size(), 2UL);
+  scope.DeleteScope(&kid1);
+  ASSERT_EQ(scope.kids().size(), 1UL);
+  ASSERT_EQ(scope.kids().front(), &kid0);
+}
+
+// The persistable tensors of the root scope share the packed weights.
+TEST(Scope, FindPackedWeights) {
+  Scope scope;
+  scope.Var("w")->GetMutable<Tensor>()->set_persistable(true);
+  scope.Var("x")->GetMutable<Tensor>();
+  auto& kid0 = scope.NewScope();
+  auto& kid1 = scope.NewScope();
+  kid1.Var("y")->GetMutable<Tensor>()->set_persistable(true);
+  auto* cache = scope.FindPackedWeights("w");
+  ASSERT_TRUE(cache);
+  ASSERT_EQ(kid0.FindPackedWeights("w"), cache);
+  ASSERT_EQ(kid1.FindPackedWeights("w"), cache);
+  ASSERT_FALSE(kid0.FindPackedWeights("x"));
+  ASSERT_FALSE(kid1.FindPackedWeights("y"));
+  ASSERT_FALSE(kid1.FindPackedWeights("z"));
+}
+
+TEST(PackedWeights, Get) {
+  PackedWeights cache;
+  int num_packed = 0;
+  auto pack = [&](Tensor* packed) {
+    packed->Resize({1});
+    packed->mutable_data<float>()[0] = 1.f;
+    num_packed++;
+  };
+  auto w0 = cache.Get("w", "trans", pack);
+  auto w1 = PackWeight(&cache, "w", "trans", pack);
+  ASSERT_EQ(w0, w1);
+  ASSERT_EQ(num_packed, 1);
+  auto w2 = cache.Get("w", "winograd", pack);
+  ASSERT_NE(w0, w2);
+  ASSERT_EQ(num_packed, 2);
+  ASSERT_EQ(cache.size(), 2UL);
+  // The packed weights are released with the last user.
+  w0.reset();
+  w1.reset();
+  ASSERT_EQ(cache.size(), 1UL);
+  cache.Get("w", "trans", pack);
+  ASSERT_EQ(num_packed, 3);
+  // Without a cache, the weight is packed for each call.
+  ASSERT_NE(PackWeight(nullptr, "w", "winograd", pack), w2);
+  ASSERT_EQ(num_packed, 4);
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -23,6 +23,8 @@ namespace lite {
 
 using value_type = int64_t;
 
+constexpr size_t DDimLite::kMaxRank;
+
 value_type DDimLite::production() const {
   value_type res = 1;
   for (size_t i = 0; i < this->size(); i++) {
@@ -49,11 +51,9 @@ value_type DDimLite::count(int start, int end) const {
 }
 
 DDimLite DDimLite::Slice(int start, int end) const {
-  std::vector<value_type> vec;
-  for (int i = start; i < end; i++) {
-    vec.push_back((*this)[i]);
-  }
-  return DDimLite(vec);
+  DDimLite res;
+  if (end > start) res.ConstructFrom(data_ + start, end - start);
+  return res;
 }
 
 std::string DDimLite::repr() const {
@@ -79,6 +79,16 @@ void TensorLite::ShareDataWith(const TensorLite &other) {
   memory_size_ = other.memory_size_;
 }
 
+void TensorLite::ResetBuffer(std::shared_ptr<Buffer> buffer,
+                             size_t memory_size) {
+  CHECK(buffer);
+  CHECK_LE(memory_size, buffer->space());
+  buffer_ = buffer;
+  target_ = buffer->target();
+  memory_size_ = memory_size;
+  offset_ = 0;
+}
+
 void *TensorLite::mutable_data(size_t memory_size) {
   memory_size_ = memory_size;
   buffer_->ResetLazy(target_, memory_size_);
@@ -90,6 +100,14 @@ void *TensorLite::mutable_data(TargetType target, size_t memory_size) {
   return mutable_data(memory_size);
 }
 
+void TensorLite::ShareExternalMemory(void *data,
+                                     size_t memory_size,
+                                     TargetType target) {
+  CHECK(data);
+  ResetBuffer(std::make_shared<Buffer>(data, target, memory_size),
+              memory_size);
+}
+
 void TensorLite::CopyDataFrom(const TensorLite &other) {
   dims_ = other.dims_;
   target_ = other.target_;
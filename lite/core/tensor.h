@@ -41,6 +41,9 @@ using Tensor = lite::TensorLite;
 class DDimLite {
  public:
   using value_type = int64_t;
+  // The dims are stored inline without heap allocation, the max rank is the
+  // same as the one supported by Paddle.
+  static constexpr size_t kMaxRank = 9;
 
   DDimLite() = default;
 
@@ -48,25 +51,37 @@ class DDimLite {
   // DDimLite(std::initializer_list<value_type> init_list) :
   // DDimLite(std::vector<value_type>(init_list)) {}
 
-  void ConstructFrom(const std::vector<value_type> &x) { data_ = x; }
+  void ConstructFrom(const std::vector<value_type> &x) {
+    ConstructFrom(x.data(), x.size());
+  }
+  void ConstructFrom(const value_type *x, size_t size) {
+    CHECK_LE(size, kMaxRank) << "the rank of dims exceeds " << kMaxRank;
+    std::copy(x, x + size, data_);
+    size_ = size;
+  }
 
   value_type operator[](int offset) const { return data_[offset]; }
   value_type &operator[](int offset) { return data_[offset]; }
-  std::vector<int64_t> Vectorize() const { return data_; }
+  std::vector<int64_t> Vectorize() const {
+    return std::vector<int64_t>(data_, data_ + size_);
+  }
 
-  size_t size() const { return data_.size(); }
-  bool empty() const { return data_.empty(); }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
 
   value_type production() const;
 
-  const std::vector<value_type> &data() const { return data_; }
+  // Return a copy of the dims, use `operator[]` in the hot paths.
+  std::vector<value_type> data() const { return Vectorize(); }
   value_type count(int start, int end) const;
 
   DDimLite Slice(int start, int end) const;
 
   DDimLite Flatten2D(int col) const {
-    return DDimLite(std::vector<value_type>(
-        {Slice(0, col).production(), Slice(col, size()).production()}));
+    value_type x[2] = {count(0, col), count(col, size())};
+    DDimLite res;
+    res.ConstructFrom(x, 2);
+    return res;
   }
 
   std::string repr() const;
@@ -89,7 +104,8 @@ class DDimLite {
   }
 
  private:
-  std::vector<value_type> data_;
+  value_type data_[kMaxRank]{};
+  size_t size_{0};
 };
 
 using LoD = std::vector<std::vector<uint64_t>>;
@@ -165,6 +181,14 @@ class TensorLite {
   // Other share data to this.
   void ShareDataWith(const TensorLite &other);
 
+  // Replace the buffer of this tensor, the data is not kept.
+  void ResetBuffer(std::shared_ptr<Buffer> buffer, size_t memory_size);
+  // Use the memory of the caller as the buffer without owning it, it should
+  // stay valid while this tensor uses it. Once the tensor outgrows it, a new
+  // memory owned by the tensor will be allocated.
+  void ShareExternalMemory(void *data, size_t memory_size, TargetType target);
+  const std::shared_ptr<Buffer> &buffer() const { return buffer_; }
+
   void CopyDataFrom(const TensorLite &other);
 
   TargetType target() const { return target_; }
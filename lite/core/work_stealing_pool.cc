@@ -0,0 +1,234 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/work_stealing_pool.h"
+#ifdef LITE_WITH_LINUX
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // LITE_WITH_LINUX
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <map>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include "lite/utils/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+
+namespace {
+
+// Bind the current thread to the core `cpu_id`.
+void BindCurrentThread(int cpu_id) {
+#ifdef LITE_WITH_LINUX
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(cpu_id, &mask);
+  if (syscall(__NR_sched_setaffinity, 0, sizeof(mask), &mask)) {
+    LOG(WARNING) << "failed to bind the pool thread to core " << cpu_id;
+  }
+#endif  // LITE_WITH_LINUX
+}
+
+thread_local std::shared_ptr<WorkStealingPool> current_pool;
+
+}  // namespace
+
+constexpr int WorkStealingPool::kDefaultSpinUs;
+
+WorkStealingPool::WorkStealingPool(int num_threads,
+                                   const std::vector<int>& cpu_ids,
+                                   const std::vector<int>& cluster_ids,
+                                   int spin_us)
+    : num_threads_(num_threads),
+      spin_us_(spin_us),
+      cpu_ids_(cpu_ids),
+      slices_(NewSlices(num_threads)) {
+  CHECK_GT(num_threads, 0);
+  CHECK(cpu_ids.empty() || static_cast<int>(cpu_ids.size()) >= num_threads)
+      << "no core to bind for each thread";
+  CHECK(cluster_ids.empty() ||
+        static_cast<int>(cluster_ids.size()) >= num_threads)
+      << "no cluster for each thread";
+  // Visit the own slice, the slices of the same cluster, and the others, each
+  // starting from the next thread to spread the thieves.
+  steal_orders_.resize(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    auto& order = steal_orders_[i];
+    order.push_back(i);
+    for (int same_cluster = 1; same_cluster >= 0; --same_cluster) {
+      for (int k = 1; k < num_threads; ++k) {
+        int j = (i + k) % num_threads;
+        bool same = cluster_ids.empty() || cluster_ids[j] == cluster_ids[i];
+        if (same == static_cast<bool>(same_cluster)) order.push_back(j);
+      }
+    }
+  }
+  for (int i = 1; i < num_threads; ++i) {
+    threads_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+WorkStealingPool::Slice* WorkStealingPool::NewSlices(int num_slices) {
+  static_assert(sizeof(Slice) == 64, "a slice should fill a cache line");
+  static_assert(std::is_trivially_destructible<Slice>::value,
+                "the slices are freed without the destructors");
+  void* mem = nullptr;
+  CHECK_EQ(posix_memalign(&mem, sizeof(Slice), num_slices * sizeof(Slice)), 0)
+      << "failed to allocate the slices";
+  auto* slices = static_cast<Slice*>(mem);
+  for (int i = 0; i < num_slices; ++i) {
+    new (slices + i) Slice;
+  }
+  return slices;
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  start_cv_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkStealingPool::ParallelFor(int64_t n,
+                                   const range_fn_t& fn,
+                                   int64_t grain,
+                                   int max_threads) {
+  if (n <= 0) return;
+  int active_threads = num_threads_;
+  if (max_threads > 0) {
+    active_threads = std::min(active_threads, max_threads);
+  }
+  bool idle = false;
+  if (active_threads == 1 || n == 1 ||
+      !busy_.compare_exchange_strong(idle, true)) {
+    fn(0, n, 0);
+    return;
+  }
+  if (grain <= 0) {
+    int64_t num_chunks = 4 * static_cast<int64_t>(active_threads);
+    grain = std::max<int64_t>(1, (n + num_chunks - 1) / num_chunks);
+  }
+  for (int i = 0; i < num_threads_; ++i) {
+    int64_t begin = i < active_threads ? n * i / active_threads : n;
+    int64_t end = i < active_threads ? n * (i + 1) / active_threads : n;
+    slices_[i].next.store(begin, std::memory_order_relaxed);
+    slices_[i].end = end;
+  }
+  active_threads_ = active_threads;
+  fn_ = &fn;
+  grain_ = grain;
+  pending_workers_ = num_threads_ - 1;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    epoch_++;
+  }
+  start_cv_.notify_all();
+
+  RunSlices(0);
+  WaitFor(&done_cv_, [this] { return pending_workers_ == 0; });
+  fn_ = nullptr;
+  busy_ = false;
+}
+
+void WorkStealingPool::RunSlices(int thread_id) {
+  if (thread_id >= active_threads_) return;
+  for (int i : steal_orders_[thread_id]) {
+    auto& slice = slices_[i];
+    while (true) {
+      int64_t begin = slice.next.fetch_add(grain_);
+      if (begin >= slice.end) break;
+      (*fn_)(begin, std::min(begin + grain_, slice.end), thread_id);
+    }
+  }
+}
+
+void WorkStealingPool::WorkerLoop(int thread_id) {
+  if (!cpu_ids_.empty()) {
+    BindCurrentThread(cpu_ids_[thread_id]);
+  }
+  uint64_t seen = 0;
+  while (true) {
+    WaitFor(&start_cv_, [&] { return stopped_ || epoch_ != seen; });
+    if (stopped_) return;
+    seen = epoch_;
+    RunSlices(thread_id);
+    if (pending_workers_.fetch_sub(1) == 1) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_cv_.notify_one();
+    }
+  }
+}
+
+void WorkStealingPool::WaitFor(std::condition_variable* cv,
+                               const std::function<bool()>& ready) {
+  if (ready()) return;
+  int spin_us = spin_us_;
+  if (spin_us > 0) {
+    auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::microseconds(spin_us);
+    // Check the clock once in a while, it is slower than the flags.
+    for (int i = 1;; ++i) {
+      if (ready()) return;
+      if (i % 64 == 0 && std::chrono::steady_clock::now() > deadline) break;
+    }
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv->wait(lock, ready);
+}
+
+std::shared_ptr<WorkStealingPool> WorkStealingPool::Shared(
+    int num_threads,
+    const std::vector<int>& cpu_ids,
+    const std::vector<int>& cluster_ids) {
+  using key_t = std::tuple<int, std::vector<int>, std::vector<int>>;
+  static std::mutex mutex;
+  static std::map<key_t, std::weak_ptr<WorkStealingPool>> pools;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& pool = pools[key_t(num_threads, cpu_ids, cluster_ids)];
+  auto res = pool.lock();
+  if (!res) {
+    res = std::make_shared<WorkStealingPool>(num_threads, cpu_ids, cluster_ids);
+    pool = res;
+  }
+  return res;
+}
+
+void WorkStealingPool::SetCurrent(
+    const std::shared_ptr<WorkStealingPool>& pool) {
+  current_pool = pool;
+}
+
+WorkStealingPool* WorkStealingPool::Current() { return current_pool.get(); }
+
+void ParallelFor(int64_t n,
+                 const WorkStealingPool::range_fn_t& fn,
+                 int64_t grain,
+                 int max_threads) {
+  auto* pool = WorkStealingPool::Current();
+  if (pool) {
+    pool->ParallelFor(n, fn, grain, max_threads);
+  } else if (n > 0) {
+    fn(0, n, 0);
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,144 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+/*
+ * WorkStealingPool runs the data parallel loops of the CPU kernels, in place
+ * of the OpenMP parallel for.
+ *
+ * The thread calling ParallelFor runs as thread 0, together with the
+ * `num_threads - 1` workers of the pool. The range is split into a contiguous
+ * slice for each thread, every thread takes the chunks of its own slice
+ * first, then steals the chunks left in the slices of the threads on the same
+ * cluster, and the other threads at last.
+ *
+ * The idle workers spin for `spin_us` microseconds before they sleep, so that
+ * the loops of the consecutive kernels start without waking the threads up,
+ * while the cores are yielded to the other threads of the application when
+ * the predictor is idle.
+ *
+ * A pool runs one loop at a time. A loop started while the pool is running
+ * the loop of another caller, or started inside a loop, runs in the caller
+ * thread as thread 0, like a nested OpenMP parallel region.
+ */
+class WorkStealingPool {
+ public:
+  // `fn(begin, end, thread_id)` runs the indices in [begin, end).
+  using range_fn_t = std::function<void(int64_t, int64_t, int)>;
+
+  static constexpr int kDefaultSpinUs = 100;
+
+  // Worker i is bound to `cpu_ids[i]` if `cpu_ids` is not empty, the caller
+  // should be bound to `cpu_ids[0]`. `cluster_ids[i]` is the cluster of
+  // thread i, the stealing prefers the threads of the same cluster.
+  explicit WorkStealingPool(int num_threads,
+                            const std::vector<int>& cpu_ids = {},
+                            const std::vector<int>& cluster_ids = {},
+                            int spin_us = kDefaultSpinUs);
+  ~WorkStealingPool();
+
+  // Run `fn` over [0, n) in the chunks of `grain` indices and wait for them
+  // all. A non-positive `grain` splits each slice into a few chunks. The loop
+  // runs on the first `max_threads` threads only if it is positive.
+  void ParallelFor(int64_t n,
+                   const range_fn_t& fn,
+                   int64_t grain = 0,
+                   int max_threads = 0);
+
+  int num_threads() const { return num_threads_; }
+  void set_spin_us(int spin_us) { spin_us_ = spin_us; }
+  int spin_us() const { return spin_us_; }
+
+  // The pool of the threads on `cpu_ids`, shared by the callers asking for
+  // the same threads and cores, such as the predictors of the same run mode.
+  static std::shared_ptr<WorkStealingPool> Shared(
+      int num_threads,
+      const std::vector<int>& cpu_ids = {},
+      const std::vector<int>& cluster_ids = {});
+
+  // The pool used by lite::ParallelFor in the current thread, nullptr to run
+  // the loops in the current thread.
+  static void SetCurrent(const std::shared_ptr<WorkStealingPool>& pool);
+  static WorkStealingPool* Current();
+
+ private:
+  WorkStealingPool(const WorkStealingPool&) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+  // The indices in [next, end) are left, padded to a cache line to avoid the
+  // false sharing. The slices are allocated aligned to the cache lines.
+  struct Slice {
+    std::atomic<int64_t> next{0};
+    int64_t end{0};
+    char padding[64 - 2 * sizeof(int64_t)];
+  };
+  struct SliceDeleter {
+    void operator()(Slice* slices) const { free(slices); }
+  };
+  static Slice* NewSlices(int num_slices);
+
+  void WorkerLoop(int thread_id);
+  // Run the chunks of the own slice and steal the others.
+  void RunSlices(int thread_id);
+  // Spin and then sleep on `cv` until `ready` returns true.
+  void WaitFor(std::condition_variable* cv, const std::function<bool()>& ready);
+
+  int num_threads_{};
+  std::atomic<int> spin_us_{kDefaultSpinUs};
+  std::vector<int> cpu_ids_;
+  // The order of the slices visited by each thread.
+  std::vector<std::vector<int>> steal_orders_;
+  std::unique_ptr<Slice[], SliceDeleter> slices_;
+
+  // The loop being run.
+  const range_fn_t* fn_{};
+  int64_t grain_{1};
+  // The threads running the loop, the others skip it.
+  int active_threads_{};
+  std::atomic<uint64_t> epoch_{0};
+  std::atomic<int> pending_workers_{0};
+  // Set by the caller during a loop.
+  std::atomic<bool> busy_{false};
+
+  std::mutex mutex_;
+  // Notified when a loop starts and when the pool stops.
+  std::condition_variable start_cv_;
+  // Notified when the workers are done with a loop.
+  std::condition_variable done_cv_;
+  std::atomic<bool> stopped_{false};
+  std::vector<std::thread> threads_;
+};
+
+// Run `fn(begin, end, thread_id)` over [0, n) by the pool of the current
+// thread, on at most `max_threads` threads if it is positive.
+void ParallelFor(int64_t n,
+                 const WorkStealingPool::range_fn_t& fn,
+                 int64_t grain = 0,
+                 int max_threads = 0);
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,135 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/work_stealing_pool.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+
+TEST(WorkStealingPool, parallel_for) {
+  WorkStealingPool pool(4);
+  for (int64_t n : {1, 3, 4, 17, 1000}) {
+    for (int64_t grain : {0, 1, 7}) {
+      std::vector<std::atomic<int>> visits(n);
+      for (auto& v : visits) v = 0;
+      pool.ParallelFor(n,
+                       [&](int64_t begin, int64_t end, int thread_id) {
+                         ASSERT_LT(begin, end);
+                         ASSERT_GE(thread_id, 0);
+                         ASSERT_LT(thread_id, pool.num_threads());
+                         for (int64_t i = begin; i < end; ++i) visits[i]++;
+                       },
+                       grain);
+      for (auto& v : visits) {
+        EXPECT_EQ(v, 1);
+      }
+    }
+  }
+}
+
+TEST(WorkStealingPool, steal) {
+  // The slice of thread 0 is slow, the others steal the chunks of it.
+  WorkStealingPool pool(4, {}, {0, 0, 1, 1}, 0);
+  const int64_t n = 64;
+  std::vector<int> owners(n, -1);
+  pool.ParallelFor(n,
+                   [&](int64_t begin, int64_t end, int thread_id) {
+                     if (thread_id == 0) {
+                       std::this_thread::sleep_for(
+                           std::chrono::milliseconds(10));
+                     }
+                     for (int64_t i = begin; i < end; ++i) {
+                       owners[i] = thread_id;
+                     }
+                   },
+                   1);
+  EXPECT_LT(std::count(owners.begin(), owners.begin() + n / 4, 0), n / 4);
+  for (int owner : owners) {
+    EXPECT_GE(owner, 0);
+  }
+}
+
+TEST(WorkStealingPool, max_threads) {
+  WorkStealingPool pool(4);
+  for (int max_threads : {1, 2, 8}) {
+    const int64_t n = 100;
+    std::vector<std::atomic<int>> visits(n);
+    for (auto& v : visits) v = 0;
+    pool.ParallelFor(n,
+                     [&](int64_t begin, int64_t end, int thread_id) {
+                       ASSERT_LT(thread_id, max_threads);
+                       for (int64_t i = begin; i < end; ++i) visits[i]++;
+                     },
+                     1,
+                     max_threads);
+    for (auto& v : visits) {
+      EXPECT_EQ(v, 1);
+    }
+  }
+}
+
+TEST(WorkStealingPool, nested_and_concurrent) {
+  auto pool = WorkStealingPool::Shared(3);
+  EXPECT_EQ(pool, WorkStealingPool::Shared(3));
+  std::atomic<int64_t> sum{0};
+  auto run = [&] {
+    pool->ParallelFor(10, [&](int64_t begin, int64_t end, int) {
+      for (int64_t i = begin; i < end; ++i) {
+        // The inner loops run in the thread of the outer iteration.
+        pool->ParallelFor(10, [&](int64_t b, int64_t e, int thread_id) {
+          EXPECT_EQ(thread_id, 0);
+          sum += e - b;
+        });
+      }
+    });
+  };
+  std::vector<std::thread> callers;
+  for (int i = 0; i < 4; ++i) {
+    callers.emplace_back(run);
+  }
+  for (auto& caller : callers) {
+    caller.join();
+  }
+  EXPECT_EQ(sum, 4 * 10 * 10);
+}
+
+TEST(WorkStealingPool, parallel_macros) {
+  WorkStealingPool::SetCurrent(std::make_shared<WorkStealingPool>(2));
+  std::vector<int> data(100, 0);
+  LITE_PARALLEL_BEGIN(i, tid, 100) { data[i] += i; }
+  LITE_PARALLEL_END();
+  LITE_PARALLEL_COMMON_BEGIN(i, tid, 100, 1, 3) { data[i] += 1000; }
+  LITE_PARALLEL_END();
+  LITE_PARALLEL_COMMON_BEGIN_THREADS(i, tid, 100, 0, 2, 1) {
+    EXPECT_EQ(tid, 0);
+    data[i] += 10000;
+  }
+  LITE_PARALLEL_END();
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(data[i],
+              i + (i % 3 == 1 ? 1000 : 0) + (i % 2 == 0 ? 10000 : 0));
+  }
+  WorkStealingPool::SetCurrent(nullptr);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -28,6 +28,8 @@ class ReluCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
 
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~ReluCompute() = default;
 };
 
@@ -37,6 +39,8 @@ class LeakyReluCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
 
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~LeakyReluCompute() = default;
 };
 
@@ -46,6 +50,8 @@ class ReluClippedCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
 
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~ReluClippedCompute() = default;
 };
 
@@ -55,6 +61,8 @@ class PReluCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
 
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~PReluCompute() = default;
 };
 
@@ -64,6 +72,8 @@ class SigmoidCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
 
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~SigmoidCompute() = default;
 };
 
@@ -73,6 +83,8 @@ class TanhCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
 
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~TanhCompute() = default;
 };
 
@@ -82,6 +94,8 @@ class SwishCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
 
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~SwishCompute() = default;
 };
 
@@ -91,6 +105,8 @@ class Relu6Compute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
 
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~Relu6Compute() = default;
 };
 
@@ -100,6 +116,8 @@ class LogCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
 
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~LogCompute() = default;
 };
 
@@ -109,6 +127,8 @@ class ExpCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
 
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~ExpCompute() = default;
 };
 
@@ -118,6 +138,8 @@ class FloorCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
 
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~FloorCompute() = default;
 };
 
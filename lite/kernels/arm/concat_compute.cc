@@ -34,12 +34,30 @@ std::vector<size_t> stride_numel(const DDim& ddim) {
   return strides;
 }
 
+// Whether the inputs are already in their place in the output, that is the
+// memory planner placed them as contiguous parts of the output.
+bool inputs_in_place(const std::vector<lite::Tensor*>& inputs,
+                     const lite::Tensor& out,
+                     int axis) {
+  if (axis < 0) axis += static_cast<int>(out.dims().size());
+  for (int i = 0; i < axis; ++i) {
+    if (out.dims()[i] != 1) return false;
+  }
+  const float* dst = out.data<float>();
+  for (auto* in : inputs) {
+    if (in->data<float>() != dst) return false;
+    dst += in->numel();
+  }
+  return true;
+}
+
 void ConcatCompute::Run() {
   auto& param = Param<operators::ConcatParam>();
   std::vector<lite::Tensor*> inputs = param.x;
   auto* out = param.output;
   int axis = param.axis;
   out->mutable_data<float>();
+  if (inputs_in_place(inputs, *out, axis)) return;
 
   /// Sometimes direct copies will be faster, this maybe need deeply analysis.
   if (axis == 0 && inputs.size() < 10) {
@@ -21,9 +21,11 @@ namespace lite {
 namespace kernels {
 namespace arm {
 
-void ConvCompute::PrepareForRun() {
+void ConvCompute::ReInitWhenNeeded() {
   auto& param = this->Param<param_t>();
   auto x_dims = param.x->dims();
+  if (last_shape_ == x_dims) return;
+  last_shape_ = x_dims;
   auto w_dims = param.filter->dims();
   auto o_dims = param.output->dims();
 
@@ -56,6 +58,10 @@ void ConvCompute::PrepareForRun() {
   bool flag_dw = flag_dw_3x3 || flag_dw_5x5;
 
   // select conv impl
+  if (impl_ != nullptr) {
+    delete impl_;
+    impl_ = nullptr;
+  }
   if (param.groups == ic && ic == oc && kps_equal && no_dilation && flag_dw) {
     // dw conv impl
     impl_ = new lite::arm::math::DepthwiseConv<PRECISION(kFloat)>;
@@ -94,8 +100,22 @@ void ConvCompute::Run() {
 
 template <PrecisionType Ptype_out>
 void ConvComputeInt8<Ptype_out>::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  // Convert fp32 bias to int32 bias, the result is kept by the kernel and the
+  // bias shared by the cloned predictors is unchanged.
+  if (param.bias) {
+    lite::arm::math::trans_fp32_bias_to_int32_basic(
+        param.bias, &bias_int32_, param.input_scale, param.weight_scale);
+    param.bias = &bias_int32_;
+  }
+}
+
+template <PrecisionType Ptype_out>
+void ConvComputeInt8<Ptype_out>::ReInitWhenNeeded() {
   auto& param = this->Param<param_t>();
   auto x_dims = param.x->dims();
+  if (last_shape_ == x_dims) return;
+  last_shape_ = x_dims;
   auto w_dims = param.filter->dims();
   auto o_dims = param.output->dims();
 
@@ -115,13 +135,16 @@ void ConvComputeInt8<Ptype_out>::PrepareForRun() {
   int sh = param.strides[1];
   int sw = param.strides[0];
 
-  bool with_bias = param.bias;
   bool kps_equal = (pw == ph) && (sh == sw) && (kw == kh);
   bool no_dilation = (param.dilations[0] == 1) && (param.dilations[1] == 1);
   bool flag_dw_3x3 = (kw == 3) && (ph == 1) && (sw == 1 || sw == 2);
   bool flag_dw_5x5 = (kw == 5 && sw == 1 && ph == 2);
   bool flag_dw = flag_dw_3x3 || flag_dw_5x5;
 
+  if (impl_ != nullptr) {
+    delete impl_;
+    impl_ = nullptr;
+  }
   if (param.groups == ic && ic == oc && kps_equal && no_dilation && flag_dw) {
     impl_ = new lite::arm::math::DepthwiseConvInt8<Ptype_out>;
     VLOG(3) << "Run DepthwiseConv Int8";
@@ -133,14 +156,6 @@ void ConvComputeInt8<Ptype_out>::PrepareForRun() {
     VLOG(3) << "Run GemmLikeConvInt8";
     impl_ = new lite::arm::math::GemmLikeConvInt8<Ptype_out>;
   }
-  // Convert fp32 bias to int32 bias.
-  if (with_bias) {
-    Tensor temp_tensor;
-    temp_tensor.CopyDataFrom(*param.bias);
-    lite::arm::math::trans_fp32_bias_to_int32_basic(
-        &temp_tensor, param.bias, param.input_scale, param.weight_scale);
-  }
-  // param.bias->data<int32_t>();
   CHECK(this->impl_->create(param, &ctx));
 }
 
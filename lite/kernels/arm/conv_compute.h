@@ -26,7 +26,7 @@ class ConvCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
  public:
   using param_t = operators::ConvParam;
 
-  void PrepareForRun() override;
+  void ReInitWhenNeeded() override;
 
   void Run() override;
 
@@ -39,6 +39,8 @@ class ConvCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
  private:
   lite::arm::math::ImplBase<TARGET(kARM), PRECISION(kFloat), param_t>* impl_{
       nullptr};
+  // The input dims the impl_ is created for.
+  DDim last_shape_;
 };
 
 template <PrecisionType Ptype_out>
@@ -48,6 +50,8 @@ class ConvComputeInt8 : public KernelLite<TARGET(kARM), PRECISION(kInt8)> {
 
   void PrepareForRun() override;
 
+  void ReInitWhenNeeded() override;
+
   void Run() override;
 
   ~ConvComputeInt8() {
@@ -59,6 +63,9 @@ class ConvComputeInt8 : public KernelLite<TARGET(kARM), PRECISION(kInt8)> {
  private:
   lite::arm::math::ImplBase<TARGET(kARM), PRECISION(kInt8), param_t>* impl_{
       nullptr};
+  // The input dims the impl_ is created for.
+  DDim last_shape_;
+  Tensor bias_int32_;
 };
 
 }  // namespace arm
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/kernels/arm/conv_transpose_compute.h"
+#include <string>
 #include <vector>
 #include "lite/backends/arm/math/funcs.h"
 #include "lite/core/op_registry.h"
@@ -47,12 +48,16 @@ void Conv2DTransposeCompute::PrepareForRun() {
 
   ctx.ExtendWorkspace(group * m * n * sizeof(float));
 
-  lite::Tensor tmp_weights;
-  lite::arm::math::prepackA(
-      &tmp_weights, *(param.filter), 1., m, k, group, true, &ctx);
-  param.filter->Resize(tmp_weights.dims());
-  param.filter->CopyDataFrom(tmp_weights);
-  param.filter->Resize(w_dims);
+  // The filter shared by the cloned predictors is unchanged, the packed one
+  // is shared by them.
+  weights_trans_ = PackWeight(
+      param.packed_weights,
+      param.filter_name,
+      "conv_transpose_g" + std::to_string(group),
+      [&](Tensor* weights_trans) {
+        lite::arm::math::prepackA(
+            weights_trans, *(param.filter), 1., m, k, group, true, &ctx);
+      });
 }
 
 void Conv2DTransposeCompute::Run() {
@@ -91,7 +96,7 @@ void Conv2DTransposeCompute::Run() {
 
   auto din = param.x->data<float>();
   auto dout = param.output->mutable_data<float>();
-  auto weights = param.filter->data<float>();
+  auto weights = weights_trans_->data<float>();
   for (int i = 0; i < num; i++) {
     const float* din_batch = din + i * chin * hin * win;
     float* dout_batch = dout + i * chout * hout * wout;
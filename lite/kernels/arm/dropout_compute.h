@@ -26,6 +26,8 @@ class DropoutCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
  public:
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~DropoutCompute() = default;
 };
 
@@ -27,6 +27,8 @@ class ElementwiseAddCompute
  public:
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~ElementwiseAddCompute() = default;
 };
 
@@ -35,6 +37,8 @@ class ElementwiseAddActivationCompute
  public:
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~ElementwiseAddActivationCompute() = default;
 };
 
@@ -43,6 +47,8 @@ class ElementwiseMulCompute
  public:
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~ElementwiseMulCompute() = default;
 };
 
@@ -51,6 +57,8 @@ class ElementwiseMulActivationCompute
  public:
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~ElementwiseMulActivationCompute() = default;
 };
 
@@ -59,6 +67,8 @@ class ElementwiseMaxCompute
  public:
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~ElementwiseMaxCompute() = default;
 };
 
@@ -67,6 +77,8 @@ class ElementwiseMaxActivationCompute
  public:
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~ElementwiseMaxActivationCompute() = default;
 };
 
@@ -75,6 +87,8 @@ class ElementwiseDivCompute
  public:
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~ElementwiseDivCompute() = default;
 };
 
@@ -83,6 +97,8 @@ class ElementwiseDivActivationCompute
  public:
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~ElementwiseDivActivationCompute() = default;
 };
 
@@ -26,13 +26,13 @@ namespace lite {
 namespace kernels {
 namespace arm {
 
-void FcCompute::PrepareForRun() {
+void FcCompute::ReInitWhenNeeded() {
   auto& param = this->Param<operators::FcParam>();
   auto x_dims = param.input->dims();
+  if (last_shape_ == x_dims) return;
+  last_shape_ = x_dims;
   auto w_dims = param.w->dims();
 
-  auto& ctx = this->ctx_->template As<ARMContext>();
-
   CHECK_GE(x_dims.size(), 2UL);
   CHECK_EQ(w_dims.size(), 2UL);
   CHECK_EQ(param.output->dims().size(), 2UL);
@@ -43,20 +43,22 @@ void FcCompute::PrepareForRun() {
   n_ = w_dims[1];
   CHECK_EQ(k_, static_cast<int>(w_dims[0]));
 
-  if (m_ == 1) {
-    if (!transed_weight_) {
-      transed_weight_ = new Tensor;
-    }
-    transed_weight_->Resize({n_, k_});
-    const auto* w_data = param.w->data<float>();
-    auto* t_data = transed_weight_->mutable_data<float>();
-    int i = 0;
+  // The weight is transposed only once for the m_ == 1 path, shared by the
+  // predictors sharing the weight.
+  if (m_ == 1 && !transed_weight_) {
+    transed_weight_ = PackWeight(
+        param.packed_weights, param.w_name, "fc_trans", [&](Tensor* t) {
+          t->Resize({n_, k_});
+          const auto* w_data = param.w->data<float>();
+          auto* t_data = t->mutable_data<float>();
+          int i = 0;
 
-    for (int nn = 0; nn < n_; ++nn) {
-      for (int kk = 0; kk < k_; ++kk) {
-        t_data[i++] = w_data[kk * n_ + nn];
-      }
-    }
+          for (int nn = 0; nn < n_; ++nn) {
+            for (int kk = 0; kk < k_; ++kk) {
+              t_data[i++] = w_data[kk * n_ + nn];
+            }
+          }
+        });
   }
 }
 
@@ -109,15 +111,29 @@ void FcCompute::Run() {
 
 template <PrecisionType Ptype_out>
 void FcComputeInt8<Ptype_out>::PrepareForRun() {
+  auto& param = this->Param<operators::FcParam>();
+  // Convert fp32 bias to int32 bias, the result is kept by the kernel and the
+  // bias shared by the cloned predictors is unchanged.
+  if (param.bias) {
+    lite::arm::math::trans_fp32_bias_to_int32_basic(
+        param.bias, &bias_int32_, param.input_scale, param.weight_scale);
+    param.bias = &bias_int32_;
+  }
+}
+
+template <PrecisionType Ptype_out>
+void FcComputeInt8<Ptype_out>::ReInitWhenNeeded() {
   auto& param = this->Param<operators::FcParam>();
   auto x_dims = param.input->dims();
+  if (last_shape_ == x_dims) return;
+  last_shape_ = x_dims;
   auto w_dims = param.w->dims();
 
   auto& ctx = this->ctx_->template As<ARMContext>();
   if (!tmp_int32_out_) {
     tmp_int32_out_ = new Tensor;
-    tmp_int32_out_->Resize(param.output->dims());
   }
+  tmp_int32_out_->Resize(param.output->dims());
 
   CHECK_GE(x_dims.size(), 2UL);
   CHECK_EQ(w_dims.size(), 2UL);
@@ -128,20 +144,22 @@ void FcComputeInt8<Ptype_out>::PrepareForRun() {
   this->n_ = w_dims[1];
   CHECK_EQ(k_, static_cast<int>(w_dims[0]));
 
-  if (this->m_ == 1) {
-    if (!this->transed_weight_) {
-      this->transed_weight_ = new Tensor;
-    }
-    this->transed_weight_->Resize({this->n_, this->k_});
-    const auto* w_data = param.w->template data<int8_t>();
-    auto* t_data = this->transed_weight_->template mutable_data<int8_t>();
-    int i = 0;
+  // The weight is transposed only once for the m_ == 1 path, shared by the
+  // predictors sharing the weight.
+  if (this->m_ == 1 && !this->transed_weight_) {
+    this->transed_weight_ = PackWeight(
+        param.packed_weights, param.w_name, "fc_trans", [&](Tensor* t) {
+          t->Resize({this->n_, this->k_});
+          const auto* w_data = param.w->template data<int8_t>();
+          auto* t_data = t->template mutable_data<int8_t>();
+          int i = 0;
 
-    for (int nn = 0; nn < this->n_; ++nn) {
-      for (int kk = 0; kk < this->k_; ++kk) {
-        t_data[i++] = w_data[kk * this->n_ + nn];
-      }
-    }
+          for (int nn = 0; nn < this->n_; ++nn) {
+            for (int kk = 0; kk < this->k_; ++kk) {
+              t_data[i++] = w_data[kk * this->n_ + nn];
+            }
+          }
+        });
   }
 
   if (this->m_ > 1) {
@@ -149,13 +167,6 @@ void FcComputeInt8<Ptype_out>::PrepareForRun() {
     int m_round = hblock * ((this->m_ + hblock - 1) / hblock);
     ctx.ExtendWorkspace(m_round * this->k_);
   }
-  bool with_bias = param.bias;
-  if (with_bias) {
-    Tensor temp_tensor;
-    temp_tensor.CopyDataFrom(*param.bias);
-    lite::arm::math::trans_fp32_bias_to_int32_basic(
-        &temp_tensor, param.bias, param.input_scale, param.weight_scale);
-  }
 }
 
 template <PrecisionType Ptype_out>
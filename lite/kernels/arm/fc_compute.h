@@ -14,6 +14,7 @@
 
 #pragma once
 #include <stdint.h>
+#include <memory>
 #include "lite/backends/arm/math/type_trans.h"
 #include "lite/core/kernel.h"
 
@@ -26,19 +27,15 @@ class FcCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
  public:
   using param_t = operators::FcParam;
 
-  void PrepareForRun() override;
+  void ReInitWhenNeeded() override;
 
   void Run() override;
 
-  ~FcCompute() override {
-    if (transed_weight_) {
-      delete transed_weight_;
-    }
-  };
-
  private:
-  lite::Tensor* transed_weight_{nullptr};
+  std::shared_ptr<const Tensor> transed_weight_;
   int m_, n_, k_;
+  // The input dims the m_, n_, k_ are computed for.
+  DDim last_shape_;
 };
 
 template <PrecisionType Ptype_out>
@@ -48,18 +45,23 @@ class FcComputeInt8 : public KernelLite<TARGET(kARM), PRECISION(kInt8)> {
 
   void PrepareForRun() override;
 
+  void ReInitWhenNeeded() override;
+
   void Run() override;
 
   ~FcComputeInt8() override {
-    if (transed_weight_) {
-      delete transed_weight_;
+    if (tmp_int32_out_) {
+      delete tmp_int32_out_;
     }
   };
 
  private:
-  lite::Tensor* transed_weight_{nullptr};
+  std::shared_ptr<const Tensor> transed_weight_;
   Tensor* tmp_int32_out_{nullptr};
   int m_, n_, k_;
+  // The input dims the m_, n_, k_ are computed for.
+  DDim last_shape_;
+  Tensor bias_int32_;
 };
 
 }  // namespace arm
@@ -137,8 +137,7 @@ TEST(fc_arm, compare_test) {
           ctx->As<ARMContext>();
           fc.SetParam(param);
           fc.SetContext(std::move(ctx));
-          fc.PrepareForRun();
-          fc.Run();
+          fc.Launch();
 
           gemm_bias<T>(x_data, m, k, w_data, k, n, b_data, ref_data);
 
@@ -192,8 +191,7 @@ TEST(fc_arm, num_col_dims) {
 
     fc.SetParam(param);
     fc.SetContext(std::move(ctx));
-    fc.PrepareForRun();
-    fc.Run();
+    fc.Launch();
 
     gemm_bias<T>(x_data, 2, 3, w_data, 3, 4, b_data, ref_data);
 
@@ -203,6 +201,104 @@ TEST(fc_arm, num_col_dims) {
   }
 }
 
+TEST(fc_arm, reinit_when_shape_changed) {
+  using T = float;
+  const int k = 8, n = 5;
+  lite::Tensor x, w, b, out, ref;
+  w.Resize({k, n});
+  b.Resize({1, n});
+  FillData<T>(w.mutable_data<T>(), w.dims().production());
+  FillData<T>(b.mutable_data<T>(), b.dims().production());
+
+  FcCompute fc;
+  operators::FcParam param;
+  param.input = &x;
+  param.w = &w;
+  param.bias = &b;
+  param.output = &out;
+  param.in_num_col_dims = 1;
+
+  DeviceInfo::Init();
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<ARMContext>();
+  fc.SetParam(param);
+  fc.SetContext(std::move(ctx));
+
+  // The same kernel switches between the gemv and gemm paths.
+  for (int m : {1, 3, 1, 4}) {
+    x.Resize({m, k});
+    out.Resize({m, n});
+    ref.Resize({m, n});
+    FillData<T>(x.mutable_data<T>(), x.dims().production());
+    fc.Launch();
+
+    gemm_bias<T>(x.data<T>(),
+                 m,
+                 k,
+                 w.data<T>(),
+                 k,
+                 n,
+                 b.mutable_data<T>(),
+                 ref.mutable_data<T>());
+    for (int i = 0; i < out.dims().production(); i++) {
+      EXPECT_NEAR(out.data<T>()[i], ref.data<T>()[i], 1e-3);
+    }
+  }
+}
+
+// The kernels of the predictors sharing the weight share the transposed one.
+TEST(fc_arm, shared_transed_weight) {
+  using T = float;
+  const int k = 8, n = 5;
+  Scope scope;
+  auto* w = scope.NewTensor("w");
+  w->Resize({k, n});
+  FillData<T>(w->mutable_data<T>(), w->dims().production());
+  w->set_persistable(true);
+  auto* cache = scope.FindPackedWeights("w");
+  ASSERT_TRUE(cache);
+
+  DeviceInfo::Init();
+  lite::Tensor x, ref;
+  x.Resize({1, k});
+  FillData<T>(x.mutable_data<T>(), x.dims().production());
+  ref.Resize({1, n});
+  gemm_bias<T>(x.data<T>(),
+               1,
+               k,
+               w->data<T>(),
+               k,
+               n,
+               nullptr,
+               ref.mutable_data<T>());
+  {
+    FcCompute fc[2];
+    lite::Tensor out[2];
+    for (int i = 0; i < 2; i++) {
+      operators::FcParam param;
+      param.input = &x;
+      param.w = w;
+      param.output = &out[i];
+      param.in_num_col_dims = 1;
+      param.packed_weights = cache;
+      param.w_name = "w";
+      out[i].Resize({1, n});
+
+      std::unique_ptr<KernelContext> ctx(new KernelContext);
+      ctx->As<ARMContext>();
+      fc[i].SetParam(param);
+      fc[i].SetContext(std::move(ctx));
+      fc[i].Launch();
+      ASSERT_EQ(cache->size(), 1UL);
+      for (int j = 0; j < n; j++) {
+        EXPECT_NEAR(out[i].data<T>()[j], ref.data<T>()[j], 1e-3);
+      }
+    }
+  }
+  // The transposed weight is released with the kernels.
+  ASSERT_EQ(cache->size(), 0UL);
+}
+
 }  // namespace arm
 }  // namespace kernels
 }  // namespace lite
@@ -25,6 +25,8 @@ class ScaleCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
  public:
   void Run() override;
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~ScaleCompute() = default;
 };
 
@@ -21,11 +21,29 @@ namespace lite {
 namespace kernels {
 namespace arm {
 
+// Whether the outputs are already in their place in the input, that is the
+// memory planner placed them as contiguous parts of the input.
+bool outputs_in_place(const lite::Tensor& x,
+                      const std::vector<lite::Tensor*>& outs,
+                      int axis) {
+  if (axis < 0) axis += static_cast<int>(x.dims().size());
+  for (int i = 0; i < axis; ++i) {
+    if (x.dims()[i] != 1) return false;
+  }
+  const float* src = x.data<float>();
+  for (auto* out : outs) {
+    if (out->mutable_data<float>() != src) return false;
+    src += out->numel();
+  }
+  return true;
+}
+
 void SplitCompute::Run() {
   auto& param = Param<operators::SplitParam>();
   const float* din = param.x->data<float>();
   auto& dout = param.output;
   auto in_dim = param.x->dims();
+  if (outputs_in_place(*param.x, dout, param.axis)) return;
   std::vector<int> in_strides(in_dim.size());
   in_strides[in_dim.size() - 1] = in_dim[in_dim.size() - 1];
   for (int i = in_dim.size() - 2; i >= 0; --i) {
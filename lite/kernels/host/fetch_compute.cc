@@ -33,6 +33,16 @@ class FetchCompute
     }
 
     auto& dst = fetch_list->at(param.col);
+#ifndef LITE_WITH_FPGA
+    // The output bound to an external memory gets a copy this time, and the
+    // op computing it writes into the external memory from the next run on.
+    auto& buffer = dst.buffer();
+    if (!buffer->own_data() && buffer != param.input->buffer() &&
+        !param.input->persistable()) {
+      dst.CopyDataFrom(*param.input);
+      param.input->ResetBuffer(buffer, dst.memory_size());
+    }
+#endif  // LITE_WITH_FPGA
     dst.ShareDataWith(*param.input);
   }
 };
@@ -34,6 +34,8 @@ class ConcatCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     auto& param = *param_.get_mutable<param_t>();
     int64_t axis = static_cast<int64_t>(param.axis);
     auto out = param.output;
+    out->template mutable_data<T>();
+    if (InputsInPlace(param.x, *out, axis)) return;
 
     if (axis == 0 && param.x.size() < 10) {
       size_t output_offset = 0;
@@ -95,6 +97,24 @@ class ConcatCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   }
 
   virtual ~ConcatCompute() = default;
+
+ private:
+  // Whether the inputs are already in their place in the output, that is the
+  // memory planner placed them as contiguous parts of the output.
+  static bool InputsInPlace(const std::vector<lite::Tensor*>& inputs,
+                            const lite::Tensor& out,
+                            int64_t axis) {
+    if (axis < 0) axis += static_cast<int64_t>(out.dims().size());
+    for (int64_t i = 0; i < axis; ++i) {
+      if (out.dims()[i] != 1) return false;
+    }
+    const T* dst = out.data<T>();
+    for (auto* in : inputs) {
+      if (!in || in->data<T>() != dst) return false;
+      dst += in->numel();
+    }
+    return true;
+  }
 };
 
 }  // namespace x86
@@ -74,8 +74,12 @@ class Conv2dCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     lite::Tensor col;
     lite::Tensor col_matrix;
     if (is_expand) {
+      // The columns are in the workspace shared by the kernels.
+      auto& ctx = this->ctx_->template As<X86Context>();
+      size_t col_size = col_shape.production() * sizeof(T);
+      col.ShareExternalMemory(
+          ctx.workspace_data<T>(col_size), col_size, TARGET(kX86));
       col.Resize(col_shape);
-      col.mutable_data<T>();
       col_matrix.ShareDataWith(col);
       col_matrix.Resize(col_matrix_shape);
     }
@@ -73,6 +73,8 @@ class DropoutCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     }
   }
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~DropoutCompute() = default;
 };
 
@@ -43,6 +43,8 @@ class ReluCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     }
   }
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~ReluCompute() = default;
 };
 
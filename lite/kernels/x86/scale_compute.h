@@ -49,6 +49,8 @@ class ScaleCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
                   !param.bias_after_scale);
   }
 
+  bool SupportsInplace() const override { return true; }
+
   virtual ~ScaleCompute() = default;
 };
 
@@ -152,6 +152,7 @@ void OpAttrsCppToAny(const cpp::OpDesc &cpp_desc, OpDescType *any_desc) {
       IMPL_ONE(FLOATS, std::vector<float>);
       IMPL_ONE(INTS, std::vector<int>);
       IMPL_ONE(BOOLEAN, bool);
+      IMPL_ONE(LONGS, std::vector<int64_t>);
       default:
         LOG(FATAL) << "Unsupported attr type found: " << static_cast<int>(type);
     }
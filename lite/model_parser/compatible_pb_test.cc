@@ -137,6 +137,7 @@ void SetOpDesc1(OpDescType* desc) {
   desc->SetInput("X", {"m", "n", "k"});
   desc->SetOutput("Y", {"w"});
   desc->template SetAttr<float>("afloat", 0.005);
+  desc->template SetAttr<std::vector<int64_t>>("alongs", {1, 1LL << 33});
 }
 
 template <typename OpDescType>
@@ -171,6 +172,9 @@ void CheckOpDesc1(const OpDescType& desc) {
   ASSERT_TRUE(desc.HasAttr("afloat"));
   ASSERT_FALSE(desc.HasAttr("aint"));
   EXPECT_NEAR(desc.template GetAttr<float>("afloat"), 0.005, 1e-5);
+  auto alongs = desc.template GetAttr<std::vector<int64_t>>("alongs");
+  ASSERT_EQ(alongs.size(), 2UL);
+  ASSERT_EQ(alongs[1], 1LL << 33);
 }
 
 template <typename OpDescType>
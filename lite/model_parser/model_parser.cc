@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <fstream>
 #include <limits>
+#include <memory>
 #include <set>
 #include "lite/core/scope.h"
 #include "lite/core/tensor.h"
@@ -443,7 +444,8 @@ void SerializeTensor(std::ostream &os,
 /// For navie buffer
 void SetParamInfoNaive(naive_buffer::ParamDesc *param_desc,
                        const lite::Scope &scope,
-                       const std::string &var_name) {
+                       const std::string &var_name,
+                       bool with_data = true) {
   CHECK(param_desc);
   auto &desc = *param_desc;
 
@@ -479,6 +481,7 @@ void SetParamInfoNaive(naive_buffer::ParamDesc *param_desc,
                  << PrecisionToStr(tensor.precision());
   }
   desc.SetDim(tensor.dims().Vectorize());
+  if (!with_data) return;
   uint64_t size = tensor.memory_size();
   CHECK_LT(size, std::numeric_limits<std::streamsize>::max())
       << "Index overflow when writing tensor";
@@ -540,24 +543,114 @@ void SaveParamNaive(const std::string &path,
   table.SaveToFile(path);
 }
 
+// The size of the data of a param in bytes.
+size_t ParamDataSizeNaive(const lite::Tensor &tensor) {
+  switch (tensor.precision()) {
+#define DO(precision, type) \
+  case precision:           \
+    return tensor.data_size() * sizeof(type)
+    DO(PRECISION(kFloat), float);
+    DO(PRECISION(kInt8), int8_t);
+    DO(PRECISION(kInt16), int16_t);
+    DO(PRECISION(kInt32), int32_t);
+    DO(PRECISION(kInt64), int64_t);
+#undef DO
+    default:
+      LOG(FATAL) << "unknown precision type: "
+                 << PrecisionToStr(tensor.precision());
+  }
+  return 0;
+}
+
+// The data of a param on the host, it is copied to `host_data` if the tensor
+// is not on the host.
+const void *ParamHostDataNaive(const lite::Tensor &tensor,
+                               size_t size,
+                               std::vector<char> *host_data) {
+#ifdef LITE_WITH_CUDA
+  if (tensor.target() == TARGET(kCUDA)) {
+    host_data->resize(size);
+    TargetWrapperCuda::MemcpySync(
+        host_data->data(), tensor.raw_data(), size, IoDirection::DtoH);
+    return host_data->data();
+  }
+#endif  // LITE_WITH_CUDA
+  return tensor.raw_data();
+}
+
 void SaveCombinedParamsNaive(const std::string &path,
                              const lite::Scope &exec_scope,
-                             const cpp::ProgramDesc &cpp_prog) {
-  naive_buffer::BinaryTable table;
-  naive_buffer::proto::CombinedParamsDesc pt_desc(&table);
-  naive_buffer::CombinedParamsDesc desc(&pt_desc);
-
+                             const cpp::ProgramDesc &cpp_prog,
+                             bool with_checksum) {
+  std::vector<std::string> names;
   auto prog = cpp_prog;
   auto &main_block_desc = *prog.GetBlock<cpp::BlockDesc>(0);
   for (size_t i = 0; i < main_block_desc.VarsSize(); ++i) {
     auto &var = *main_block_desc.GetVar<cpp::VarDesc>(i);
     if (var.Name() == "feed" || var.Name() == "fetch" || !var.Persistable())
       continue;
-    naive_buffer::ParamDesc param_desc(desc.AddParam());
-    SetParamInfoNaive(&param_desc, exec_scope, var.Name());
+    names.push_back(var.Name());
   }
 
-  pt_desc.Save();
+  std::vector<std::vector<char>> host_data(names.size());
+  std::vector<const void *> data(names.size());
+  std::vector<uint64_t> sizes(names.size());
+  std::vector<uint32_t> checksums(names.size(), 0);
+  for (size_t i = 0; i < names.size(); ++i) {
+    const auto &tensor = exec_scope.FindVar(names[i])->Get<lite::Tensor>();
+    sizes[i] = ParamDataSizeNaive(tensor);
+    data[i] = ParamHostDataNaive(tensor, sizes[i], &host_data[i]);
+    if (with_checksum) {
+      checksums[i] = naive_buffer::Crc32(data[i], sizes[i]);
+    }
+  }
+
+  auto save_header = [&](naive_buffer::BinaryTable *table,
+                         const std::vector<uint64_t> &offsets) {
+    naive_buffer::proto::CombinedParamsHeader pt_header(table);
+    naive_buffer::CombinedParamsHeader header(&pt_header);
+    header.SetMagic(naive_buffer::kCombinedParamsMagic);
+    header.SetVersion(naive_buffer::kCombinedParamsVersion);
+    header.SetWithChecksum(with_checksum);
+    for (size_t i = 0; i < names.size(); ++i) {
+      naive_buffer::ParamIndexDesc index(header.AddParam());
+      naive_buffer::ParamDesc param_desc(index.Param());
+      SetParamInfoNaive(&param_desc, exec_scope, names[i], false);
+      index.SetOffset(offsets[i]);
+      index.SetSize(sizes[i]);
+      index.SetChecksum(checksums[i]);
+    }
+    pt_header.Save();
+  };
+  auto align = [](uint64_t x) {
+    constexpr uint64_t alignment = naive_buffer::kCombinedParamsAlignment;
+    return (x + alignment - 1) / alignment * alignment;
+  };
+
+  // The size of the header does not depend on the values of the offsets, so
+  // it is measured by saving a header without them.
+  naive_buffer::BinaryTable header_table;
+  save_header(&header_table, std::vector<uint64_t>(names.size(), 0));
+  std::vector<uint64_t> offsets(names.size());
+  uint64_t offset = align(header_table.size());
+  for (size_t i = 0; i < names.size(); ++i) {
+    offsets[i] = offset;
+    offset = align(offset + sizes[i]);
+  }
+
+  naive_buffer::BinaryTable table;
+  save_header(&table, offsets);
+  size_t header_size = table.size();
+  CHECK_EQ(header_size, header_table.size());
+  // Save the payloads, the gaps between them are zeros.
+  table.Require(offset - header_size);
+  auto *payloads = table.cursor();
+  for (size_t i = 0; i < names.size(); ++i) {
+    if (sizes[i] > 0) {
+      memcpy(payloads + offsets[i] - header_size, data[i], sizes[i]);
+    }
+  }
+  table.Consume(offset - header_size);
   table.SaveToFile(path);
 }
 
@@ -595,18 +688,16 @@ void SaveModelNaive(const std::string &model_dir,
 }
 #endif
 
-template <typename T>
-void SetTensorDataNaive(T *out, size_t size, const std::vector<T> &src) {
-  CHECK(out);
-  CHECK(size == src.size());
-  for (size_t i = 0; i < size; ++i) {
-    out[i] = src[i];
-  }
-}
+// The params in a mapped file are shared by the tensors only if aligned as the
+// host memory allocated, so that the kernels see no difference.
+constexpr size_t kSharedParamAlignment = 64;
 
 void GetParamInfoNaive(const naive_buffer::ParamDesc &desc,
                        lite::Scope *scope,
-                       const std::string &name) {
+                       const std::string &name,
+                       const void *raw_data,
+                       size_t size,
+                       const std::shared_ptr<void> &mapping) {
   CHECK(scope);
   CHECK_EQ(desc.Name(), name)
       << "Var name not equal: ParamDesc.name=" << desc.Name()
@@ -627,11 +718,11 @@ void GetParamInfoNaive(const naive_buffer::ParamDesc &desc,
 
   // Load data
   switch (desc.GetDataType()) {
-#define SET_TENSOR(data_type__, T, precision)                            \
-  case VarDescAPI::VarDataType::data_type__:                             \
-    SetTensorDataNaive<T>(                                               \
-        tensor->mutable_data<T>(), tensor->data_size(), desc.Data<T>()); \
-    tensor->set_precision(precision);                                    \
+#define SET_TENSOR(data_type__, T, precision)             \
+  case VarDescAPI::VarDataType::data_type__:              \
+    CHECK_EQ(size, tensor->data_size() * sizeof(T))       \
+        << "Data size mismatch of " << name;              \
+    tensor->set_precision(precision);                     \
     break
 
     // SET_TENSOR(BOOL, bool, PRECISION(kBool));
@@ -644,6 +735,15 @@ void GetParamInfoNaive(const naive_buffer::ParamDesc &desc,
     default:
       LOG(FATAL) << "unknown type";
   }
+  auto *data = const_cast<void *>(raw_data);
+  if (mapping && size > 0 &&
+      reinterpret_cast<uintptr_t>(data) % kSharedParamAlignment == 0) {
+    // Point to the mapped file without a copy.
+    tensor->ResetBuffer(
+        std::make_shared<Buffer>(data, TARGET(kHost), size, mapping), size);
+  } else if (size > 0) {
+    memcpy(tensor->mutable_data(size), data, size);
+  }
   tensor->set_persistable(true);
 }
 
@@ -652,11 +752,45 @@ void LoadParamNaive(const std::string &path,
                     const std::string &name) {
   // Load param
   naive_buffer::BinaryTable table;
-  table.LoadFromFile(path);
+  table.MapFile(path);
   naive_buffer::proto::ParamDesc pt_desc(&table);
   pt_desc.Load();
   naive_buffer::ParamDesc desc(&pt_desc);
-  GetParamInfoNaive(desc, scope, name);
+  GetParamInfoNaive(desc,
+                    scope,
+                    name,
+                    desc.RawData(),
+                    desc.RawDataSize(),
+                    table.mapping());
+}
+
+// Load the combined params of version 1, each param is found by the offset in
+// the header.
+void LoadCombinedParamsHeaderNaive(naive_buffer::BinaryTable *table,
+                                   lite::Scope *scope,
+                                   std::set<std::string> *param_names) {
+  naive_buffer::proto::CombinedParamsHeader pt_header(table);
+  pt_header.Load();
+  naive_buffer::CombinedParamsHeader header(&pt_header);
+  CHECK_EQ(header.Magic(), naive_buffer::kCombinedParamsMagic);
+  CHECK_LE(header.Version(), naive_buffer::kCombinedParamsVersion)
+      << "Unsupported combined params version " << header.Version();
+
+  for (size_t i = 0; i < header.ParamsSize(); ++i) {
+    naive_buffer::ParamIndexDesc index(header.GetParam(i));
+    naive_buffer::ParamDesc param_desc(index.Param());
+    auto name = param_desc.Name();
+    CHECK_LE(index.Offset() + index.Size(), table->size())
+        << "The data of param " << name << " is out of range";
+    const auto *data = table->data() + index.Offset();
+    if (header.WithChecksum()) {
+      CHECK_EQ(naive_buffer::Crc32(data, index.Size()), index.Checksum())
+          << "Checksum mismatch of param " << name;
+    }
+    GetParamInfoNaive(
+        param_desc, scope, name, data, index.Size(), table->mapping());
+    param_names->insert(name);
+  }
 }
 
 void LoadCombinedParamsNaive(const std::string &path,
@@ -667,17 +801,27 @@ void LoadCombinedParamsNaive(const std::string &path,
   if (params_from_memory) {
     table.LoadFromMemory(path.c_str(), path.length());
   } else {
-    table.LoadFromFile(path);
+    table.MapFile(path);
   }
-  naive_buffer::proto::CombinedParamsDesc pt_desc(&table);
-  pt_desc.Load();
-  naive_buffer::CombinedParamsDesc desc(&pt_desc);
 
   std::set<std::string> param_names;
-  for (size_t i = 0; i < desc.ParamsSize(); ++i) {
-    naive_buffer::ParamDesc param_desc(desc.GetParam(i));
-    GetParamInfoNaive(param_desc, scope, param_desc.Name());
-    param_names.insert(param_desc.Name());
+  if (naive_buffer::IsCombinedParamsHeader(table)) {
+    LoadCombinedParamsHeaderNaive(&table, scope, &param_names);
+  } else {
+    // The params of version 0.
+    naive_buffer::proto::CombinedParamsDesc pt_desc(&table);
+    pt_desc.Load();
+    naive_buffer::CombinedParamsDesc desc(&pt_desc);
+    for (size_t i = 0; i < desc.ParamsSize(); ++i) {
+      naive_buffer::ParamDesc param_desc(desc.GetParam(i));
+      GetParamInfoNaive(param_desc,
+                        scope,
+                        param_desc.Name(),
+                        param_desc.RawData(),
+                        param_desc.RawDataSize(),
+                        table.mapping());
+      param_names.insert(param_desc.Name());
+    }
   }
 
   // Check all params loaded
@@ -703,7 +847,7 @@ void LoadModelNaive(const std::string &model_dir,
   // Load model
   const std::string prog_path = model_dir + "/__model__.nb";
   naive_buffer::BinaryTable table;
-  table.LoadFromFile(prog_path);
+  table.MapFile(prog_path);
   naive_buffer::proto::ProgramDesc nb_proto_prog(&table);
   nb_proto_prog.Load();
   naive_buffer::ProgramDesc nb_prog(&nb_proto_prog);
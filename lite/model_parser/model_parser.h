@@ -80,9 +80,13 @@ void SaveParamNaive(const std::string& path,
                     const lite::Scope& exec_scope,
                     const std::string& var_name);
 
+// Save the params of version 1, the payloads are aligned and indexed by a
+// header, see naive_buffer::CombinedParamsHeader. The checksums are verified
+// when loading if saved.
 void SaveCombinedParamsNaive(const std::string& path,
                              const lite::Scope& exec_scope,
-                             const cpp::ProgramDesc& cpp_prog);
+                             const cpp::ProgramDesc& cpp_prog,
+                             bool with_checksum = false);
 
 void SaveModelNaive(const std::string& model_dir,
                     const Scope& exec_scope,
@@ -94,6 +98,13 @@ void LoadParamNaive(const std::string& path,
                     lite::Scope* scope,
                     const std::string& name);
 
+// Load the combined params of version 0 or 1, from the file at `path` or from
+// the bytes of `path` if `params_from_memory`.
+void LoadCombinedParamsNaive(const std::string& path,
+                             lite::Scope* scope,
+                             const cpp::ProgramDesc& cpp_prog,
+                             bool params_from_memory);
+
 void LoadModelNaive(const std::string& model_dir,
                     lite::Scope* scope,
                     cpp::ProgramDesc* prog,
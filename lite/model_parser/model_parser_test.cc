@@ -112,6 +112,41 @@ TEST(ModelParser, LoadParamNaive) {
   }
 }
 
+TEST(ModelParser, SaveCombinedParamsNaive) {
+  Scope scope;
+  cpp::ProgramDesc prog;
+  auto* block = prog.AddBlock<cpp::BlockDesc>();
+  for (int i = 0; i < 3; ++i) {
+    std::string name = "param_" + std::to_string(i);
+    auto* var = block->AddVar<cpp::VarDesc>();
+    var->SetName(name);
+    var->SetType(VarDescAPI::Type::LOD_TENSOR);
+    var->SetPersistable(true);
+    auto* tensor = scope.Var(name)->GetMutable<lite::Tensor>();
+    tensor->set_precision(PRECISION(kFloat));
+    tensor->Resize(lite::DDim(std::vector<int64_t>({i + 1, 3})));
+    auto* data = tensor->mutable_data<float>();
+    for (int j = 0; j < tensor->data_size(); ++j) {
+      data[j] = i * 100 + j;
+    }
+  }
+  SaveCombinedParamsNaive("./params.nb", scope, prog, true);
+
+  Scope scope1;
+  LoadCombinedParamsNaive("./params.nb", &scope1, prog, false);
+  for (int i = 0; i < 3; ++i) {
+    auto& tensor =
+        scope1.FindVar("param_" + std::to_string(i))->Get<lite::Tensor>();
+    ASSERT_EQ(tensor.dims().Vectorize(), std::vector<int64_t>({i + 1, 3}));
+    auto* data = tensor.data<float>();
+    // The payloads are aligned.
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(data) % 64, 0);
+    for (int j = 0; j < tensor.data_size(); ++j) {
+      EXPECT_EQ(data[j], i * 100 + j);
+    }
+  }
+}
+
 TEST(ModelParser, SaveModelNaive) {
   CHECK(!FLAGS_model_dir.empty());
   cpp::ProgramDesc prog;
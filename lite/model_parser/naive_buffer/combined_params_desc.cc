@@ -13,3 +13,94 @@
 // limitations under the License.
 
 #include "lite/model_parser/naive_buffer/combined_params_desc.h"
+#include <cstring>
+
+namespace paddle {
+namespace lite {
+namespace naive_buffer {
+
+bool IsCombinedParamsHeader(const BinaryTable &table) {
+  uint64_t magic{};
+  if (table.size() < sizeof(magic)) return false;
+  memcpy(&magic, table.data(), sizeof(magic));
+  return magic == kCombinedParamsMagic;
+}
+
+uint64_t ParamIndexDesc::Offset() const {
+  return desc_->GetField<UInt64Builder>("offset").data();
+}
+
+void ParamIndexDesc::SetOffset(uint64_t offset) {
+  auto *builder = desc_->GetMutableField<UInt64Builder>("offset");
+  CHECK(builder);
+  builder->set(offset);
+}
+
+uint64_t ParamIndexDesc::Size() const {
+  return desc_->GetField<UInt64Builder>("size").data();
+}
+
+void ParamIndexDesc::SetSize(uint64_t size) {
+  auto *builder = desc_->GetMutableField<UInt64Builder>("size");
+  CHECK(builder);
+  builder->set(size);
+}
+
+uint32_t ParamIndexDesc::Checksum() const {
+  return desc_->GetField<UInt32Builder>("checksum").data();
+}
+
+void ParamIndexDesc::SetChecksum(uint32_t checksum) {
+  auto *builder = desc_->GetMutableField<UInt32Builder>("checksum");
+  CHECK(builder);
+  builder->set(checksum);
+}
+
+uint64_t CombinedParamsHeader::Magic() const {
+  return desc_->GetField<UInt64Builder>("magic").data();
+}
+
+void CombinedParamsHeader::SetMagic(uint64_t magic) {
+  auto *builder = desc_->GetMutableField<UInt64Builder>("magic");
+  CHECK(builder);
+  builder->set(magic);
+}
+
+uint32_t CombinedParamsHeader::Version() const {
+  return desc_->GetField<UInt32Builder>("version").data();
+}
+
+void CombinedParamsHeader::SetVersion(uint32_t version) {
+  auto *builder = desc_->GetMutableField<UInt32Builder>("version");
+  CHECK(builder);
+  builder->set(version);
+}
+
+bool CombinedParamsHeader::WithChecksum() const {
+  return desc_->GetField<BoolBuilder>("with_checksum").data();
+}
+
+void CombinedParamsHeader::SetWithChecksum(bool with_checksum) {
+  auto *builder = desc_->GetMutableField<BoolBuilder>("with_checksum");
+  CHECK(builder);
+  builder->set(with_checksum);
+}
+
+size_t CombinedParamsHeader::ParamsSize() const {
+  return desc_->GetField<ListBuilder<proto::ParamIndex>>("params").size();
+}
+
+proto::ParamIndex *CombinedParamsHeader::GetParam(int32_t idx) {
+  CHECK_LT(idx, ParamsSize()) << "idx >= params.size()";
+  return desc_->GetMutableField<ListBuilder<proto::ParamIndex>>("params")
+      ->GetMutable(idx);
+}
+
+proto::ParamIndex *CombinedParamsHeader::AddParam() {
+  return desc_->GetMutableField<ListBuilder<proto::ParamIndex>>("params")
+      ->New();
+}
+
+}  // namespace naive_buffer
+}  // namespace lite
+}  // namespace paddle
@@ -58,6 +58,79 @@ class CombinedParamsDesc {
   proto::CombinedParamsDesc *desc_;
 };
 
+/*
+ * The combined params of version 1 start with a header indexing the params,
+ * the payload of each param follows at a 64-byte aligned offset of the file.
+ * The params of version 0 are a CombinedParamsDesc, which starts with the
+ * number of params instead of the magic number.
+ */
+constexpr uint64_t kCombinedParamsMagic = 0x534D415241504E42;  // "NBPARAMS"
+constexpr uint32_t kCombinedParamsVersion = 1;
+constexpr uint64_t kCombinedParamsAlignment = 64;
+
+// Whether the table holds the combined params of version 1 or later.
+bool IsCombinedParamsHeader(const BinaryTable &table);
+
+class ParamIndexDesc {
+ public:
+  ParamIndexDesc() = delete;
+
+  explicit ParamIndexDesc(proto::ParamIndex *desc) : desc_(desc) {
+    CHECK(desc_);
+  }
+
+  // The name, LoD, data type and dims of the param, the data is empty.
+  proto::ParamDesc *Param() {
+    return desc_->GetMutableField<proto::ParamDesc>("param");
+  }
+
+  uint64_t Offset() const;
+
+  void SetOffset(uint64_t offset);
+
+  uint64_t Size() const;
+
+  void SetSize(uint64_t size);
+
+  uint32_t Checksum() const;
+
+  void SetChecksum(uint32_t checksum);
+
+ private:
+  proto::ParamIndex *desc_;
+};
+
+class CombinedParamsHeader {
+ public:
+  CombinedParamsHeader() = delete;
+
+  explicit CombinedParamsHeader(proto::CombinedParamsHeader *desc)
+      : desc_(desc) {
+    CHECK(desc_);
+  }
+
+  uint64_t Magic() const;
+
+  void SetMagic(uint64_t magic);
+
+  uint32_t Version() const;
+
+  void SetVersion(uint32_t version);
+
+  bool WithChecksum() const;
+
+  void SetWithChecksum(bool with_checksum);
+
+  size_t ParamsSize() const;
+
+  proto::ParamIndex *GetParam(int32_t idx);
+
+  proto::ParamIndex *AddParam();
+
+ private:
+  proto::CombinedParamsHeader *desc_;
+};
+
 }  // namespace naive_buffer
 }  // namespace lite
 }  // namespace paddle
@@ -14,6 +14,12 @@
 
 #include "lite/model_parser/naive_buffer/naive_buffer.h"
 #include <stdio.h>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace paddle {
 namespace lite {
@@ -74,6 +80,87 @@ void BinaryTable::LoadFromMemory(const char *buffer, size_t buffer_size) {
   is_mutable_mode_ = false;
 }
 
+void BinaryTable::MapFile(const std::string &filename) {
+#if !defined(_WIN32)
+  int fd = open(filename.c_str(), O_RDONLY);
+  CHECK_GE(fd, 0) << "Unable to open file: " << filename;
+  struct stat st;
+  CHECK_EQ(fstat(fd, &st), 0) << "Unable to stat file: " << filename;
+  size_t file_size = st.st_size;
+  void *addr = MAP_FAILED;
+  if (file_size > 0) {
+    // A private writable mapping: the pages are shared through the page cache
+    // until they are written, e.g. by a kernel transforming its weights.
+    addr = mmap(
+        nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+  if (addr != MAP_FAILED) {
+    VLOG(4) << "map file " << filename << ", size " << file_size;
+    mapping_.reset(static_cast<byte_t *>(addr),
+                   [file_size](byte_t *x) { munmap(x, file_size); });
+    mapping_size_ = file_size;
+    bytes_.clear();
+    cursor_ = 0;
+    // Set readonly.
+    is_mutable_mode_ = false;
+    return;
+  }
+  LOG(WARNING) << "Unable to map file: " << filename << ", read it instead";
+#endif
+  LoadFromFile(filename);
+}
+
+uint32_t Crc32(const void *data, size_t size, uint32_t crc) {
+  static const auto table = [] {
+    std::vector<uint32_t> x(256);
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; k++) {
+        c = (c & 1) ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+      }
+      x[i] = c;
+    }
+    return x;
+  }();
+  auto *bytes = static_cast<const byte_t *>(data);
+  crc = ~crc;
+  for (size_t i = 0; i < size; i++) {
+    crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+void BytesBuilder::set(const void *data, size_t size) {
+  auto *bytes = static_cast<const byte_t *>(data);
+  data_.assign(bytes, bytes + size);
+  loaded_data_ = nullptr;
+  size_ = size;
+}
+
+void BytesBuilder::Save() {
+  // memory format: [size][bytes]
+  uint64_t size = size_;
+  table()->Require(sizeof(uint64_t) + size);
+  memcpy(table()->cursor(), &size, sizeof(uint64_t));
+  table()->Consume(sizeof(uint64_t));
+  if (size > 0) {
+    memcpy(table()->cursor(), data(), size);
+  }
+  table()->Consume(size);
+}
+
+void BytesBuilder::Load() {
+  uint64_t size{};
+  memcpy(&size, table()->cursor(), sizeof(uint64_t));
+  table()->Consume(sizeof(uint64_t));
+  // Point to the bytes in the table.
+  data_.clear();
+  loaded_data_ = table()->cursor();
+  size_ = size;
+  table()->Consume(size);
+}
+
 void StringBuilder::Save() {
   // memory format: [size][string data]
   uint64_t mem_size = sizeof(uint64_t) + data_.size();
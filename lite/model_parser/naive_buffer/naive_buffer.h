@@ -39,12 +39,17 @@ using byte_t = uint8_t;
  * object.
  * A BinaryTable can only support write or read in its lifetime, it is mutable
  * by default, but the `Load` method will get a readonly BinaryTable.
+ * `MapFile` gets a readonly BinaryTable on a memory mapping of the file, the
+ * mapping can be shared to keep the data alive after the table is destroyed.
  */
 struct BinaryTable {
  private:
   std::vector<byte_t> bytes_;
   size_t cursor_{};
   bool is_mutable_mode_{true};  // true for mutable, false for readonly.
+  // The mapping of the file, bytes_ is not used if it is set.
+  std::shared_ptr<byte_t> mapping_;
+  size_t mapping_size_{};
 
  public:
   /// Require free memory of `size` bytes.
@@ -54,18 +59,30 @@ struct BinaryTable {
   void Consume(size_t bytes);
 
   /// The current position of cursor for save or load.
-  byte_t* cursor() { return &bytes_[cursor_]; }
-  const byte_t* data() const { return bytes_.data(); }
-  size_t size() const { return bytes_.size(); }
-  size_t free_size() const { return bytes_.size() - cursor_; }
+  byte_t* cursor() {
+    return (mapping_ ? mapping_.get() : bytes_.data()) + cursor_;
+  }
+  const byte_t* data() const {
+    return mapping_ ? mapping_.get() : bytes_.data();
+  }
+  size_t size() const { return mapping_ ? mapping_size_ : bytes_.size(); }
+  size_t free_size() const { return size() - cursor_; }
+  /// The mapping of the file, null if the table is not mapped.
+  const std::shared_ptr<byte_t>& mapping() const { return mapping_; }
 
   /// Serialize the table to a binary buffer.
   void SaveToFile(const std::string& filename) const;
 
   void LoadFromFile(const std::string& filename);
   void LoadFromMemory(const char* buffer, size_t buffer_size);
+  /// Map the file instead of reading it, it falls back to `LoadFromFile` if
+  /// the file can not be mapped.
+  void MapFile(const std::string& filename);
 };
 
+/// CRC-32 of the bytes, to check the integrity of the data saved.
+uint32_t Crc32(const void* data, size_t size, uint32_t crc = 0);
+
 /*
  * Base class of all the fields.
  */
@@ -173,6 +190,34 @@ class StringBuilder : public FieldBuilder {
   Type type() const override { return Type::_string; }
 };
 
+/*
+ * Builder for a blob of bytes, it has the same layout as a
+ * ListBuilder<CharBuilder>: [size][bytes].
+ * The loaded bytes are not copied, they point into the BinaryTable, so the
+ * table should outlive the loaded data.
+ */
+class BytesBuilder : public FieldBuilder {
+  std::vector<byte_t> data_;
+  const byte_t* loaded_data_{};
+  size_t size_{};
+
+ public:
+  explicit BytesBuilder(BinaryTable* table) : FieldBuilder(table) {}
+
+  void set(const void* data, size_t size);
+
+  const byte_t* data() const {
+    return loaded_data_ ? loaded_data_ : data_.data();
+  }
+  size_t size() const { return size_; }
+
+  void Save() override;
+
+  void Load() override;
+
+  Type type() const override { return Type::_list; }
+};
+
 /*
  * This is a data structure. A composion of multiple fields.
  *
@@ -14,6 +14,8 @@
 
 #include "lite/model_parser/naive_buffer/naive_buffer.h"
 #include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
 
 namespace paddle {
 namespace lite {
@@ -173,6 +175,37 @@ TEST(ListBuilder, basic) {
   }
 }
 
+TEST(BytesBuilder, map_file) {
+  BinaryTable table;
+  BytesBuilder bytes(&table);
+  std::vector<float> data({1.f, 2.f, 3.f, 4.f});
+  bytes.set(data.data(), data.size() * sizeof(float));
+  bytes.Save();
+  table.SaveToFile("3.bf");
+
+  // The same layout as a list of chars.
+  BinaryTable table1;
+  table1.LoadFromFile("3.bf");
+  ListBuilder<CharBuilder> li1(&table1);
+  li1.Load();
+  ASSERT_EQ(li1.size(), data.size() * sizeof(float));
+
+  BinaryTable table2;
+  table2.MapFile("3.bf");
+  ASSERT_EQ(table2.size(), table.size());
+  BytesBuilder bytes2(&table2);
+  bytes2.Load();
+  ASSERT_EQ(bytes2.size(), data.size() * sizeof(float));
+#if !defined(_WIN32)
+  ASSERT_TRUE(table2.mapping());
+  // The loaded bytes point into the mapping.
+  ASSERT_EQ(bytes2.data(), table2.mapping().get() + sizeof(uint64_t));
+#endif
+  std::vector<float> data2(data.size());
+  memcpy(data2.data(), bytes2.data(), bytes2.size());
+  ASSERT_EQ(data2, data);
+}
+
 }  // namespace naive_buffer
 }  // namespace lite
 }  // namespace paddle
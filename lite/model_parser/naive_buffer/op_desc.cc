@@ -77,6 +77,7 @@ SET_ATTR_IMPL(std::string, STRING, String, s);
 SET_ATTRS_IMPL(int, INTS, Int32, ints);
 SET_ATTRS_IMPL(float, FLOATS, Float32, floats);
 SET_ATTRS_IMPL(std::string, STRINGS, String, strings);
+SET_ATTRS_IMPL(int64_t, LONGS, Int64, longs);
 #undef SET_ATTRS_IMPL
 
 const proto::OpDesc::Attr& GetFindAttr(const proto::OpDesc& desc,
@@ -229,6 +229,10 @@ template <>
 void OpDesc::SetAttr<std::vector<int>>(const std::string &name,
                                        const std::vector<int> &v);
 
+template <>
+void OpDesc::SetAttr<std::vector<int64_t>>(const std::string &name,
+                                           const std::vector<int64_t> &v);
+
 }  // namespace naive_buffer
 }  // namespace lite
 }  // namespace paddle
@@ -77,6 +77,11 @@ class ParamDesc {
   template <typename T>
   void SetData(const T *data, size_t size);
 
+  // The data bytes loaded, they point into the BinaryTable without a copy.
+  const void *RawData() const;
+
+  size_t RawDataSize() const;
+
  private:
   uint32_t Version(const std::string &name) const;
   void SetVersion(const std::string &name, uint32_t version);
@@ -191,12 +191,36 @@ class ParamDesc : public StructBuilder {
     New<lod_type>("lod");
     NewUInt32("tensor_version");
     New<TensorDesc>("tensor_desc");
-    New<ListBuilder<CharBuilder>>("data");
+    New<BytesBuilder>("data");
   }
 };
 
 using CombinedParamsDesc = ListBuilder<ParamDesc>;
 
+// The index of a param in the combined params of version 1. The data of the
+// `param` is empty, it is stored at `offset` of the file.
+class ParamIndex : public StructBuilder {
+ public:
+  explicit ParamIndex(BinaryTable* table) : StructBuilder(table) {
+    New<ParamDesc>("param");
+    NewUInt64("offset");
+    NewUInt64("size");
+    NewUInt32("checksum");
+  }
+};
+
+// The header of the combined params of version 1, the payloads of the params
+// follow it.
+class CombinedParamsHeader : public StructBuilder {
+ public:
+  explicit CombinedParamsHeader(BinaryTable* table) : StructBuilder(table) {
+    NewUInt64("magic");
+    NewUInt32("version");
+    NewBool("with_checksum", false);
+    New<ListBuilder<ParamIndex>>("params");
+  }
+};
+
 }  // namespace proto
 }  // namespace naive_buffer
 }  // namespace lite
@@ -77,6 +77,17 @@ void OpDesc::SetAttr<std::vector<float>>(const std::string &name,
   }
 }
 
+template <>
+void OpDesc::SetAttr<std::vector<int64_t>>(const std::string &name,
+                                           const std::vector<int64_t> &v) {
+  auto it = FindAttr(desc_, name);
+  it->set_type(framework::proto::LONGS);
+  it->clear_longs();
+  for (auto &i : v) {
+    it->add_longs(i);
+  }
+}
+
 template <>
 void OpDesc::SetAttr<std::vector<std::string>>(
     const std::string &name, const std::vector<std::string> &v) {
@@ -65,6 +65,8 @@ bool ConvTransposeOpLite::AttachImpl(const cpp::OpDesc &op_desc,
   auto Out = op_desc.Output("Output").front();
   param_.x = scope->FindVar(X)->GetMutable<lite::Tensor>();
   param_.filter = scope->FindVar(Filter)->GetMutable<lite::Tensor>();
+  param_.filter_name = Filter;
+  param_.packed_weights = scope->FindPackedWeights(Filter);
   param_.output = scope->FindVar(Out)->GetMutable<lite::Tensor>();
 
   param_.strides = op_desc.GetAttr<std::vector<int>>("strides");
@@ -72,6 +72,8 @@ bool FcOpLite::AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) {
 
   param_.input = scope->FindVar(input)->GetMutable<lite::Tensor>();
   param_.w = scope->FindVar(W)->GetMutable<lite::Tensor>();
+  param_.w_name = W;
+  param_.packed_weights = scope->FindPackedWeights(W);
   std::vector<std::string> input_arg_names = op_desc.InputArgumentNames();
   if (std::find(input_arg_names.begin(), input_arg_names.end(), "Bias") !=
       input_arg_names.end()) {
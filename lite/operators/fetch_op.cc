@@ -37,7 +37,7 @@ class FetchOp : public OpLite {
     auto _x = opdesc.Input("X").front();
     auto* x = scope->FindVar(_x);
     CHECK(x);
-    param_.input = &x->Get<lite::Tensor>();
+    param_.input = x->GetMutable<lite::Tensor>();
 
     auto _out = opdesc.Output("Out").front();
     auto* out = scope->FindVar(_out);
@@ -43,7 +43,7 @@ struct FeedParam {
 };
 
 struct FetchParam {
-  const lite::Tensor* input{};
+  lite::Tensor* input{};
   std::vector<lite::Tensor>* fetch_list{};
   int col;
 };
@@ -81,6 +81,10 @@ struct FcParam {
   lite::DDim in_mat_dims;
   int in_num_col_dims{1};
   bool weight_transposed{false};
+  // The cache of the packed weight shared by the predictors, see
+  // Scope::FindPackedWeights.
+  PackedWeights* packed_weights{};
+  std::string w_name;
   // for int8
   WITH_INT8_CONFIG
 };
@@ -226,6 +230,10 @@ struct ConvParam {
   float scale_weights{1.0f};      // only used with mkl-dnn int8
   bool force_fp32_output{false};  // only used in mkl-dnn int8
   std::string data_format{"Anylayout"};
+  // The cache of the packed filter shared by the predictors, see
+  // Scope::FindPackedWeights.
+  PackedWeights* packed_weights{};
+  std::string filter_name;
   // for int8
   WITH_INT8_CONFIG
 };
@@ -757,6 +765,7 @@ struct SqueezeParam {
   lite::Tensor* Out{};
   lite::Tensor* XShape{};
   std::vector<int> axes{};
+  bool inplace{false};
 };
 
 /// ----------------------- expand operators ----------------------